@@ -0,0 +1,124 @@
+#include <Benchmark.h>
+#include <Utility/AABB.h>
+
+#include <random>
+
+// Bounds of a large vertex array: the previous branchy scalar loop of AABB::Create(), the SSE reduction
+// on a single thread and the full AABB::Bounds(), that also splits the array between threads
+BENCHMARK(AABBBounds)
+{
+	const size_t count = static_cast<size_t>(state.Param("points", 1e8));
+	std::vector<Vertex> vertices(count);
+	std::mt19937 engine(3);
+	std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+	for (Vertex& vertex : vertices)
+	{
+		vertex = Vertex(distribution(engine), distribution(engine), sol::Vec4f(1.0f));
+	}
+
+	sol::Vec2f min, max;
+	state.Measure("scalar_branchy", [&]()
+	{
+		Vertex first = vertices.front();
+		min = max = first.position;
+		for (const Vertex& vertex : vertices)
+		{
+			if (vertex.position.x < min.x) min.x = vertex.position.x;
+			else if (vertex.position.x > max.x) max.x = vertex.position.x;
+			if (vertex.position.y < min.y) min.y = vertex.position.y;
+			else if (vertex.position.y > max.y) max.y = vertex.position.y;
+		}
+		Benchmark::DoNotOptimize(min);
+		Benchmark::DoNotOptimize(max);
+	}, static_cast<double>(count));
+
+	// chunks below the parallel threshold run on the calling thread only
+	const size_t chunk = AABB::s_ParallelVertices - 1;
+	state.Measure("sse_single_thread", [&]()
+	{
+		sol::Vec2f chunkMin, chunkMax;
+		AABB::Bounds(vertices.data(), std::min(count, chunk), min, max);
+		for (size_t begin = chunk; begin < count; begin += chunk)
+		{
+			if (AABB::Bounds(vertices.data() + begin, std::min(chunk, count - begin), chunkMin, chunkMax))
+			{
+				min = sol::Vec2f(std::min(min.x, chunkMin.x), std::min(min.y, chunkMin.y));
+				max = sol::Vec2f(std::max(max.x, chunkMax.x), std::max(max.y, chunkMax.y));
+			}
+		}
+		Benchmark::DoNotOptimize(min);
+		Benchmark::DoNotOptimize(max);
+	}, static_cast<double>(count));
+
+	state.Measure("sse_parallel", [&]()
+	{
+		AABB::Bounds(vertices.data(), count, min, max);
+		Benchmark::DoNotOptimize(min);
+		Benchmark::DoNotOptimize(max);
+	}, static_cast<double>(count))
+		.Counter("bytes", static_cast<double>(count * sizeof(Vertex)));
+}
+
+// Per-object AABB work of a frame: creation from a small vertex array, transformation by the model matrix
+// and collision tests, i.e. culling against the camera and picking with the cursor
+BENCHMARK(AABBOps)
+{
+	const size_t boxes = static_cast<size_t>(state.Param("boxes", 1e5));
+	const size_t vertices = static_cast<size_t>(state.Param("vertices", 64));
+	std::mt19937 engine(5);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+	std::vector<Vertex> shape(vertices);
+	for (Vertex& vertex : shape)
+	{
+		vertex = Vertex(distribution(engine), distribution(engine), sol::Vec4f(1.0f));
+	}
+	std::vector<AABB> aabbs(boxes);
+	std::vector<sol::Vec2f> points(boxes);
+	for (size_t i = 0; i < boxes; i++)
+	{
+		float x = distribution(engine);
+		float y = distribution(engine);
+		aabbs[i] = AABB::Create(sol::Vec2f(x - 1.0f, y - 1.0f), sol::Vec2f(x + 1.0f, y + 1.0f));
+		points[i] = sol::Vec2f(distribution(engine), distribution(engine));
+	}
+
+	AABB created;
+	state.Measure("create", [&]()
+	{
+		created = AABB::Create(shape);
+		Benchmark::DoNotOptimize(created);
+	}, static_cast<double>(vertices));
+
+	const sol::Affine2f model = sol::TRS(sol::Vec2f(3.0f, -2.0f), 0.3f, sol::Vec2f(2.0f, 0.5f));
+	std::vector<AABB> transformed(boxes);
+	state.Measure("transform", [&]()
+	{
+		for (size_t i = 0; i < boxes; i++)
+		{
+			transformed[i] = aabbs[i].Transform(model);
+		}
+		Benchmark::DoNotOptimize(transformed.data());
+	}, static_cast<double>(boxes));
+
+	const AABB view = AABB::Create(sol::Vec2f(-20.0f, -10.0f), sol::Vec2f(20.0f, 10.0f));
+	state.Measure("collide_aabb", [&]()
+	{
+		size_t visible = 0;
+		for (const AABB& aabb : aabbs)
+		{
+			visible += aabb.CollideWith(view);
+		}
+		Benchmark::DoNotOptimize(visible);
+	}, static_cast<double>(boxes));
+
+	state.Measure("collide_point", [&]()
+	{
+		size_t hits = 0;
+		for (size_t i = 0; i < boxes; i++)
+		{
+			hits += aabbs[i].CollideWith(points[i]);
+		}
+		Benchmark::DoNotOptimize(hits);
+	}, static_cast<double>(boxes));
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+/**
+ * 	Tiny benchmark harness, that does not depend on any window or OpenGL context
+ *
+ * 	Benchmarks are registered with BENCHMARK(Name) macro and run by Benchmarks/Main.cpp.
+ * 	Each benchmark receives a State, that measures code with State::Measure() and collects Results.
+ * 	Results are printed as JSON, so that they can be compared across versions.
+ *
+ * 	Parameters may be passed from the command line as --name=value and read with State::Param(),
+ * 	so that huge benchmarks can be scaled down on small machines
+ */
+namespace Benchmark
+{
+	struct Result
+	{
+		std::string name;
+		size_t iterations = 0;
+		// mean time of a single iteration
+		double nanoseconds = 0.0;
+		// amount of processed items per iteration, e.g. points. Used to report throughput
+		double items = 1.0;
+		// additional values, that are reported with the result
+		std::vector<std::pair<std::string, double>> counters;
+
+		inline Result& Counter(const std::string& key, double value) { counters.emplace_back(key, value); return *this; }
+	};
+
+	// Prevents the compiler from optimizing value away
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	class State
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+	public:
+		State(const std::vector<std::pair<std::string, std::string>>& params, double minTime)
+		: m_Params(params), m_MinTime(minTime)
+		{
+		}
+
+		// Calls function repeatedly until at least minTime seconds have passed and records the mean time per call
+		template<typename F>
+		Result& Measure(const std::string& name, F&& function, double items = 1.0)
+		{
+			// warm-up call, that also takes caches and lazy allocations out of the measurement
+			function();
+
+			size_t iterations = 0;
+			Clock::time_point start = Clock::now();
+			double elapsed = 0.0;
+			do
+			{
+				function();
+				iterations++;
+				elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+			} while (elapsed < m_MinTime);
+
+			Result result;
+			result.name = m_Prefix + name;
+			result.iterations = iterations;
+			result.nanoseconds = elapsed * 1e9 / iterations;
+			result.items = items;
+			m_Results.push_back(std::move(result));
+			return m_Results.back();
+		}
+
+		// Records a result, that was measured by the benchmark itself, e.g. with multiple threads
+		Result& Record(const std::string& name, double seconds, size_t iterations = 1, double items = 1.0)
+		{
+			Result result;
+			result.name = m_Prefix + name;
+			result.iterations = iterations;
+			result.nanoseconds = seconds * 1e9 / iterations;
+			result.items = items;
+			m_Results.push_back(std::move(result));
+			return m_Results.back();
+		}
+
+		// returns --name=value parameter from the command line or defaultValue
+		double Param(const std::string& name, double defaultValue) const
+		{
+			for (const auto& param : m_Params)
+			{
+				if (param.first == name)
+				{
+					return std::stod(param.second);
+				}
+			}
+			return defaultValue;
+		}
+
+		inline void SetPrefix(const std::string& prefix) { m_Prefix = prefix; }
+		inline const std::vector<Result>& Results() const { return m_Results; }
+	private:
+		const std::vector<std::pair<std::string, std::string>>& m_Params;
+		double m_MinTime;
+		std::string m_Prefix;
+		std::vector<Result> m_Results;
+	};
+
+	using Function = void(*)(State&);
+
+	struct Entry
+	{
+		const char* name;
+		Function function;
+	};
+
+	inline std::vector<Entry>& Registry()
+	{
+		static std::vector<Entry> registry;
+		return registry;
+	}
+
+	struct Registrar
+	{
+		Registrar(const char* name, Function function) { Registry().push_back({ name, function }); }
+	};
+}
+
+#define BENCHMARK(Name) \
+	static void Name(Benchmark::State& state); \
+	static Benchmark::Registrar s_##Name##Registrar(#Name, Name); \
+	static void Name(Benchmark::State& state)
@@ -0,0 +1,64 @@
+#include <Benchmark.h>
+#include <Utility/CSVImporter.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// Writes a CSV file with a header and two float columns
+static void WriteCSV(const std::string& path, size_t lines)
+{
+	std::ofstream file(path, std::ios::binary);
+	file << "time,value\n";
+	char line[64];
+	for (size_t i = 0; i < lines; i++)
+	{
+		int length = std::snprintf(line, sizeof(line), "%.6f,%.6f\n", i * 1e-3, std::sin(i * 1e-3) * 100.0);
+		file.write(line, length);
+	}
+}
+
+// Import throughput is compared to a plain scan of the same file, that is an upper bound for any parser.
+// The file is in the page cache after it is written, so both read memory rather than the disk
+BENCHMARK(CSVImport)
+{
+	const size_t lines = static_cast<size_t>(state.Param("lines", 8e6));
+	const std::string path = "csv-benchmark.csv";
+	WriteCSV(path, lines);
+
+	CSVImporter::Result result;
+	double bytes = 0.0;
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		bytes = static_cast<double>(file.tellg());
+	}
+
+	state.Measure("scan", [&]()
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::vector<char> buffer(1 << 20);
+		size_t newlines = 0;
+		while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+		{
+			const char* p = buffer.data();
+			const char* end = p + file.gcount();
+			while ((p = static_cast<const char*>(std::memchr(p, '\n', end - p))))
+			{
+				newlines++;
+				p++;
+			}
+		}
+		Benchmark::DoNotOptimize(newlines);
+	}, bytes);
+
+	state.Measure("import", [&]()
+	{
+		result = CSVImporter::Import(path, CSVImporter::Options());
+		Benchmark::DoNotOptimize(result.vertices.data());
+	}, bytes)
+		.Counter("lines", result.lines)
+		.Counter("points", result.vertices.size())
+		.Counter("skipped", result.skipped);
+
+	std::remove(path.c_str());
+}
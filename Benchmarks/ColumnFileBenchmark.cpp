@@ -0,0 +1,68 @@
+#include <Benchmark.h>
+#include <Utility/ColumnFile.h>
+
+#include <cstdio>
+#include <cmath>
+
+// Writes a sorted random walk, so that the file looks like a recorded capture
+static void WriteCapture(const std::string& path, size_t points, ColumnFile::Type type)
+{
+	ColumnWriter writer(path, points, type, type);
+	std::vector<double> xs(65536), ys(65536);
+	double y = 0.0;
+	for (size_t written = 0; written < points; written += xs.size())
+	{
+		size_t count = std::min(xs.size(), points - written);
+		for (size_t i = 0; i < count; i++)
+		{
+			y += std::sin(static_cast<double>(written + i) * 1e-4) * 0.01;
+			xs[i] = static_cast<double>(written + i) * 1e-3;
+			ys[i] = y;
+		}
+		writer.Append(xs.data(), ys.data(), count);
+	}
+	writer.Close();
+}
+
+// Opening must not depend on the file size. Panning reads only the pages of visible chunks, as MappedSeries uploads them
+BENCHMARK(ColumnFileAccess)
+{
+	const size_t points = static_cast<size_t>(state.Param("points", 16e6));
+	const size_t window = static_cast<size_t>(state.Param("window", 1e6));
+	const std::string path = "column-benchmark.cpcol";
+	WriteCapture(path, points, state.Param("float64", 0) ? ColumnFile::Type::Float64 : ColumnFile::Type::Float32);
+
+	state.Measure("open", [&]()
+	{
+		ColumnFile file(path);
+		Benchmark::DoNotOptimize(file.Chunks());
+	}).Counter("points", points);
+
+	ColumnFile file(path);
+	const double xStep = file.GetBounds().xMax / points;
+	size_t frame = 0;
+	size_t visible = 0;
+	state.Measure("pan", [&]()
+	{
+		// the view moves by a tenth of its width each frame, wrapping at the end of the file
+		double xMin = std::fmod(frame++ * window * xStep * 0.1, file.GetBounds().xMax - window * xStep);
+		double xMax = xMin + window * xStep;
+		size_t first = 0;
+		while (first < file.Chunks() && file.ChunkBounds(first).xMax < xMin) first++;
+		double sum = 0.0;
+		visible = 0;
+		for (size_t chunk = first; chunk < file.Chunks() && file.ChunkBounds(chunk).xMin <= xMax; chunk++)
+		{
+			// touch every page of the chunk, as the driver would when it copies the chunk
+			size_t begin = file.ChunkBegin(chunk);
+			for (size_t i = begin; i < begin + file.ChunkSize(chunk); i += 1024)
+			{
+				sum += file.X(i) + file.Y(i);
+			}
+			visible++;
+		}
+		Benchmark::DoNotOptimize(sum);
+	}, static_cast<double>(window)).Counter("visible_chunks", visible);
+
+	std::remove(path.c_str());
+}
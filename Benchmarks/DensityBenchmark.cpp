@@ -0,0 +1,53 @@
+#include <Benchmark.h>
+#include <Utility/Histogram2D.h>
+
+#include <random>
+
+// Binning of a gaussian scatter into a grid of half of a full HD viewport, as DensitySeries bins with 2 pixels per bin,
+// with a margin of the view's size on each side, as DensitySeries pads the binned region.
+// Serial binning is the reference, that shows the gain of per-thread histograms
+BENCHMARK(DensityBinning)
+{
+	const size_t count = static_cast<size_t>(state.Param("points", 1e7));
+	std::vector<sol::Vec2f> points(count);
+	std::mt19937 engine(7);
+	std::normal_distribution<float> normal(0.0f, 1.0f);
+	for (sol::Vec2f& point : points)
+	{
+		point = sol::Vec2f(normal(engine), normal(engine));
+	}
+
+	Histogram2D::Grid grid;
+	grid.columns = 3 * 960;
+	grid.rows = 3 * 540;
+	grid.binSize = sol::Vec2f(24.0f / grid.columns, 24.0f / grid.rows);
+	grid.origin = sol::Vec2f(-12.0f, -12.0f);
+
+	// the same arithmetic as Histogram2D, so that the counts are comparable bin by bin
+	const float scaleX = 1.0f / grid.binSize.x, scaleY = 1.0f / grid.binSize.y;
+	std::vector<uint32_t> counts;
+	state.Measure("serial", [&]()
+	{
+		counts.assign(grid.Bins(), 0);
+		for (const sol::Vec2f& point : points)
+		{
+			float column = (point.x - grid.origin.x) * scaleX;
+			float row = (point.y - grid.origin.y) * scaleY;
+			if (column >= 0.0f && column < grid.columns && row >= 0.0f && row < grid.rows)
+			{
+				counts[static_cast<size_t>(row) * grid.columns + static_cast<size_t>(column)]++;
+			}
+		}
+		Benchmark::DoNotOptimize(counts.data());
+	}, static_cast<double>(count));
+
+	Histogram2D histogram;
+	state.Measure("parallel", [&]()
+	{
+		histogram.Bin(points.data(), points.size(), grid);
+		Benchmark::DoNotOptimize(histogram.Counts().data());
+	}, static_cast<double>(count))
+		.Counter("bins", grid.Bins())
+		.Counter("max_count", histogram.MaxCount())
+		.Counter("matches_serial", histogram.Counts() == counts);
+}
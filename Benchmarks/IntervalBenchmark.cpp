@@ -0,0 +1,95 @@
+#include <Benchmark.h>
+#include <Utility/Interval.h>
+
+// Mirrors the way FunctionCurve uses interval bounds: the x-range is split into tiles of 256 samples,
+// each tile is bounded with a single interval evaluation and sampled only if it may contain a visible feature
+static constexpr size_t s_TileSamples = 256;
+
+struct Case
+{
+	const char* name;
+	float xMin, xMax;
+	float yMin, yMax;
+};
+
+template<typename F>
+static void RunCase(Benchmark::State& state, const Case& c, F function)
+{
+	const size_t tiles = static_cast<size_t>(state.Param("tiles", 4096));
+	const double step = (static_cast<double>(c.xMax) - c.xMin) / (tiles * s_TileSamples);
+	auto sampleX = [&](size_t tile, size_t k) { return static_cast<float>(c.xMin + (tile * s_TileSamples + k) * step); };
+
+	// Baseline: every sample of every tile is evaluated
+	state.Measure(std::string(c.name) + "/point", [&]()
+	{
+		float sum = 0.0f;
+		for (size_t tile = 0; tile < tiles; tile++)
+		{
+			for (size_t k = 0; k <= s_TileSamples; k++)
+			{
+				sum += function(sampleX(tile, k));
+			}
+		}
+		Benchmark::DoNotOptimize(sum);
+	}, static_cast<double>(tiles * (s_TileSamples + 1)));
+
+	// Interval: rejected tiles are skipped, discontinuous tiles are checked per sample interval
+	size_t rejected = 0, discontinuous = 0, breaks = 0;
+	Benchmark::Result& result = state.Measure(std::string(c.name) + "/interval", [&]()
+	{
+		rejected = discontinuous = breaks = 0;
+		float sum = 0.0f;
+		for (size_t tile = 0; tile < tiles; tile++)
+		{
+			sol::Interval bound = function(sol::Interval(sampleX(tile, 0), sampleX(tile, s_TileSamples)));
+			if (!bound.discontinuous && !bound.Overlaps(c.yMin, c.yMax))
+			{
+				rejected++;
+				continue;
+			}
+			discontinuous += bound.discontinuous;
+			for (size_t k = 0; k <= s_TileSamples; k++)
+			{
+				sum += function(sampleX(tile, k));
+				if (bound.discontinuous && k < s_TileSamples)
+				{
+					breaks += function(sol::Interval(sampleX(tile, k), sampleX(tile, k + 1))).discontinuous;
+				}
+			}
+		}
+		Benchmark::DoNotOptimize(sum);
+	}, static_cast<double>(tiles * (s_TileSamples + 1)));
+
+	// Conservativeness check: no sample of a rejected tile may lie inside the view
+	size_t missed = 0;
+	for (size_t tile = 0; tile < tiles; tile++)
+	{
+		sol::Interval bound = function(sol::Interval(sampleX(tile, 0), sampleX(tile, s_TileSamples)));
+		if (bound.discontinuous || bound.Overlaps(c.yMin, c.yMax))
+		{
+			continue;
+		}
+		for (size_t k = 0; k <= s_TileSamples; k++)
+		{
+			float y = function(sampleX(tile, k));
+			missed += y >= c.yMin && y <= c.yMax;
+		}
+	}
+
+	result.Counter("tiles", tiles)
+		.Counter("rejected_tiles", rejected)
+		.Counter("discontinuous_tiles", discontinuous)
+		.Counter("breaks", breaks)
+		.Counter("missed_samples", missed);
+}
+
+BENCHMARK(IntervalRejection)
+{
+	auto tan = [](auto x) { using std::tan; return tan(x); };
+	auto sinInverse = [](auto x) { using std::sin; return sin(1.0f / x); };
+
+	RunCase(state, { "tan/view", -100.0f, 100.0f, -1.0f, 1.0f }, tan);
+	RunCase(state, { "tan/above", -100.0f, 100.0f, 20.0f, 30.0f }, tan);
+	RunCase(state, { "sin_inverse/view", -1.0f, 1.0f, -1.0f, 1.0f }, sinInverse);
+	RunCase(state, { "sin_inverse/above", -100.0f, 100.0f, 0.5f, 1.0f }, sinInverse);
+}
@@ -0,0 +1,54 @@
+#include <Benchmark.h>
+#include <Utility/MinMaxPyramid.h>
+
+#include <random>
+
+// Random walk with x from 0 to the amount of points, as in the sample column files
+static std::vector<Vertex> RandomWalk(size_t points)
+{
+	std::vector<Vertex> vertices(points);
+	std::mt19937 engine(42);
+	std::normal_distribution<float> step(0.0f, 0.01f);
+	float y = 0.0f;
+	for (size_t i = 0; i < points; i++)
+	{
+		y += step(engine);
+		vertices[i] = Vertex(static_cast<float>(i), y, sol::Vec4f(1.0f));
+	}
+	return vertices;
+}
+
+// Pyramid is built once per series, aggregation runs on every change of the view.
+// Aggregation is measured for the whole range and for a zoomed-in range of 1% of the points
+BENCHMARK(M4Aggregation)
+{
+	const size_t points = static_cast<size_t>(state.Param("points", 5e7));
+	const size_t columns = static_cast<size_t>(state.Param("columns", 1920));
+	std::vector<Vertex> vertices = RandomWalk(points);
+
+	MinMaxPyramid pyramid;
+	state.Measure("build", [&]()
+	{
+		pyramid.Build(vertices.data(), vertices.size());
+	}, static_cast<double>(points))
+		.Counter("levels", pyramid.Levels())
+		.Counter("bytes", pyramid.Bytes());
+
+	std::vector<Vertex> output;
+	state.Measure("aggregate_full", [&]()
+	{
+		output.clear();
+		pyramid.Aggregate(vertices.data(), 0, points, 0.0f, static_cast<float>(points), columns, output);
+		Benchmark::DoNotOptimize(output.data());
+	}, static_cast<double>(points))
+		.Counter("emitted", output.size());
+
+	const size_t begin = points / 2, end = begin + points / 100;
+	state.Measure("aggregate_zoomed", [&]()
+	{
+		output.clear();
+		pyramid.Aggregate(vertices.data(), begin, end, static_cast<float>(begin), static_cast<float>(end), columns, output);
+		Benchmark::DoNotOptimize(output.data());
+	}, static_cast<double>(end - begin))
+		.Counter("emitted", output.size());
+}
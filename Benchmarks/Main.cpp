@@ -0,0 +1,95 @@
+#include <Benchmark.h>
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+// Escapes a string for JSON output. Benchmark names are plain ASCII, so only quotes and backslashes are escaped
+static std::string Escape(const std::string& string)
+{
+	std::string result;
+	for (char c : string)
+	{
+		if (c == '"' || c == '\\')
+		{
+			result.push_back('\\');
+		}
+		result.push_back(c);
+	}
+	return result;
+}
+
+static void PrintJSON(std::ostream& stream, const std::vector<Benchmark::Result>& results)
+{
+	stream << std::setprecision(6) << std::fixed;
+	stream << "{\n  \"benchmarks\": [\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const Benchmark::Result& result = results[i];
+		double seconds = result.nanoseconds * 1e-9;
+		stream << "    {\n"
+			<< "      \"name\": \"" << Escape(result.name) << "\",\n"
+			<< "      \"iterations\": " << result.iterations << ",\n"
+			<< "      \"ns_per_iteration\": " << result.nanoseconds << ",\n"
+			<< "      \"items_per_second\": " << (seconds > 0.0 ? result.items / seconds : 0.0);
+		for (const auto& counter : result.counters)
+		{
+			stream << ",\n      \"" << Escape(counter.first) << "\": " << counter.second;
+		}
+		stream << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	stream << "  ]\n}\n";
+}
+
+// Usage: cartesian-plotter-benchmarks [filter...] [--min-time=seconds] [--param=value...]
+// Only benchmarks, which names contain any of the filters, are run. All benchmarks are run if there are no filters
+int main(int argc, char** argv)
+{
+	std::vector<std::string> filters;
+	std::vector<std::pair<std::string, std::string>> params;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg.rfind("--", 0) == 0)
+		{
+			size_t equals = arg.find('=');
+			params.emplace_back(arg.substr(2, equals - 2), equals == std::string::npos ? "1" : arg.substr(equals + 1));
+		}
+		else
+		{
+			filters.push_back(arg);
+		}
+	}
+
+	double minTime = 0.25;
+	for (const auto& param : params)
+	{
+		if (param.first == "min-time")
+		{
+			minTime = std::stod(param.second);
+		}
+	}
+
+	Benchmark::State state(params, minTime);
+	for (const Benchmark::Entry& entry : Benchmark::Registry())
+	{
+		std::string name = entry.name;
+		bool selected = filters.empty();
+		for (const std::string& filter : filters)
+		{
+			selected = selected || name.find(filter) != std::string::npos;
+		}
+		if (!selected)
+		{
+			continue;
+		}
+
+		// progress goes to stderr, so that stdout contains only JSON
+		std::cerr << "Running " << name << std::endl;
+		state.SetPrefix(name + "/");
+		entry.function(state);
+	}
+
+	PrintJSON(std::cout, state.Results());
+	return 0;
+}
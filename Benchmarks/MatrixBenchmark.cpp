@@ -0,0 +1,161 @@
+#include <Benchmark.h>
+#include <Utility/Matrix.h>
+
+#include <random>
+#include <iostream>
+
+// The previous out-of-line scalar implementations, kept as the baseline of the header-inlined SIMD ones
+namespace Reference
+{
+	__attribute__((noinline)) sol::Mat4f Multiply(const sol::Mat4f& a, const sol::Mat4f& b)
+	{
+		sol::Mat4f result(1.0f);
+		for (size_t r = 0; r < 4; r++)
+		{
+			for (size_t c = 0; c < 4; c++)
+			{
+				result[r][c] = a[r][0] * b[0][c] + a[r][1] * b[1][c] + a[r][2] * b[2][c] + a[r][3] * b[3][c];
+			}
+		}
+		return result;
+	}
+
+	__attribute__((noinline)) sol::Vec4f Multiply(const sol::Mat4f& m, const sol::Vec4f& v)
+	{
+		return
+		{
+			m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3] * v.w,
+			m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3] * v.w,
+			m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3] * v.w,
+			m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3] * v.w
+		};
+	}
+
+	__attribute__((noinline)) sol::Mat4f Transpose(const sol::Mat4f& m)
+	{
+		return
+		{
+			sol::Vec4f(m[0][0], m[1][0], m[2][0], m[3][0]),
+			sol::Vec4f(m[0][1], m[1][1], m[2][1], m[3][1]),
+			sol::Vec4f(m[0][2], m[1][2], m[2][2], m[3][2]),
+			sol::Vec4f(m[0][3], m[1][3], m[2][3], m[3][3])
+		};
+	}
+
+	__attribute__((noinline)) sol::Vec3f Normalize(const sol::Vec3f& v3)
+	{
+		float magnitude = sqrtf(v3.x*v3.x + v3.y*v3.y + v3.z*v3.z);
+		return { v3.x / magnitude, v3.y / magnitude, v3.z / magnitude };
+	}
+
+	__attribute__((noinline)) sol::Vec3f Cross(const sol::Vec3f& u, const sol::Vec3f& v)
+	{
+		return { u[1] * v[2] - v[1] * u[2], u[2] * v[0] - v[2] * u[0], u[0] * v[1] - v[0] * u[1] };
+	}
+
+	__attribute__((noinline)) sol::Mat4f LookAt(const sol::Vec3f& from, const sol::Vec3f& to, const sol::Vec3f& up)
+	{
+		sol::Vec3f f = Reference::Normalize(to - from);
+		sol::Vec3f r = Reference::Normalize(Reference::Cross(f, up));
+		sol::Vec3f u = Reference::Cross(r, f);
+
+		sol::Mat4f result(1.0f);
+		result[0][0] = r.x; result[0][1] = r.y; result[0][2] = r.z;
+		result[1][0] = u.x; result[1][1] = u.y; result[1][2] = u.z;
+		result[2][0] = f.x; result[2][1] = f.y; result[2][2] = f.z;
+		result[3][0] = -from.x; result[3][1] = -from.y; result[3][2] = -from.z;
+		return result;
+	}
+}
+
+static float MaxDifference(const sol::Mat4f& a, const sol::Mat4f& b)
+{
+	float difference = 0.0f;
+	for (size_t r = 0; r < 4; r++)
+	{
+		for (size_t c = 0; c < 4; c++)
+		{
+			difference = std::max(difference, std::abs(a[r][c] - b[r][c]));
+		}
+	}
+	return difference;
+}
+
+// Model matrices of many objects, as the renderer composes them every frame: operator* on matrices and vectors,
+// Transpose and LookAt of the scalar out-of-line baseline against the inlined SIMD versions
+BENCHMARK(MatrixOps)
+{
+	const size_t count = static_cast<size_t>(state.Param("matrices", 1 << 14));
+	std::mt19937 engine(5);
+	std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+	auto random = [&]() { return sol::Vec4f(distribution(engine), distribution(engine), distribution(engine), distribution(engine)); };
+
+	std::vector<sol::Mat4f> a(count), b(count), result(count);
+	std::vector<sol::Vec4f> vectors(count), transformed(count);
+	std::vector<sol::Vec3f> eyes(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		a[i] = sol::Mat4f(random(), random(), random(), random());
+		b[i] = sol::Mat4f(random(), random(), random(), random());
+		vectors[i] = random();
+		eyes[i] = sol::Vec3f(random());
+	}
+
+	float difference = 0.0f;
+	for (size_t i = 0; i < count; i++)
+	{
+		difference = std::max(difference, MaxDifference(Reference::Multiply(a[i], b[i]), a[i] * b[i]) / 100.0f);
+		difference = std::max(difference, MaxDifference(Reference::Transpose(a[i]), sol::Transpose(a[i])));
+		difference = std::max(difference, MaxDifference(Reference::LookAt(eyes[i], sol::Vec3f(0.0f), sol::Vec3f(0.0f, 1.0f, 0.0f)), sol::LookAt(eyes[i], sol::Vec3f(0.0f))));
+	}
+	if (difference > 1e-4f)
+	{
+		std::cerr << "MatrixOps: SIMD results differ from the scalar ones by " << difference << std::endl;
+	}
+
+	const double items = static_cast<double>(count);
+	state.Measure("mat_mul_scalar", [&]()
+	{
+		for (size_t i = 0; i < count; i++) result[i] = Reference::Multiply(a[i], b[i]);
+		Benchmark::DoNotOptimize(result.data());
+	}, items);
+	state.Measure("mat_mul_simd", [&]()
+	{
+		for (size_t i = 0; i < count; i++) result[i] = a[i] * b[i];
+		Benchmark::DoNotOptimize(result.data());
+	}, items);
+
+	state.Measure("mat_vec_scalar", [&]()
+	{
+		for (size_t i = 0; i < count; i++) transformed[i] = Reference::Multiply(a[i], vectors[i]);
+		Benchmark::DoNotOptimize(transformed.data());
+	}, items);
+	state.Measure("mat_vec_simd", [&]()
+	{
+		for (size_t i = 0; i < count; i++) transformed[i] = a[i] * vectors[i];
+		Benchmark::DoNotOptimize(transformed.data());
+	}, items);
+
+	state.Measure("transpose_scalar", [&]()
+	{
+		for (size_t i = 0; i < count; i++) result[i] = Reference::Transpose(a[i]);
+		Benchmark::DoNotOptimize(result.data());
+	}, items);
+	state.Measure("transpose_simd", [&]()
+	{
+		for (size_t i = 0; i < count; i++) result[i] = sol::Transpose(a[i]);
+		Benchmark::DoNotOptimize(result.data());
+	}, items);
+
+	state.Measure("look_at_scalar", [&]()
+	{
+		for (size_t i = 0; i < count; i++) result[i] = Reference::LookAt(eyes[i], sol::Vec3f(0.0f), sol::Vec3f(0.0f, 1.0f, 0.0f));
+		Benchmark::DoNotOptimize(result.data());
+	}, items);
+	state.Measure("look_at_inline", [&]()
+	{
+		for (size_t i = 0; i < count; i++) result[i] = sol::LookAt(eyes[i], sol::Vec3f(0.0f));
+		Benchmark::DoNotOptimize(result.data());
+	}, items)
+		.Counter("max_difference", difference);
+}
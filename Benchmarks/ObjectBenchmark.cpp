@@ -0,0 +1,135 @@
+#include <Benchmark.h>
+#include <Core/Object.h>
+
+#include <random>
+
+// Objects are created with a callback, that does nothing, as Events::OnObjectRender() needs the renderer
+static bool NoUniforms(const Shader&, Object&)
+{
+	return true;
+}
+
+static std::vector<Vertex> MakeShape(size_t vertices)
+{
+	std::vector<Vertex> shape(vertices);
+	for (size_t i = 0; i < vertices; i++)
+	{
+		shape[i] = Vertex(static_cast<float>(i), static_cast<float>(i % 7), sol::Vec4f(0.5f));
+	}
+	return shape;
+}
+
+BENCHMARK(UUIDGeneration)
+{
+	const size_t count = static_cast<size_t>(state.Param("uuids", 1e4));
+	state.Measure("generate_v4", [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			UUID::uuid uuid = UUID::Generate_UUID_V4();
+			Benchmark::DoNotOptimize(uuid);
+		}
+	}, static_cast<double>(count));
+}
+
+// Copy generates a new UUID and copies vertices and AABB, move only steals them
+BENCHMARK(ObjectCopyMove)
+{
+	const size_t vertices = static_cast<size_t>(state.Param("vertices", 64));
+	Object object(MakeShape(vertices), nullptr, true, NoUniforms);
+	object.CreateAABB();
+
+	state.Measure("copy", [&]()
+	{
+		Object copy(object);
+		Benchmark::DoNotOptimize(copy);
+	}).Counter("vertices", static_cast<double>(vertices));
+
+	state.Measure("move", [&]()
+	{
+		Object moved(std::move(object));
+		object = std::move(moved);
+		Benchmark::DoNotOptimize(object);
+	}).Counter("vertices", static_cast<double>(vertices));
+}
+
+// ObjectHandler as used by the renderer and the UI: objects are added, found by index and removed,
+// materials are found by name once per object and frame
+BENCHMARK(ObjectHandlerOps)
+{
+	const size_t objects = static_cast<size_t>(state.Param("objects", 1e4));
+	const size_t vertices = static_cast<size_t>(state.Param("vertices", 16));
+	const size_t materials = static_cast<size_t>(state.Param("materials", 64));
+	const std::vector<Vertex> shape = MakeShape(vertices);
+
+	ObjectHandler handler;
+	std::vector<std::string> names;
+	for (size_t i = 0; i < materials; i++)
+	{
+		names.push_back("Material_" + std::to_string(i));
+		// shaders are default constructed, as there is no OpenGL context
+		handler.AddMaterial(names.back(), Material(Shader(), 1));
+	}
+
+	state.Measure("add", [&]()
+	{
+		ObjectHandler objectHandler;
+		for (size_t i = 0; i < objects; i++)
+		{
+			objectHandler.AddObject(Object(std::vector<Vertex>(shape), nullptr, true, NoUniforms));
+		}
+		Benchmark::DoNotOptimize(objectHandler.Objects().data());
+	}, static_cast<double>(objects));
+
+	for (size_t i = 0; i < objects; i++)
+	{
+		handler.AddObject(Object(std::vector<Vertex>(shape), nullptr, true, NoUniforms));
+	}
+	std::mt19937 engine(7);
+	std::uniform_int_distribution<size_t> indices(0, objects - 1);
+	std::vector<size_t> lookups(objects);
+	for (size_t& index : lookups)
+	{
+		index = indices(engine);
+	}
+
+	state.Measure("find", [&]()
+	{
+		size_t found = 0;
+		for (size_t index : lookups)
+		{
+			found += handler.FindObject(index)->Vertices().size();
+		}
+		Benchmark::DoNotOptimize(found);
+	}, static_cast<double>(objects));
+
+	// removal from the middle shifts the rest of the array, so every removed object is added back at the end
+	const size_t removals = std::min<size_t>(objects, 256);
+	state.Measure("remove_add", [&]()
+	{
+		for (size_t i = 0; i < removals; i++)
+		{
+			handler.RemoveObject(lookups[i] % handler.Objects().size());
+		}
+		for (size_t i = 0; i < removals; i++)
+		{
+			handler.AddObject(Object(std::vector<Vertex>(shape), nullptr, true, NoUniforms));
+		}
+	}, static_cast<double>(removals));
+
+	std::uniform_int_distribution<size_t> materialIndices(0, materials - 1);
+	std::vector<const std::string*> materialLookups(objects);
+	for (const std::string*& name : materialLookups)
+	{
+		name = &names[materialIndices(engine)];
+	}
+	state.Measure("find_material", [&]()
+	{
+		size_t found = 0;
+		for (const std::string* name : materialLookups)
+		{
+			found += handler.FindMaterial(*name) != nullptr;
+		}
+		Benchmark::DoNotOptimize(found);
+	}, static_cast<double>(objects));
+}
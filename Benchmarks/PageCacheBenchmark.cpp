@@ -0,0 +1,76 @@
+#include <Benchmark.h>
+#include <Utility/PageCache.h>
+
+#include <cstdio>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+// Simulates PagedSeries on a panning view: each frame requests the visible pages and takes those, that are loaded.
+// The frame time must stay flat while the loader thread reads, as the frame never waits for I/O.
+// The file is in the page cache of the OS after it is written, so the loader is bound by copying rather than the disk
+BENCHMARK(PageCachePan)
+{
+	const size_t points = static_cast<size_t>(state.Param("points", 32e6));
+	const size_t visibleChunks = static_cast<size_t>(state.Param("visible", 16));
+	const size_t frames = static_cast<size_t>(state.Param("frames", 2000));
+	const std::string path = "page-cache-benchmark.cpcol";
+	{
+		ColumnWriter writer(path, points);
+		std::vector<double> xs(65536), ys(65536);
+		for (size_t written = 0; written < points; written += xs.size())
+		{
+			size_t count = std::min(xs.size(), points - written);
+			for (size_t i = 0; i < count; i++)
+			{
+				xs[i] = static_cast<double>(written + i);
+				ys[i] = std::sin(static_cast<double>(written + i) * 1e-4);
+			}
+			writer.Append(xs.data(), ys.data(), count);
+		}
+		writer.Close();
+	}
+
+	std::shared_ptr<const ColumnFile> file = std::make_shared<const ColumnFile>(path);
+	PageCache cache(file, 64 * 1024 * 1024);
+	std::vector<size_t> wanted;
+	size_t found = 0, missing = 0;
+	std::vector<double> frameTimes(frames);
+	Benchmark::State::Clock::time_point start = Benchmark::State::Clock::now();
+	for (size_t frame = 0; frame < frames; frame++)
+	{
+		Benchmark::State::Clock::time_point frameStart = Benchmark::State::Clock::now();
+		// the view moves by a quarter of a chunk each frame and wraps at the end of the file
+		size_t first = (frame / 4) % (file->Chunks() - visibleChunks);
+		wanted.clear();
+		for (size_t chunk = first; chunk < std::min(first + visibleChunks + 2, file->Chunks()); chunk++)
+		{
+			wanted.push_back(chunk);
+		}
+		cache.Request(wanted);
+		for (size_t chunk = first; chunk < first + visibleChunks; chunk++)
+		{
+			std::shared_ptr<const PageCache::Page> page = cache.Find(chunk);
+			page ? found++ : missing++;
+			Benchmark::DoNotOptimize(page);
+		}
+		frameTimes[frame] = std::chrono::duration<double>(Benchmark::State::Clock::now() - frameStart).count();
+		// leaves the loader the rest of a frame, as rendering would
+		std::this_thread::sleep_for(std::chrono::microseconds(250));
+	}
+	double elapsed = std::chrono::duration<double>(Benchmark::State::Clock::now() - start).count();
+
+	// the worst frame includes preemption by the loader thread on machines with few cores, p99 shows waits on the cache
+	std::sort(frameTimes.begin(), frameTimes.end());
+	PageCache::Stats stats = cache.GetStats();
+	state.Record("frame", elapsed, frames, static_cast<double>(visibleChunks))
+		.Counter("p50_frame_us", frameTimes[frames / 2] * 1e6)
+		.Counter("p99_frame_us", frameTimes[frames * 99 / 100] * 1e6)
+		.Counter("worst_frame_us", frameTimes.back() * 1e6)
+		.Counter("found", found)
+		.Counter("missing", missing)
+		.Counter("loads", stats.loads)
+		.Counter("load_mb_per_s", stats.loadSeconds > 0.0 ? stats.loadedBytes / stats.loadSeconds / (1024.0 * 1024.0) : 0.0);
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,36 @@
+#include <Benchmark.h>
+#include <Utility/Profiler.h>
+
+// Zones are created directly, so that the cost is measured whether or not CARTESIAN_PLOTTER_PROFILER is defined.
+// The budget of a zone is 50 ns, i.e. a frame with a few hundred zones spends microseconds on them
+BENCHMARK(ProfilerZone)
+{
+	const size_t zones = static_cast<size_t>(state.Param("zones", 1e4));
+	state.Measure("zone", [&]()
+	{
+		for (size_t i = 0; i < zones; i++)
+		{
+			Profiler::Zone zone("Zone");
+		}
+	}, static_cast<double>(zones));
+
+	state.Measure("nested_zone", [&]()
+	{
+		for (size_t i = 0; i < zones / 4; i++)
+		{
+			Profiler::Zone outer("Outer");
+			{
+				Profiler::Zone middle("Middle");
+				Profiler::Zone inner("Inner");
+			}
+			Profiler::Zone sibling("Sibling");
+		}
+	}, static_cast<double>(zones / 4 * 4));
+
+	// the whole ring of the thread is copied, as the flame view and Chrome trace export do
+	state.Measure("collect_thread", [&]()
+	{
+		std::vector<Profiler::Event> events = Profiler::CollectThread();
+		Benchmark::DoNotOptimize(events);
+	}).Counter("events", static_cast<double>(Profiler::s_Capacity));
+}
@@ -0,0 +1,65 @@
+#include <Benchmark.h>
+#include <Utility/SceneFile.h>
+
+#include <cstdio>
+#include <cstring>
+
+// Saves and loads a scene of many small objects. Load copies vertices and UUIDs of every object out of the mapping,
+// as Scene::Load() does, and is compared to a plain copy of the whole file, i.e. the bound set by memory throughput.
+// The file is in the page cache after writing, so disk throughput isn't measured
+BENCHMARK(SceneSnapshot)
+{
+	const size_t objects = static_cast<size_t>(state.Param("objects", 1e6));
+	const size_t vertices = static_cast<size_t>(state.Param("vertices", 16));
+	const std::string path = "scene-benchmark.cpscene";
+
+	std::vector<Vertex> shape(vertices);
+	for (size_t i = 0; i < vertices; i++)
+	{
+		shape[i] = Vertex(static_cast<float>(i), static_cast<float>(i % 3), sol::Vec4f(0.5f));
+	}
+	SceneFile::ObjectRecord record = {};
+	record.scale[0] = record.scale[1] = record.scale[2] = 1.0f;
+	record.flags = SceneFile::ObjectFlags_Collider | SceneFile::ObjectFlags_AABB;
+	std::memcpy(record.uuid, "00000000-0000-4000-8000-000000000000", sizeof(record.uuid));
+
+	state.Measure("save", [&]()
+	{
+		SceneWriter writer(path);
+		record.material = writer.AddMaterial("Basic_Line_Strip", "Basic", 3);
+		for (size_t i = 0; i < objects; i++)
+		{
+			record.transform[0] = static_cast<float>(i);
+			writer.AddObject(record, shape.data(), shape.size());
+		}
+		writer.Close();
+	}, static_cast<double>(objects));
+
+	SceneFile file(path);
+	std::vector<std::vector<Vertex>> loaded(objects);
+	std::vector<std::string> uuids(objects);
+	state.Measure("load", [&]()
+	{
+		SceneFile file(path);
+		for (size_t i = 0; i < file.Objects(); i++)
+		{
+			const SceneFile::ObjectRecord& object = file.GetObject(i);
+			const Vertex* first = file.ObjectVertices(object);
+			loaded[i] = std::vector<Vertex>(first, first + object.vertexCount);
+			uuids[i] = std::string(object.uuid, sizeof(object.uuid));
+		}
+		Benchmark::DoNotOptimize(loaded.back().data());
+	}, static_cast<double>(objects)).Counter("bytes", static_cast<double>(file.Bytes()));
+
+	std::vector<unsigned char> copy(file.Bytes());
+	state.Measure("copy_file", [&]()
+	{
+		SceneFile file(path);
+		std::memcpy(copy.data(), &file.GetHeader(), sizeof(SceneFile::Header));
+		std::memcpy(copy.data() + file.GetHeader().verticesOffset, file.ObjectVertices(file.GetObject(0)), file.Vertices() * sizeof(Vertex));
+		std::memcpy(copy.data() + file.GetHeader().objectsOffset, &file.GetObject(0), file.Objects() * sizeof(SceneFile::ObjectRecord));
+		Benchmark::DoNotOptimize(copy.data());
+	}, static_cast<double>(objects));
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,169 @@
+#include <Benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <Utility/MPSCQueue.h>
+#include <Utility/Matrix.h>
+
+// Mirrors the way StreamingSeries is fed: producers push batches of points into a bounded MPSC queue,
+// the consumer drains it, extends the bounds and appends the points to a staging array, that would be uploaded
+using Batch = std::vector<sol::Vec2f>;
+
+struct Consumer
+{
+	Batch staging;
+	sol::Vec2f min = sol::Vec2f(std::numeric_limits<float>::max());
+	sol::Vec2f max = sol::Vec2f(std::numeric_limits<float>::lowest());
+	size_t points = 0;
+
+	void Drain(MPSCQueue<Batch>& queue)
+	{
+		Batch batch;
+		for (size_t i = 0; i < queue.Capacity() && queue.TryPop(batch); i++)
+		{
+			for (const sol::Vec2f& p : batch)
+			{
+				if (p.x < min.x) min.x = p.x;
+				if (p.y < min.y) min.y = p.y;
+				if (p.x > max.x) max.x = p.x;
+				if (p.y > max.y) max.y = p.y;
+			}
+			staging.insert(staging.end(), batch.begin(), batch.end());
+			points += batch.size();
+		}
+		// the staging array would be uploaded here, keep it from growing without bound
+		staging.clear();
+	}
+};
+
+static Batch MakeBatch(size_t first, size_t size)
+{
+	Batch batch(size);
+	for (size_t i = 0; i < size; i++)
+	{
+		float x = static_cast<float>(first + i);
+		batch[i] = sol::Vec2f(x, x * 0.5f);
+	}
+	return batch;
+}
+
+// Producers push as fast as they can and retry if the queue is full. The consumer drains continuously
+BENCHMARK(StreamingSaturation)
+{
+	const size_t producers = static_cast<size_t>(state.Param("producers", 4));
+	const size_t batchSize = static_cast<size_t>(state.Param("batch", 4096));
+	const double seconds = state.Param("seconds", 1.0);
+	MPSCQueue<Batch> queue(static_cast<size_t>(state.Param("queue", 1024)));
+
+	std::atomic<bool> running = true;
+	std::atomic<size_t> retries = 0;
+	std::vector<std::thread> threads;
+	for (size_t p = 0; p < producers; p++)
+	{
+		threads.emplace_back([&, p]()
+		{
+			size_t first = p << 40;
+			size_t localRetries = 0;
+			while (running.load(std::memory_order_relaxed))
+			{
+				Batch batch = MakeBatch(first, batchSize);
+				while (!queue.TryPush(std::move(batch)) && running.load(std::memory_order_relaxed))
+				{
+					localRetries++;
+					std::this_thread::yield();
+				}
+				first += batchSize;
+			}
+			retries.fetch_add(localRetries, std::memory_order_relaxed);
+		});
+	}
+
+	Consumer consumer;
+	auto start = Benchmark::State::Clock::now();
+	double elapsed = 0.0;
+	while (elapsed < seconds)
+	{
+		consumer.Drain(queue);
+		elapsed = std::chrono::duration<double>(Benchmark::State::Clock::now() - start).count();
+	}
+	running.store(false, std::memory_order_relaxed);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	Benchmark::DoNotOptimize(consumer.min);
+
+	double rate = consumer.points / elapsed;
+	state.Record("saturation", elapsed, 1, static_cast<double>(consumer.points))
+		.Counter("producers", producers)
+		.Counter("batch", batchSize)
+		.Counter("full_queue_retries", retries.load())
+		.Counter("meets_10M_points_per_second", rate >= 1e7);
+}
+
+// Producers emit points at a fixed rate and drop batches if the queue is full, as sensors would.
+// The consumer drains once per frame, as the render thread does
+BENCHMARK(StreamingFramePaced)
+{
+	const size_t producers = static_cast<size_t>(state.Param("producers", 4));
+	const size_t batchSize = static_cast<size_t>(state.Param("batch", 4096));
+	const double rate = state.Param("rate", 1e7);
+	const double seconds = state.Param("seconds", 1.0);
+	const double frame = 1.0 / state.Param("fps", 60.0);
+	MPSCQueue<Batch> queue(static_cast<size_t>(state.Param("queue", 1024)));
+
+	std::atomic<bool> running = true;
+	std::atomic<size_t> produced = 0;
+	std::atomic<size_t> dropped = 0;
+	auto start = Benchmark::State::Clock::now();
+	std::vector<std::thread> threads;
+	for (size_t p = 0; p < producers; p++)
+	{
+		threads.emplace_back([&, p]()
+		{
+			const double producerRate = rate / producers;
+			size_t first = p << 40;
+			size_t sent = 0;
+			while (running.load(std::memory_order_relaxed))
+			{
+				double elapsed = std::chrono::duration<double>(Benchmark::State::Clock::now() - start).count();
+				if (sent + batchSize > elapsed * producerRate)
+				{
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+					continue;
+				}
+				if (!queue.TryPush(MakeBatch(first, batchSize)))
+				{
+					dropped.fetch_add(batchSize, std::memory_order_relaxed);
+				}
+				first += batchSize;
+				sent += batchSize;
+			}
+			produced.fetch_add(sent, std::memory_order_relaxed);
+		});
+	}
+
+	Consumer consumer;
+	size_t frames = 0;
+	double elapsed = 0.0;
+	while (elapsed < seconds)
+	{
+		std::this_thread::sleep_until(start + std::chrono::duration_cast<Benchmark::State::Clock::duration>(std::chrono::duration<double>(frame * (frames + 1))));
+		consumer.Drain(queue);
+		frames++;
+		elapsed = std::chrono::duration<double>(Benchmark::State::Clock::now() - start).count();
+	}
+	running.store(false, std::memory_order_relaxed);
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	consumer.Drain(queue);
+	Benchmark::DoNotOptimize(consumer.min);
+
+	state.Record("frame_paced", elapsed, frames, static_cast<double>(consumer.points) / frames)
+		.Counter("offered_points_per_second", rate)
+		.Counter("produced_points", produced.load())
+		.Counter("dropped_points", dropped.load());
+}
@@ -0,0 +1,93 @@
+#include <Benchmark.h>
+#include <Utility/VertexTransform.h>
+
+#include <random>
+#include <cstring>
+#include <iostream>
+
+// World-space positions of a large array: the per-vertex product with a 4x4 model matrix, that objects used to have,
+// against the batch kernels on AoS vertices and SoA arrays. copy_* results move the same amount of bytes with memcpy()
+// and are the bandwidth, that the kernels should reach
+BENCHMARK(BatchTransform)
+{
+	const size_t count = static_cast<size_t>(state.Param("points", 1e8));
+	std::vector<Vertex> vertices(count);
+	std::vector<float> x(count), y(count);
+	std::mt19937 engine(9);
+	std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+	for (size_t i = 0; i < count; i++)
+	{
+		vertices[i] = Vertex(distribution(engine), distribution(engine), sol::Vec4f(1.0f));
+		x[i] = vertices[i].position.x;
+		y[i] = vertices[i].position.y;
+	}
+	std::vector<sol::Vec2f> positions(count);
+	std::vector<float> outputX(count), outputY(count);
+
+	const sol::Mat4f matrix = sol::Translate(sol::Mat4f(1.0f), sol::Vec3f(3.0f, -2.0f, 0.0f)) * sol::RotateZ(0.3f) * sol::Scale(sol::Vec3f(2.0f, 0.5f, 1.0f));
+	const sol::Affine2f model = sol::TRS(sol::Vec2f(3.0f, -2.0f), 0.3f, sol::Vec2f(2.0f, 0.5f));
+
+	// results of the kernels must match the per-vertex product
+	VertexTransform::Apply(model, vertices.data(), count, positions.data());
+	VertexTransform::Apply(model, x.data(), y.data(), count, outputX.data(), outputY.data());
+	float difference = 0.0f;
+	for (size_t i = 0; i < count; i++)
+	{
+		sol::Vec2f expected = sol::Vec2f(matrix * sol::Vec4f(vertices[i].position, 0.0f, 1.0f));
+		difference = std::max({ difference, std::abs(expected.x - positions[i].x), std::abs(expected.y - positions[i].y)
+			, std::abs(expected.x - outputX[i]), std::abs(expected.y - outputY[i]) });
+	}
+	if (difference > 1e-3f)
+	{
+		std::cerr << "BatchTransform: kernels differ from the 4x4 product by " << difference << std::endl;
+	}
+
+	const double items = static_cast<double>(count);
+	state.Measure("per_vertex_mat4", [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			positions[i] = sol::Vec2f(matrix * sol::Vec4f(vertices[i].position, 0.0f, 1.0f));
+		}
+		Benchmark::DoNotOptimize(positions.data());
+	}, items);
+
+	state.Measure("aos_to_positions", [&]()
+	{
+		VertexTransform::Apply(model, vertices.data(), count, positions.data());
+		Benchmark::DoNotOptimize(positions.data());
+	}, items)
+		.Counter("bytes", static_cast<double>(count * (sizeof(Vertex) + sizeof(sol::Vec2f))))
+		.Counter("max_difference", difference);
+
+	// in-place transforms are repeated, so they rotate only: coordinates neither overflow nor become denormal
+	const sol::Affine2f rotation = sol::TRS(sol::Vec2f(0.0f), 0.3f, sol::Vec2f(1.0f));
+	state.Measure("aos_in_place", [&]()
+	{
+		VertexTransform::Apply(rotation, vertices.data(), count);
+		Benchmark::DoNotOptimize(vertices.data());
+	}, items)
+		.Counter("bytes", static_cast<double>(2 * count * sizeof(Vertex)));
+
+	state.Measure("soa_to_output", [&]()
+	{
+		VertexTransform::Apply(model, x.data(), y.data(), count, outputX.data(), outputY.data());
+		Benchmark::DoNotOptimize(outputX.data());
+	}, items)
+		.Counter("bytes", static_cast<double>(4 * count * sizeof(float)));
+
+	state.Measure("soa_in_place", [&]()
+	{
+		VertexTransform::Apply(rotation, x.data(), y.data(), count);
+		Benchmark::DoNotOptimize(x.data());
+	}, items)
+		.Counter("bytes", static_cast<double>(4 * count * sizeof(float)));
+
+	state.Measure("copy_soa", [&]()
+	{
+		std::memcpy(outputX.data(), x.data(), count * sizeof(float));
+		std::memcpy(outputY.data(), y.data(), count * sizeof(float));
+		Benchmark::DoNotOptimize(outputX.data());
+	}, items)
+		.Counter("bytes", static_cast<double>(4 * count * sizeof(float)));
+}
@@ -5,7 +5,8 @@ layout (location = 1) in vec4 a_Color;
 
 uniform mat4 u_Projection;
 uniform mat4 u_View;
-uniform mat4 u_Model;
+// affine 2D transform of the object, see Shader::SetUniformAffine2()
+uniform mat3x2 u_Model;
 
 uniform vec4 u_SelectedColor;
 uniform bool u_Selected;
@@ -19,5 +20,5 @@ void main()
 	{
 		o_Color = a_Color * vec4(u_SelectedColor.xyz, 1.0);
 	}
-	gl_Position = u_Projection * u_View * u_Model * vec4(a_Position.xy, 0.0, 1.0);
+	gl_Position = u_Projection * u_View * vec4(u_Model * vec3(a_Position.xy, 1.0), 0.0, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#version 450 core
+
+// Coordinates come from separate columns, color is a constant attribute
+layout (location = 0) in float a_X;
+layout (location = 1) in vec4 a_Color;
+layout (location = 2) in float a_Y;
+
+uniform mat4 u_Projection;
+uniform mat4 u_View;
+// affine 2D transform of the object, see Shader::SetUniformAffine2()
+uniform mat3x2 u_Model;
+
+uniform vec4 u_SelectedColor;
+uniform bool u_Selected;
+
+out vec4 o_Color;
+
+void main()
+{
+	o_Color = a_Color;
+	if (u_Selected)
+	{
+		o_Color = a_Color * vec4(u_SelectedColor.xyz, 1.0);
+	}
+	gl_Position = u_Projection * u_View * vec4(u_Model * vec3(a_X, a_Y, 1.0), 0.0, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 450 core
+
+// Quad of the histogram grid, the histogram itself is a texture
+layout (location = 0) in vec2 a_Position;
+layout (location = 3) in vec2 a_TexCoord;
+
+uniform mat4 u_Projection;
+uniform mat4 u_View;
+// affine 2D transform of the object, see Shader::SetUniformAffine2()
+uniform mat3x2 u_Model;
+
+out vec2 o_TexCoord;
+
+void main()
+{
+	o_TexCoord = a_TexCoord;
+	gl_Position = u_Projection * u_View * vec4(u_Model * vec3(a_Position, 1.0), 0.0, 1.0);
+}
@@ -0,0 +1,28 @@
+#version 450 core
+
+// Only y values are stored, x is computed from the index of the sample in the ring.
+// Color and scope parameters are constant attributes, a_Scope is (x of vertex 0, distance between samples)
+layout (location = 1) in vec4 a_Color;
+layout (location = 2) in float a_Y;
+layout (location = 4) in vec2 a_Scope;
+
+uniform mat4 u_Projection;
+uniform mat4 u_View;
+// affine 2D transform of the object, see Shader::SetUniformAffine2()
+uniform mat3x2 u_Model;
+
+uniform vec4 u_SelectedColor;
+uniform bool u_Selected;
+
+out vec4 o_Color;
+
+void main()
+{
+	o_Color = a_Color;
+	if (u_Selected)
+	{
+		o_Color = a_Color * vec4(u_SelectedColor.xyz, 1.0);
+	}
+	float x = a_Scope.x + float(gl_VertexID) * a_Scope.y;
+	gl_Position = u_Projection * u_View * vec4(u_Model * vec3(x, a_Y, 1.0), 0.0, 1.0);
+}
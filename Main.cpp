@@ -1,11 +1,156 @@
 #include <Application.h>
+#include <Renderer.h>
+#include <Core/Offscreen.h>
+#include <Core/FrameBenchmark.h>
 #include <Utility/Matrix.h>
 #include <Utility/Vertex.h>
+#include <Utility/Profiler.h>
 
-int main()
-{	
-	// We create a pointer with an application and run it immediately
-	std::unique_ptr<Application> app = std::make_unique<Application>("Cartesian Plotter");
-	app->SetVsync(true);
-	app->Run(1920, 1000);
+// Renders frames of the scene into an offscreen framebuffer and writes them as PPM images. Neither GLFW nor ImGui are initialized.
+// If more than one frame is rendered, frames are written to numbered files, e.g. plot-0.ppm, plot-1.ppm, etc.
+static void RunHeadless(int width, int height, int frames, const std::string& output)
+{
+	// offscreen context is declared first, so that the renderer releases its OpenGL objects before the context is destroyed
+	Offscreen offscreen(width, height);
+	Renderer renderer(width, height, 2048);
+	for (int frame = 0; frame < frames; frame++)
+	{
+		PROFILE_ZONE("Frame");
+		offscreen.Bind();
+		glClearColor(0.11f, 0.11f, 0.12f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		renderer.Update();
+
+		std::string path = output;
+		if (frames > 1)
+		{
+			size_t extension = output.rfind('.');
+			path = extension == std::string::npos ? output + "-" + std::to_string(frame)
+				: output.substr(0, extension) + "-" + std::to_string(frame) + output.substr(extension);
+		}
+		offscreen.WritePPM(path);
+		std::cout << "Wrote frame " << frame << " to " << path << std::endl;
+	}
+}
+
+// Measures frame times on a synthetic scene in headless mode and writes JSON to output, or to stdout if output is empty
+static void RunFrameBenchmark(int width, int height, const FrameBenchmark::Options& options, const std::string& output)
+{
+	Offscreen offscreen(width, height);
+	Renderer renderer(width, height, 2048);
+	FrameBenchmark::Result result = FrameBenchmark::Run(offscreen, renderer, options);
+	if (output.empty())
+	{
+		FrameBenchmark::PrintJSON(std::cout, options, result);
+		return;
+	}
+	std::ofstream file(output);
+	FrameBenchmark::PrintJSON(file, options, result);
+	if (!file)
+	{
+		throw std::runtime_error("Failed to write " + output);
+	}
+	std::cout << "Wrote frame benchmark results to " << output << std::endl;
+}
+
+// Parses a whole number, that is at least min and fits into int. Throws std::invalid_argument or std::out_of_range otherwise
+static int ParseCount(const std::string& value, int min)
+{
+	size_t end = 0;
+	int count = std::stoi(value, &end);
+	if (end != value.size() || count < min)
+	{
+		throw std::invalid_argument("Value must be a whole number of at least " + std::to_string(min));
+	}
+	return count;
+}
+
+// Usage: cartesian-plotter [--headless | --frame-benchmark] [--width=pixels] [--height=pixels] [--frames=count] [--output=path] [--trace=path]
+// 	Frame benchmark options: [--objects=count] [--vertices=count] [--aabb-percent=percent] [--warmup=frames]
+// Frames and output are only used in headless modes, size is the size of the window otherwise.
+// Output is the image path in headless mode and the JSON path of the frame benchmark.
+// Trace is the path of Chrome trace JSON with CPU zones, that is written on exit, see <Utility/Profiler.h>
+int main(int argc, char** argv)
+{
+	PROFILE_THREAD("Render");
+	bool headless = false;
+	bool frameBenchmark = false;
+	int width = 1920;
+	int height = 1000;
+	int frames = 1;
+	std::string output;
+	std::string trace;
+	FrameBenchmark::Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		size_t equals = arg.find('=');
+		std::string name = arg.substr(0, equals);
+		std::string value = equals == std::string::npos ? std::string() : arg.substr(equals + 1);
+		// numeric values throw std::invalid_argument or std::out_of_range, if they can't be parsed or are out of range,
+		// so that negative values never wrap around in unsigned options
+		try
+		{
+			if (name == "--headless") headless = true;
+			else if (name == "--frame-benchmark") frameBenchmark = true;
+			else if (name == "--width") width = ParseCount(value, 1);
+			else if (name == "--height") height = ParseCount(value, 1);
+			else if (name == "--frames") { frames = ParseCount(value, 1); options.frames = frames; }
+			else if (name == "--output") output = value;
+			else if (name == "--trace") trace = value;
+			else if (name == "--objects") options.objects = ParseCount(value, 1);
+			else if (name == "--vertices") options.vertices = ParseCount(value, 1);
+			else if (name == "--aabb-percent")
+			{
+				options.aabbPercent = std::stof(value);
+				if (!(options.aabbPercent >= 0.0f && options.aabbPercent <= 100.0f))
+				{
+					throw std::out_of_range("Percent must be in range [0; 100]");
+				}
+			}
+			else if (name == "--warmup") options.warmupFrames = ParseCount(value, 0);
+			else
+			{
+				std::cout << "Unknown argument " << arg << std::endl;
+				return 1;
+			}
+		}
+		catch (const std::logic_error&)
+		{
+			std::cout << "Invalid value of argument " << arg << std::endl;
+			return 1;
+		}
+	}
+
+	// Headless modes throw, e.g. std::runtime_error if there is no EGL display, they fail with a message instead of aborting
+	try
+	{
+		if (frameBenchmark)
+		{
+			RunFrameBenchmark(width, height, options, output);
+		}
+		else if (headless)
+		{
+			RunHeadless(width, height, frames, output.empty() ? "plot.ppm" : output);
+		}
+		else
+		{
+			// We create a pointer with an application and run it immediately
+			std::unique_ptr<Application> app = std::make_unique<Application>("Cartesian Plotter");
+			app->SetVsync(true);
+			app->Run(width, height);
+		}
+
+		if (!trace.empty())
+		{
+			Profiler::WriteChromeTrace(trace);
+			std::cout << "Wrote Chrome trace to " << trace << std::endl;
+		}
+	}
+	catch (const std::exception& error)
+	{
+		std::cout << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
 }
@@ -0,0 +1,416 @@
+#include <Core/Analysis.h>
+#include <Utility/Profiler.h>
+
+static constexpr int s_MaxIterations = 64;
+
+static bool IsFinite(const sol::Vec2f& p)
+{
+	return std::isfinite(p.x) && std::isfinite(p.y);
+}
+
+static bool InRange(float x, float xMin, float xMax)
+{
+	return x >= xMin && x <= xMax;
+}
+
+// Calls progress every s_ProgressStride steps. Returns false if the search must stop
+static bool Continue(const Analysis::Progress& progress, size_t step)
+{
+	return !progress || step % Analysis::s_ProgressStride != 0 || progress();
+}
+
+// Bisection of g on [a; b], where g(a) and g(b) have different signs
+template<typename F>
+static float Bisect(const F& g, float a, float b, float ga)
+{
+	for (int i = 0; i < s_MaxIterations; i++)
+	{
+		float m = 0.5f * (a + b);
+		if (m <= a || m >= b)
+		{
+			break;
+		}
+		float gm = g(m);
+		if ((gm < 0.0f) == (ga < 0.0f))
+		{
+			a = m;
+			ga = gm;
+		}
+		else
+		{
+			b = m;
+		}
+	}
+	return 0.5f * (a + b);
+}
+
+// Golden-section search of the maximum of g on [a; b]
+template<typename F>
+static float GoldenMax(const F& g, float a, float b)
+{
+	const float ratio = 0.5f * (std::sqrt(5.0f) - 1.0f);
+	float c = b - ratio * (b - a);
+	float d = a + ratio * (b - a);
+	float gc = g(c), gd = g(d);
+	for (int i = 0; i < s_MaxIterations && c < d; i++)
+	{
+		if (gc > gd)
+		{
+			b = d;
+			d = c;
+			gd = gc;
+			c = b - ratio * (b - a);
+			gc = g(c);
+		}
+		else
+		{
+			a = c;
+			c = d;
+			gc = gd;
+			d = a + ratio * (b - a);
+			gd = g(d);
+		}
+	}
+	return 0.5f * (a + b);
+}
+
+namespace Analysis
+{
+	const char* ToString(Marker::Type type)
+	{
+		switch (type)
+		{
+		case Marker::Type::Root: return "Root";
+		case Marker::Type::Minimum: return "Minimum";
+		case Marker::Type::Maximum: return "Maximum";
+		case Marker::Type::Intersection: return "Intersection";
+		}
+		return "Unknown";
+	}
+
+	float Curve::Evaluate(float x) const
+	{
+		return scale.y * function((x - translation.x) / scale.x) + translation.y;
+	}
+
+	void FindRoots(const Curve& curve, size_t index, float xMin, float xMax, const Report& report, const Progress& progress)
+	{
+		const std::vector<sol::Vec2f>& points = curve.points;
+		for (size_t i = 1; i < points.size() && ::Continue(progress, i); i++)
+		{
+			const sol::Vec2f& a = points[i - 1];
+			const sol::Vec2f& b = points[i];
+			if (!IsFinite(a) || !IsFinite(b) || (a.y < 0.0f) == (b.y < 0.0f))
+			{
+				continue;
+			}
+
+			sol::Vec2f root;
+			if (curve.function)
+			{
+				auto g = [&](float x) { return curve.Evaluate(x); };
+				float left = std::min(a.x, b.x), right = std::max(a.x, b.x);
+				float gLeft = g(left), gRight = g(right);
+				if ((gLeft < 0.0f) == (gRight < 0.0f))
+				{
+					continue;
+				}
+				if (gLeft == 0.0f || gRight == 0.0f)
+				{
+					// exact root at the end of the bracket
+					root = sol::Vec2f(gLeft == 0.0f ? left : right, 0.0f);
+					if (InRange(root.x, xMin, xMax))
+					{
+						report({ Marker::Type::Root, root, index, index });
+					}
+					continue;
+				}
+				float x = Bisect(g, left, right, gLeft);
+				// a sign change across a pole converges to the pole, where |g| grows instead of vanishing
+				if (!(std::abs(g(x)) <= std::min(std::abs(gLeft), std::abs(gRight))))
+				{
+					continue;
+				}
+				root = sol::Vec2f(x, 0.0f);
+			}
+			else
+			{
+				float t = a.y / (a.y - b.y);
+				root = sol::Vec2f(a.x + t * (b.x - a.x), 0.0f);
+			}
+
+			if (InRange(root.x, xMin, xMax))
+			{
+				report({ Marker::Type::Root, root, index, index });
+			}
+		}
+	}
+
+	void FindExtrema(const Curve& curve, size_t index, float xMin, float xMax, const Report& report, const Progress& progress)
+	{
+		const std::vector<sol::Vec2f>& points = curve.points;
+		// index of the point, where the last non-zero slope began, and the sign of that slope
+		size_t start = 0;
+		int slope = 0;
+		for (size_t i = 1; i < points.size() && ::Continue(progress, i); i++)
+		{
+			const sol::Vec2f& a = points[i - 1];
+			const sol::Vec2f& b = points[i];
+			if (!IsFinite(a) || !IsFinite(b))
+			{
+				slope = 0;
+				continue;
+			}
+			float dy = b.y - a.y;
+			int sign = (dy > 0.0f) - (dy < 0.0f);
+			if (sign == 0)
+			{
+				continue;
+			}
+			if (slope == 0 || sign == slope)
+			{
+				if (sign != slope)
+				{
+					start = i - 1;
+				}
+				slope = sign;
+				continue;
+			}
+
+			// Slope changed its sign. Extremum is bracketed by points [start; i]
+			bool isMaximum = slope > 0;
+			const sol::Vec2f& left = points[start];
+			const sol::Vec2f& right = b;
+			sol::Vec2f extremum;
+			if (curve.function && left.x < right.x)
+			{
+				float direction = isMaximum ? 1.0f : -1.0f;
+				float x = GoldenMax([&](float x) { return direction * curve.Evaluate(x); }, left.x, right.x);
+				extremum = sol::Vec2f(x, curve.Evaluate(x));
+			}
+			else
+			{
+				// vertex of the parabola through the extreme point and its neighbours
+				const sol::Vec2f& p0 = points[std::max(start, i - 2)];
+				const sol::Vec2f& p1 = a;
+				const sol::Vec2f& p2 = b;
+				float d1 = (p1.y - p0.y) * (p2.x - p1.x);
+				float d2 = (p2.y - p1.y) * (p1.x - p0.x);
+				float denominator = 2.0f * (d1 - d2);
+				extremum = p1;
+				if (denominator != 0.0f && p0.x != p1.x && p1.x != p2.x)
+				{
+					float shift = (d1 * (p2.x - p1.x) + d2 * (p1.x - p0.x)) / denominator;
+					float x = std::clamp(p1.x + shift, std::min(p0.x, p2.x), std::max(p0.x, p2.x));
+					// y is taken from the polyline, as the parabola may overshoot on noisy data
+					extremum = sol::Vec2f(x, p1.y);
+				}
+			}
+
+			if (IsFinite(extremum) && InRange(extremum.x, xMin, xMax))
+			{
+				report({ isMaximum ? Marker::Type::Maximum : Marker::Type::Minimum, extremum, index, index });
+			}
+			start = i - 1;
+			slope = sign;
+		}
+	}
+
+	void FindIntersections(const std::vector<Curve>& curves, float xMin, float xMax, const Report& report, const Progress& progress)
+	{
+		struct Segment
+		{
+			sol::Vec2f a;
+			sol::Vec2f b;
+			float xLeft;
+			float xRight;
+			size_t curve;
+		};
+
+		std::vector<Segment> segments;
+		for (size_t c = 0; c < curves.size(); c++)
+		{
+			const std::vector<sol::Vec2f>& points = curves[c].points;
+			for (size_t i = 1; i < points.size(); i++)
+			{
+				if (!::Continue(progress, i))
+				{
+					return;
+				}
+				const sol::Vec2f& a = points[i - 1];
+				const sol::Vec2f& b = points[i];
+				float left = std::min(a.x, b.x), right = std::max(a.x, b.x);
+				if (IsFinite(a) && IsFinite(b) && right >= xMin && left <= xMax)
+				{
+					segments.push_back({ a, b, left, right, c });
+				}
+			}
+		}
+		std::sort(segments.begin(), segments.end(), [](const Segment& s1, const Segment& s2) { return s1.xLeft < s2.xLeft; });
+
+		// Active segments are those, which x-ranges contain the current sweep position
+		std::vector<const Segment*> active;
+		for (size_t i = 0; i < segments.size(); i++)
+		{
+			if (!::Continue(progress, i + 1))
+			{
+				return;
+			}
+			const Segment& segment = segments[i];
+			active.erase(std::remove_if(active.begin(), active.end(), [&](const Segment* other) { return other->xRight < segment.xLeft; }), active.end());
+			for (const Segment* other : active)
+			{
+				if (other->curve == segment.curve)
+				{
+					continue;
+				}
+				if (std::max(segment.a.y, segment.b.y) < std::min(other->a.y, other->b.y)
+					|| std::min(segment.a.y, segment.b.y) > std::max(other->a.y, other->b.y))
+				{
+					continue;
+				}
+
+				sol::Vec2f r = sol::Vec2f(segment.b.x - segment.a.x, segment.b.y - segment.a.y);
+				sol::Vec2f s = sol::Vec2f(other->b.x - other->a.x, other->b.y - other->a.y);
+				float denominator = r.x * s.y - r.y * s.x;
+				if (denominator == 0.0f)
+				{
+					// parallel or collinear segments
+					continue;
+				}
+				sol::Vec2f qp = sol::Vec2f(other->a.x - segment.a.x, other->a.y - segment.a.y);
+				float t = (qp.x * s.y - qp.y * s.x) / denominator;
+				float u = (qp.x * r.y - qp.y * r.x) / denominator;
+				// half-open ranges, so that an intersection at a shared vertex is reported once
+				if (t < 0.0f || t >= 1.0f || u < 0.0f || u >= 1.0f)
+				{
+					continue;
+				}
+				sol::Vec2f point = sol::Vec2f(segment.a.x + t * r.x, segment.a.y + t * r.y);
+
+				// Expression-backed curves are refined with bisection of their difference
+				const Curve& c1 = curves[segment.curve];
+				const Curve& c2 = curves[other->curve];
+				if (c1.function && c2.function)
+				{
+					auto h = [&](float x) { return c1.Evaluate(x) - c2.Evaluate(x); };
+					float left = std::max(segment.xLeft, other->xLeft);
+					float right = std::min(segment.xRight, other->xRight);
+					float hLeft = h(left), hRight = h(right);
+					if (left < right && (hLeft < 0.0f) != (hRight < 0.0f))
+					{
+						float x = Bisect(h, left, right, hLeft);
+						point = sol::Vec2f(x, c1.Evaluate(x));
+					}
+				}
+
+				if (IsFinite(point) && InRange(point.x, xMin, xMax))
+				{
+					report({ Marker::Type::Intersection, point, other->curve, segment.curve });
+				}
+			}
+			active.push_back(&segment);
+		}
+	}
+}
+
+Analyzer::~Analyzer()
+{
+	this->Cancel();
+	for (std::unique_ptr<Job>& job : m_Jobs)
+	{
+		job->thread.join();
+	}
+}
+
+void Analyzer::Start(std::vector<Analysis::Curve>&& curves, float xMin, float xMax, Options options)
+{
+	this->Cancel();
+	this->JoinFinished();
+	{
+		// markers of the cancelled job, that were published before the lock, are dropped here, and it drops the rest itself
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Found.clear();
+	}
+	m_Jobs.push_back(std::make_unique<Job>());
+	Job& job = *m_Jobs.back();
+	job.thread = std::thread(&Analyzer::Run, this, std::ref(job), std::move(curves), xMin, xMax, options);
+}
+
+void Analyzer::Cancel()
+{
+	if (!m_Jobs.empty())
+	{
+		m_Jobs.back()->isCancelled.store(true, std::memory_order_release);
+	}
+}
+
+void Analyzer::JoinFinished()
+{
+	auto finished = std::remove_if(m_Jobs.begin(), m_Jobs.end(), [](const std::unique_ptr<Job>& job) -> bool
+	{
+		if (!job->isFinished.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		job->thread.join();
+		return true;
+	});
+	m_Jobs.erase(finished, m_Jobs.end());
+}
+
+size_t Analyzer::Poll(std::vector<Analysis::Marker>& markers)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	size_t count = m_Found.size();
+	markers.insert(markers.end(), m_Found.begin(), m_Found.end());
+	m_Found.clear();
+	return count;
+}
+
+void Analyzer::Run(Job& job, std::vector<Analysis::Curve> curves, float xMin, float xMax, Options options)
+{
+	PROFILE_THREAD("Analyzer");
+	PROFILE_ZONE("Analyzer::Run");
+	// Markers are batched, so that the mutex is taken once per curve and stage, or once per s_ProgressStride segments
+	std::vector<Analysis::Marker> batch;
+	Analysis::Report collect = [&](const Analysis::Marker& marker) { batch.push_back(marker); };
+	auto flush = [&]()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		// cancellation is checked under the lock, so that nothing is published after Start() of the next job clears markers
+		if (!job.isCancelled.load(std::memory_order_acquire))
+		{
+			m_Found.insert(m_Found.end(), batch.begin(), batch.end());
+		}
+		batch.clear();
+	};
+	Analysis::Progress progress = [&]() -> bool
+	{
+		if (!batch.empty())
+		{
+			flush();
+		}
+		return !job.isCancelled.load(std::memory_order_acquire);
+	};
+
+	for (size_t i = 0; i < curves.size() && progress(); i++)
+	{
+		if (options.roots)
+		{
+			Analysis::FindRoots(curves[i], i, xMin, xMax, collect, progress);
+			flush();
+		}
+		if (options.extrema)
+		{
+			Analysis::FindExtrema(curves[i], i, xMin, xMax, collect, progress);
+			flush();
+		}
+	}
+	if (options.intersections && progress())
+	{
+		Analysis::FindIntersections(curves, xMin, xMax, collect, progress);
+		flush();
+	}
+	job.isFinished.store(true, std::memory_order_release);
+}
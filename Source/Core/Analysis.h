@@ -0,0 +1,121 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <Utility/Matrix.h>
+
+/**
+ * 	Namespace, that contains numeric analysis of plotted curves: roots, extrema and intersections
+ *
+ * 	Curves are analyzed as snapshots in world space, so that the analysis never touches objects,
+ * 	that are being rendered, and may safely run on a background thread. For a reference see Analyzer below
+ */
+namespace Analysis
+{
+	struct Marker
+	{
+		enum class Type { Root, Minimum, Maximum, Intersection };
+
+		Type type;
+		sol::Vec2f position;
+		// index of the curve, the marker was found on. Intersections also store the index of the other curve
+		size_t curve;
+		size_t other;
+	};
+
+	const char* ToString(Marker::Type type);
+
+	/**
+	 * 	Curve is a polyline in world space. Points with non-finite coordinates break the polyline
+	 *
+	 * 	If function is set, the curve is expression-backed, i.e. y = scale.y * function((x - translation.x) / scale.x) + translation.y
+	 * 	Markers of such curves are refined with the function itself instead of the polyline
+	 */
+	struct Curve
+	{
+		std::vector<sol::Vec2f> points;
+		std::function<float(float)> function;
+		sol::Vec2f scale = sol::Vec2f(1.0f);
+		sol::Vec2f translation = sol::Vec2f(0.0f);
+
+		// evaluates the function in world space. Must only be called if the curve has a function
+		float Evaluate(float x) const;
+	};
+
+	using Report = std::function<void(const Marker&)>;
+	// Called every s_ProgressStride segments. Returning false stops the search, e.g. once the job is cancelled
+	using Progress = std::function<bool()>;
+
+	static constexpr size_t s_ProgressStride = 4096;
+
+	// Brackets sign changes of y between neighbour points and refines them
+	// with bisection for expression-backed curves and linear interpolation otherwise
+	void FindRoots(const Curve& curve, size_t index, float xMin, float xMax, const Report& report, const Progress& progress = nullptr);
+	// Brackets slope sign changes and refines them
+	// with golden-section search for expression-backed curves and parabolic interpolation otherwise
+	void FindExtrema(const Curve& curve, size_t index, float xMin, float xMax, const Report& report, const Progress& progress = nullptr);
+	// Finds pairwise intersections between segments of different curves with a sweep line over x.
+	// Segments are sorted by their left end and only segments, that overlap along x, are tested against each other
+	void FindIntersections(const std::vector<Curve>& curves, float xMin, float xMax, const Report& report, const Progress& progress = nullptr);
+}
+
+/**
+ * 	Analyzer runs analysis of curve snapshots on a background thread.
+ *
+ * 	Markers are reported as soon as they are found, the render thread takes them with Poll() once per frame
+ * 	and is never blocked for longer than moving the markers out of a mutex-protected array.
+ * 	Found markers are published every Analysis::s_ProgressStride segments, that is also where jobs check if they were cancelled.
+ *
+ * 	Starting a new job cancels the previous one. Cancelled jobs are never waited for, they are joined once they finish
+ * 	by a later Start() or by the destructor, and markers, that they find after cancellation, are dropped
+ */
+class Analyzer
+{
+public:
+	struct Options
+	{
+		bool roots = true;
+		bool extrema = true;
+		bool intersections = true;
+	};
+public:
+	Analyzer() = default;
+	Analyzer(const Analyzer&) = delete;
+	Analyzer& operator=(const Analyzer&) = delete;
+	// Destructor cancels and joins all jobs
+	~Analyzer();
+
+	// Starts analysis of curves in range [xMin; xMax] of x
+	void Start(std::vector<Analysis::Curve>&& curves, float xMin, float xMax, Options options);
+	// Requests the job to stop. Doesn't wait for it
+	void Cancel();
+	// Moves all markers, that were found since the last call, to the end of markers. Returns their amount
+	size_t Poll(std::vector<Analysis::Marker>& markers);
+
+	inline bool IsRunning() const
+	{
+		return !m_Jobs.empty() && !m_Jobs.back()->isFinished.load(std::memory_order_acquire)
+			&& !m_Jobs.back()->isCancelled.load(std::memory_order_acquire);
+	}
+private:
+	struct Job
+	{
+		std::thread thread;
+		std::atomic<bool> isCancelled = false;
+		std::atomic<bool> isFinished = false;
+	};
+
+	void Run(Job& job, std::vector<Analysis::Curve> curves, float xMin, float xMax, Options options);
+	// Joins jobs, that have finished, so that joining never waits
+	void JoinFinished();
+private:
+	// the last job is the current one, the rest are cancelled and may still be running
+	std::vector<std::unique_ptr<Job>> m_Jobs;
+
+	std::mutex m_Mutex;
+	std::vector<Analysis::Marker> m_Found;
+};
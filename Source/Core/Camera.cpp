@@ -31,3 +31,31 @@ bool Camera::IsVisible(Object& object)
 {
 	return (this->aabb.CollideWith(object.GetAABB()));
 }
+
+
+AABB Camera::LocalAABB(const Object& object) const
+{
+	const sol::Affine2f inverse = sol::Inverse(object.ModelMat());
+	sol::Vec2f min = sol::Vec2f(std::numeric_limits<float>::max());
+	sol::Vec2f max = sol::Vec2f(std::numeric_limits<float>::lowest());
+	for (const Vertex* corner : { &aabb.p1, &aabb.max, &aabb.p3, &aabb.min })
+	{
+		sol::Vec2f p = inverse * corner->position;
+		min = sol::Vec2f(std::min(min.x, p.x), std::min(min.y, p.y));
+		max = sol::Vec2f(std::max(max.x, p.x), std::max(max.y, p.y));
+	}
+	return AABB::Create(min, max);
+}
+
+std::pair<size_t, size_t> Camera::VisibleRange(const Object& object) const
+{
+	const std::vector<Vertex>& vertices = object.Vertices();
+	AABB view = this->LocalAABB(object);
+	size_t first = std::lower_bound(vertices.begin(), vertices.end(), view.min.position.x
+		, [](const Vertex& vertex, float x) { return vertex.position.x < x; }) - vertices.begin();
+	size_t last = std::upper_bound(vertices.begin() + first, vertices.end(), view.max.position.x
+		, [](float x, const Vertex& vertex) { return x < vertex.position.x; }) - vertices.begin();
+	first = first > 0 ? first - 1 : first;
+	last = std::min(vertices.size(), last + 1);
+	return { first, last };
+}
@@ -16,6 +16,13 @@ public:
 	// Checks whether an object is visible in camera. Should be used for object culling
 	// to avoid redundant renderer drawcalls
 	bool IsVisible(Object& object);
+	// Returns camera's AABB in object's local space, i.e. before object's scale, rotation and translation are applied
+	AABB LocalAABB(const Object& object) const;
+	// Returns range [first; last) of vertices of an x-sorted object, that may be visible, found with binary search.
+	// One neighbour on each side is included, so that lines entering the view from its edges are not cut
+	std::pair<size_t, size_t> VisibleRange(const Object& object) const;
+	// Returns how many screen pixels one world unit takes along x axis
+	inline float PixelsPerUnit() const { return viewport.x / (2.0f * xRenderBorder); }
 
 	// Camera's data
 	float fov;
@@ -28,6 +35,8 @@ public:
 	float yRenderBorder;
 
 	sol::Vec3f offset;
+	// Size of the framebuffer, the camera renders to, in pixels
+	sol::Vec2f viewport = sol::Vec2f(1.0f);
 
 	AABB aabb;
 };
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include <Core/ChannelSeries.h>
+
+ChannelSeries::ChannelSeries(std::unique_ptr<SharedChannel> channel, sol::Vec4f color)
+: StreamingSeries(color), m_Channel(std::move(channel))
+{
+}
+
+void ChannelSeries::Update(Object& object, const Camera& camera)
+{
+	// at most one ring of points is drained, so a fast producer can't stall the frame
+	Batch batch;
+	size_t count = m_Channel->Read(batch);
+	if (count > 0)
+	{
+		m_Received += count;
+		this->Push(std::move(batch));
+	}
+	StreamingSeries::Update(object, camera);
+}
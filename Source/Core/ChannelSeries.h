@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <Core/StreamingSeries.h>
+#include <Utility/SharedChannel.h>
+
+/**
+ * 	ChannelSeries is a StreamingSeries, that is fed by another process through a SharedChannel
+ *
+ * 	Each frame Update() drains all points, that the producer process has written to the channel since the last frame,
+ * 	and pushes them as a single batch, so the points take the same path as points of in-process producers.
+ * 	Draining is a copy out of the ring, the render thread never waits for the producer.
+ * 	For more information about the channel @see @ref <Utility/SharedChannel.h>
+ */
+class ChannelSeries : public StreamingSeries
+{
+public:
+	ChannelSeries(std::unique_ptr<SharedChannel> channel, sol::Vec4f color);
+
+	// Drains the channel, then uploads new points as StreamingSeries does
+	void Update(Object& object, const Camera& camera) override;
+
+	inline const SharedChannel& Channel() const { return *m_Channel; }
+	// points, that were drained from the channel
+	inline size_t Received() const { return m_Received; }
+private:
+	std::unique_ptr<SharedChannel> m_Channel;
+	size_t m_Received = 0;
+};
@@ -0,0 +1,173 @@
+#include <Core/Curve.h>
+#include <Core/Camera.h>
+#include <Core/Object.h>
+#include <Utility/Parallel.h>
+
+#include <mutex>
+
+// amount of points, that are processed by a single thread at least
+static constexpr size_t s_SampleGrain = 4096;
+
+static bool IsFinite(const sol::Vec2f& p)
+{
+	return std::isfinite(p.x) && std::isfinite(p.y);
+}
+
+Curve::Curve(float tMin, float tMax, sol::Vec4f color)
+: m_TMin(tMin), m_TMax(tMax), m_Color(color)
+{
+}
+
+void Curve::Update(Object& object, const Camera& camera)
+{
+	float pixelsPerUnit = camera.PixelsPerUnit();
+	float ratio = pixelsPerUnit / m_SampledPixelsPerUnit;
+	if (m_SampledPixelsPerUnit == 0.0f || ratio < 0.8f || ratio > 1.25f)
+	{
+		this->Sample(object, pixelsPerUnit);
+	}
+}
+
+void Curve::Sample(Object& object, float pixelsPerUnit)
+{
+	m_SampledPixelsPerUnit = pixelsPerUnit;
+
+	const size_t pilotCount = std::max<size_t>(m_PilotSamples, 3);
+	const float dt = (m_TMax - m_TMin) / (pilotCount - 1);
+	m_Pilot.resize(pilotCount);
+	m_Weights.resize(pilotCount);
+
+	// Pilot pass. Uniform in t
+	Parallel::For(pilotCount, s_SampleGrain, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			m_Pilot[i] = this->Evaluate(m_TMin + i * dt);
+		}
+	});
+
+	// Interval i lies between pilot points i and i + 1. Its weight is stored in m_Weights[i + 1],
+	// so that m_Weights becomes a prefix sum of weights after accumulation
+	const float lengthScale = pixelsPerUnit / m_Spacing;
+	m_Weights[0] = 0.0f;
+	Parallel::For(pilotCount - 1, s_SampleGrain, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			const sol::Vec2f& a = m_Pilot[i];
+			const sol::Vec2f& b = m_Pilot[i + 1];
+			if (!IsFinite(a) || !IsFinite(b))
+			{
+				m_Weights[i + 1] = 0.0f;
+				continue;
+			}
+			float dx = b.x - a.x;
+			float dy = b.y - a.y;
+			float weight = std::sqrt(dx * dx + dy * dy) * lengthScale;
+
+			// Half of the turning angle at each end of the interval is assigned to it
+			float turn = 0.0f;
+			if (i > 0 && IsFinite(m_Pilot[i - 1]))
+			{
+				float px = a.x - m_Pilot[i - 1].x, py = a.y - m_Pilot[i - 1].y;
+				turn += std::abs(std::atan2(px * dy - py * dx, px * dx + py * dy));
+			}
+			if (i + 2 < pilotCount && IsFinite(m_Pilot[i + 2]))
+			{
+				float nx = m_Pilot[i + 2].x - b.x, ny = m_Pilot[i + 2].y - b.y;
+				turn += std::abs(std::atan2(dx * ny - dy * nx, dx * nx + dy * ny));
+			}
+			m_Weights[i + 1] = weight + 0.5f * turn / m_AngleTolerance;
+		}
+	});
+	for (size_t i = 1; i < pilotCount; i++)
+	{
+		m_Weights[i] += m_Weights[i - 1];
+	}
+
+	const float totalWeight = m_Weights.back();
+	size_t count = static_cast<size_t>(std::ceil(totalWeight)) + 1;
+	count = std::clamp(count, m_MinSamples, m_MaxSamples);
+
+	// Final pass. Points are written directly to the object's storage
+	std::vector<Vertex>& vertices = object.Vertices();
+	vertices.resize(count);
+
+	std::mutex boundsMutex;
+	sol::Vec2f min = sol::Vec2f(std::numeric_limits<float>::max());
+	sol::Vec2f max = sol::Vec2f(std::numeric_limits<float>::lowest());
+
+	Parallel::For(count, s_SampleGrain, [&](size_t begin, size_t end)
+	{
+		sol::Vec2f localMin = sol::Vec2f(std::numeric_limits<float>::max());
+		sol::Vec2f localMax = sol::Vec2f(std::numeric_limits<float>::lowest());
+		for (size_t j = begin; j < end; j++)
+		{
+			float t;
+			if (totalWeight > 0.0f)
+			{
+				float target = totalWeight * j / (count - 1);
+				size_t i = std::upper_bound(m_Weights.begin(), m_Weights.end(), target) - m_Weights.begin();
+				i = std::clamp<size_t>(i, 1, pilotCount - 1) - 1;
+				float width = m_Weights[i + 1] - m_Weights[i];
+				float fraction = width > 0.0f ? std::min(1.0f, (target - m_Weights[i]) / width) : 0.0f;
+				t = m_TMin + (i + fraction) * dt;
+			}
+			else
+			{
+				// degenerate curve, e.g. a single point. Sample it uniformly
+				t = m_TMin + (m_TMax - m_TMin) * j / (count - 1);
+			}
+
+			sol::Vec2f p = this->Evaluate(t);
+			vertices[j] = Vertex(p, m_Color);
+			if (IsFinite(p))
+			{
+				localMin = sol::Vec2f(std::min(localMin.x, p.x), std::min(localMin.y, p.y));
+				localMax = sol::Vec2f(std::max(localMax.x, p.x), std::max(localMax.y, p.y));
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(boundsMutex);
+		min = sol::Vec2f(std::min(min.x, localMin.x), std::min(min.y, localMin.y));
+		max = sol::Vec2f(std::max(max.x, localMax.x), std::max(max.y, localMax.y));
+	});
+
+	if (min.x > max.x)
+	{
+		// no finite points at all
+		min = max = sol::Vec2f(0.0f);
+	}
+	object.SetAABB(AABB::Create(min, max));
+}
+
+ParametricCurve::ParametricCurve(Function x, Function y, float tMin, float tMax, sol::Vec4f color)
+: Curve(tMin, tMax, color), m_X(std::move(x)), m_Y(std::move(y))
+{
+}
+
+sol::Vec2f ParametricCurve::Evaluate(float t) const
+{
+	return sol::Vec2f(m_X(t), m_Y(t));
+}
+
+std::shared_ptr<Series> ParametricCurve::Clone() const
+{
+	return std::make_shared<ParametricCurve>(*this);
+}
+
+PolarCurve::PolarCurve(Function r, float thetaMin, float thetaMax, sol::Vec4f color)
+: Curve(thetaMin, thetaMax, color), m_R(std::move(r))
+{
+}
+
+sol::Vec2f PolarCurve::Evaluate(float theta) const
+{
+	float r = m_R(theta);
+	return sol::Vec2f(r * std::cos(theta), r * std::sin(theta));
+}
+
+std::shared_ptr<Series> PolarCurve::Clone() const
+{
+	return std::make_shared<PolarCurve>(*this);
+}
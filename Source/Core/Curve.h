@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <Core/Series.h>
+#include <Utility/Vertex.h>
+
+/**
+ * 	Curve is a Series, that generates vertices of a continuous curve p(t), t in [tMin; tMax]
+ *
+ * 	Points are distributed by screen-space arc length and curvature rather than uniformly in t.
+ * 	Sampling is done in two passes:
+ * 	-	a pilot pass evaluates the curve on a uniform grid and computes per-interval weights,
+ * 		that are the length of the interval in pixels divided by the desired spacing plus
+ * 		the turning angle divided by the angle tolerance;
+ * 	-	the final pass places points at equal steps of accumulated weight directly into the object's vertex array
+ * 	Both passes run chunked in parallel over the t-range, so Evaluate() must be safe to call concurrently
+ *
+ * 	The object is resampled only when the camera zoom changes noticeably, as the whole t-range is sampled
+ * 	and the result does not depend on the camera offset. AABB is computed during sampling, so the object is
+ * 	culled and collided as any other object.
+ * 	The zoom of the last sampling belongs to the object, so copies of the object get copies of the curve
+ */
+class Curve : public Series
+{
+public:
+	Curve(float tMin, float tMax, sol::Vec4f color);
+	virtual ~Curve() = default;
+
+	// returns the point of the curve at parameter t
+	virtual sol::Vec2f Evaluate(float t) const = 0;
+
+	// resamples the object if the camera zoom changed more than by 25% since the last sampling
+	void Update(Object& object, const Camera& camera) override;
+	// samples the whole t-range into the object's vertex array and updates its AABB
+	void Sample(Object& object, float pixelsPerUnit);
+	// forces the curve to be resampled on the next update
+	inline void Invalidate() { m_SampledPixelsPerUnit = 0.0f; }
+
+	// Getters and setters
+	inline float TMin() const { return m_TMin; }
+	inline float TMax() const { return m_TMax; }
+	inline void SetRange(float tMin, float tMax) { m_TMin = tMin; m_TMax = tMax; Invalidate(); }
+	inline const sol::Vec4f& Color() const { return m_Color; }
+	inline void SetColor(const sol::Vec4f& color) { m_Color = color; Invalidate(); }
+	// desired distance between two neighbour points in pixels
+	inline float Spacing() const { return m_Spacing; }
+	inline void SetSpacing(float spacing) { m_Spacing = spacing; Invalidate(); }
+	// desired maximum turning angle between two neighbour segments in radians
+	inline float AngleTolerance() const { return m_AngleTolerance; }
+	inline void SetAngleTolerance(float tolerance) { m_AngleTolerance = tolerance; Invalidate(); }
+	inline size_t MaxSamples() const { return m_MaxSamples; }
+	inline void SetMaxSamples(size_t samples) { m_MaxSamples = samples; Invalidate(); }
+private:
+	float m_TMin;
+	float m_TMax;
+	sol::Vec4f m_Color;
+
+	float m_Spacing = 2.0f;
+	float m_AngleTolerance = 0.05f;
+	size_t m_PilotSamples = 4096;
+	size_t m_MinSamples = 64;
+	size_t m_MaxSamples = 1 << 20;
+
+	float m_SampledPixelsPerUnit = 0.0f;
+
+	// pilot pass storage is kept between resamplings to avoid reallocations
+	std::vector<sol::Vec2f> m_Pilot;
+	std::vector<float> m_Weights;
+};
+
+/**
+ * 	ParametricCurve represents a curve (x(t), y(t))
+ */
+class ParametricCurve : public Curve
+{
+public:
+	using Function = std::function<float(float)>;
+public:
+	ParametricCurve(Function x, Function y, float tMin, float tMax, sol::Vec4f color);
+
+	sol::Vec2f Evaluate(float t) const override;
+	std::shared_ptr<Series> Clone() const override;
+private:
+	Function m_X;
+	Function m_Y;
+};
+
+/**
+ * 	PolarCurve represents a curve r(theta), that is (r(theta) * cos(theta), r(theta) * sin(theta))
+ */
+class PolarCurve : public Curve
+{
+public:
+	using Function = std::function<float(float)>;
+public:
+	PolarCurve(Function r, float thetaMin, float thetaMax, sol::Vec4f color);
+
+	sol::Vec2f Evaluate(float theta) const override;
+	std::shared_ptr<Series> Clone() const override;
+private:
+	Function m_R;
+};
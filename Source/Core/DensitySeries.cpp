@@ -0,0 +1,158 @@
+#include <Core/DensitySeries.h>
+#include <Core/Camera.h>
+#include <Core/Object.h>
+
+#include <chrono>
+
+// attribute locations of Data/Density.vert
+static constexpr unsigned int s_PositionAttribute = 0;
+static constexpr unsigned int s_TexCoordAttribute = 3;
+
+DensitySeries::DensitySeries(std::vector<sol::Vec2f>&& points)
+: m_Points(std::move(points))
+{
+	sol::Vec2f min = sol::Vec2f(std::numeric_limits<float>::max());
+	sol::Vec2f max = sol::Vec2f(std::numeric_limits<float>::lowest());
+	for (const sol::Vec2f& p : m_Points)
+	{
+		min = sol::Vec2f(std::min(min.x, p.x), std::min(min.y, p.y));
+		max = sol::Vec2f(std::max(max.x, p.x), std::max(max.y, p.y));
+	}
+	if (min.x > max.x)
+	{
+		min = max = sol::Vec2f(0.0f);
+	}
+	m_AABB = AABB::Create(min, max);
+}
+
+DensitySeries::~DensitySeries()
+{
+	if (m_VAO)
+	{
+		glDeleteTextures(1, &m_Texture);
+		glDeleteVertexArrays(1, &m_VAO);
+		glDeleteBuffers(1, &m_VBO);
+	}
+}
+
+void DensitySeries::Update(Object& object, const Camera& camera)
+{
+	object.SetAABB(m_AABB);
+	if (!m_VAO)
+	{
+		this->CreateStorage();
+	}
+
+	AABB view = camera.LocalAABB(object);
+	sol::Vec2f viewMin = view.min.position, viewMax = view.max.position;
+	sol::Vec2f viewSize = sol::Vec2f(viewMax.x - viewMin.x, viewMax.y - viewMin.y);
+	if (!(viewSize.x > 0.0f && viewSize.y > 0.0f))
+	{
+		return;
+	}
+
+	// the smallest power of two bin size, that is at least s_PixelsPerBin pixels
+	sol::Vec2f binSize;
+	binSize.x = std::exp2(std::ceil(std::log2(viewSize.x * s_PixelsPerBin / std::max(camera.viewport.x, 1.0f))));
+	binSize.y = std::exp2(std::ceil(std::log2(viewSize.y * s_PixelsPerBin / std::max(camera.viewport.y, 1.0f))));
+
+	// The binned grid is kept, while it has the same bin size and still covers the view
+	const Histogram2D::Grid& binned = m_Histogram.GetGrid();
+	if (m_Rebins > 0 && binned.binSize.x == binSize.x && binned.binSize.y == binSize.y
+		&& binned.origin.x <= viewMin.x && binned.origin.x + binned.columns * binSize.x >= viewMax.x
+		&& binned.origin.y <= viewMin.y && binned.origin.y + binned.rows * binSize.y >= viewMax.y)
+	{
+		return;
+	}
+
+	// The new grid covers the view with a margin of the view's size on each side, so that panning rebins rarely
+	Histogram2D::Grid grid;
+	grid.binSize = binSize;
+	float firstColumn = std::floor((viewMin.x - viewSize.x) / binSize.x);
+	float firstRow = std::floor((viewMin.y - viewSize.y) / binSize.y);
+	grid.origin = sol::Vec2f(firstColumn * binSize.x, firstRow * binSize.y);
+	grid.columns = static_cast<size_t>(std::ceil((viewMax.x + viewSize.x) / binSize.x) - firstColumn);
+	grid.rows = static_cast<size_t>(std::ceil((viewMax.y + viewSize.y) / binSize.y) - firstRow);
+
+	// Bins are at least s_PixelsPerBin pixels, so the grid is smaller than three viewports along each axis,
+	// unless the view is degenerate, e.g. the object is scaled to zero
+	if (grid.Bins() > static_cast<size_t>((3.0f * camera.viewport.x + 4.0f) * (3.0f * camera.viewport.y + 4.0f)) || grid == binned)
+	{
+		return;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	m_Histogram.Bin(m_Points.data(), m_Points.size(), grid);
+	m_BinSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	m_Rebins++;
+	this->Upload();
+}
+
+bool DensitySeries::Draw(const Object& object, unsigned int renderMode)
+{
+	if (m_Rebins == 0)
+	{
+		return true;
+	}
+	glBindTextureUnit(0, m_Texture);
+	glBindVertexArray(m_VAO);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	return true;
+}
+
+void DensitySeries::CreateStorage()
+{
+	// the quad is 4 vertices of position and texture coordinate
+	glCreateBuffers(1, &m_VBO);
+	glNamedBufferData(m_VBO, 16 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+	glCreateVertexArrays(1, &m_VAO);
+	glEnableVertexArrayAttrib(m_VAO, s_PositionAttribute);
+	glVertexArrayAttribFormat(m_VAO, s_PositionAttribute, 2, GL_FLOAT, GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_VAO, s_PositionAttribute, 0);
+	glEnableVertexArrayAttrib(m_VAO, s_TexCoordAttribute);
+	glVertexArrayAttribFormat(m_VAO, s_TexCoordAttribute, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float));
+	glVertexArrayAttribBinding(m_VAO, s_TexCoordAttribute, 0);
+	glVertexArrayVertexBuffer(m_VAO, 0, m_VBO, 0, 4 * sizeof(float));
+}
+
+void DensitySeries::Upload()
+{
+	const Histogram2D::Grid& grid = m_Histogram.GetGrid();
+	if (grid.columns != m_TextureColumns || grid.rows != m_TextureRows)
+	{
+		// immutable storage can't be resized, so the texture is recreated
+		if (m_Texture)
+		{
+			glDeleteTextures(1, &m_Texture);
+		}
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_Texture);
+		glTextureStorage2D(m_Texture, 1, GL_R32F, grid.columns, grid.rows);
+		glTextureParameteri(m_Texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTextureParameteri(m_Texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		m_TextureColumns = grid.columns;
+		m_TextureRows = grid.rows;
+	}
+
+	// counts are normalized on upload, so the shader needs no uniforms besides the matrices
+	const std::vector<uint32_t>& counts = m_Histogram.Counts();
+	m_Texels.resize(counts.size());
+	float scale = m_Histogram.MaxCount() > 0 ? 1.0f / std::log1p(static_cast<float>(m_Histogram.MaxCount())) : 0.0f;
+	for (size_t i = 0; i < counts.size(); i++)
+	{
+		m_Texels[i] = std::log1p(static_cast<float>(counts[i])) * scale;
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTextureSubImage2D(m_Texture, 0, 0, 0, grid.columns, grid.rows, GL_RED, GL_FLOAT, m_Texels.data());
+
+	float x0 = grid.origin.x, y0 = grid.origin.y;
+	float x1 = x0 + grid.columns * grid.binSize.x, y1 = y0 + grid.rows * grid.binSize.y;
+	float quad[16] = {
+		x0, y0, 0.0f, 0.0f,
+		x1, y0, 1.0f, 0.0f,
+		x0, y1, 0.0f, 1.0f,
+		x1, y1, 1.0f, 1.0f,
+	};
+	glNamedBufferSubData(m_VBO, 0, sizeof(quad), quad);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <Core/Series.h>
+#include <Utility/AABB.h>
+#include <Utility/Histogram2D.h>
+
+/**
+ * 	DensitySeries is a Series, that draws a large scatter as a density plot instead of individual points
+ *
+ * 	Points are counted in a 2D histogram over the visible region, which is uploaded as a texture
+ * 	and drawn as a single quad, that the "Density" shader colors with a colormap. Counts are scaled logarithmically,
+ * 	so both sparse and dense regions are visible. Empty bins are transparent.
+ *
+ * 	Bins are matched to the viewport resolution: their size is the smallest power of two, that is at least
+ * 	s_PixelsPerBin pixels, and the grid is aligned to multiples of the bin size.
+ * 	The histogram covers the view with a margin of the view's size on each side, and points are rebinned
+ * 	only when the bin size changes, i.e. zooming by an octave, or the view leaves the binned region,
+ * 	i.e. panning by a whole view. Thus panning and zooming within an octave don't rebin on each frame.
+ *
+ * 	Binning is parallel, @see @ref <Utility/Histogram2D.h>
+ * 	Objects with this series must use a material with "Density" shader and GL_TRIANGLE_STRIP render mode
+ */
+class DensitySeries : public Series
+{
+public:
+	static constexpr float s_PixelsPerBin = 2.0f;
+public:
+	DensitySeries(std::vector<sol::Vec2f>&& points);
+	DensitySeries(const DensitySeries&) = delete;
+	DensitySeries& operator=(const DensitySeries&) = delete;
+	// Deletes the texture, VAO and VBO
+	~DensitySeries();
+
+	// Rebins points if the bin size changes or the view leaves the binned grid
+	void Update(Object& object, const Camera& camera) override;
+	// Draws the histogram quad
+	bool Draw(const Object& object, unsigned int renderMode) override;
+
+	inline const std::vector<sol::Vec2f>& Points() const { return m_Points; }
+	inline const Histogram2D& Histogram() const { return m_Histogram; }
+	inline const AABB& GetAABB() const { return m_AABB; }
+	inline size_t Rebins() const { return m_Rebins; }
+	// duration of the last binning in seconds
+	inline double BinSeconds() const { return m_BinSeconds; }
+private:
+	// creates OpenGL objects on the first update, as the series may be created before the context
+	void CreateStorage();
+	// uploads log-scaled counts and the quad, that covers the grid
+	void Upload();
+private:
+	std::vector<sol::Vec2f> m_Points;
+	AABB m_AABB;
+	Histogram2D m_Histogram;
+	size_t m_Rebins = 0;
+	double m_BinSeconds = 0.0;
+
+	// normalized counts, that are uploaded to the texture
+	std::vector<float> m_Texels;
+	size_t m_TextureColumns = 0;
+	size_t m_TextureRows = 0;
+
+	unsigned int m_Texture = 0;
+	unsigned int m_VAO = 0;
+	unsigned int m_VBO = 0;
+};
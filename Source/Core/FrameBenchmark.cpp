@@ -0,0 +1,193 @@
+#include <Core/FrameBenchmark.h>
+#include <Core/Offscreen.h>
+#include <Renderer.h>
+#include <Utility/Profiler.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <iomanip>
+#include <stdexcept>
+#include <algorithm>
+#include <GL/glew.h>
+
+// Side of the grid cell, that an object is generated in
+static constexpr float s_CellSize = 2.0f;
+
+static void LoadSyntheticScene(ObjectHandler& handler, const FrameBenchmark::Options& options)
+{
+	Material* material = handler.FindMaterial("Basic_Line_Strip");
+	if (!material)
+	{
+		throw std::runtime_error("Frame benchmark needs the Basic_Line_Strip material");
+	}
+	handler.Objects().clear();
+	handler.Objects().reserve(options.objects);
+	handler.SetCurrentIndex(-1);
+
+	std::mt19937 engine(11);
+	std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+	std::uniform_real_distribution<float> channel(0.3f, 1.0f);
+	std::uniform_real_distribution<float> percent(0.0f, 100.0f);
+	const size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(options.objects))));
+	for (size_t i = 0; i < options.objects; i++)
+	{
+		// random walk from the left to the right side of the cell. Vertices are in world space,
+		// as the camera culls objects by their AABBs without model matrices
+		std::vector<Vertex> vertices(options.vertices);
+		sol::Vec4f color(channel(engine), channel(engine), channel(engine), 1.0f);
+		const float left = (i % columns) * s_CellSize;
+		const float middle = (i / columns) * s_CellSize + 0.5f * s_CellSize;
+		float y = 0.0f;
+		for (size_t v = 0; v < options.vertices; v++)
+		{
+			y = std::clamp(y + step(engine), -0.5f * s_CellSize, 0.5f * s_CellSize);
+			vertices[v] = Vertex(left + s_CellSize * v / options.vertices, middle + y, color);
+		}
+
+		bool aabb = percent(engine) < options.aabbPercent;
+		Object object(std::move(vertices), material, aabb);
+		object.RenderAABB() = aabb;
+		object.CreateAABB();
+		handler.AddObject(std::move(object));
+	}
+}
+
+namespace FrameBenchmark
+{
+	Result Run(Offscreen& offscreen, Renderer& renderer, const Options& options)
+	{
+		if (options.frames == 0)
+		{
+			throw std::invalid_argument("Frame benchmark needs at least one frame");
+		}
+		LoadSyntheticScene(renderer.GetObjectHandler(), options);
+
+		const size_t frames = options.warmupFrames + options.frames;
+		// timestamps are taken before and after each frame, as time elapsed queries are used by the profiler of the renderer
+		std::vector<unsigned int> queries(2 * frames);
+		glGenQueries(queries.size(), queries.data());
+		std::vector<double> cpu;
+		cpu.reserve(options.frames);
+		Result result;
+
+		// the camera circles around the center of the scene and zooms in and out, so that both culling and dense frames are measured
+		const float extent = std::ceil(std::sqrt(static_cast<float>(options.objects))) * s_CellSize;
+		const sol::Vec2f center(0.5f * extent, 0.5f * extent);
+		Camera& camera = renderer.GetCamera();
+		for (size_t frame = 0; frame < frames; frame++)
+		{
+			PROFILE_ZONE("Frame");
+			float t = 2.0f * static_cast<float>(M_PI) * frame / frames;
+			camera.offset = sol::Vec3f(center.x + 0.25f * extent * std::cos(t), center.y + 0.25f * extent * std::sin(t)
+				, 3.0f + 0.5f * extent * (1.0f - std::cos(t)));
+
+			offscreen.Bind();
+			glClearColor(0.11f, 0.11f, 0.12f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			glQueryCounter(queries[2 * frame], GL_TIMESTAMP);
+			auto start = std::chrono::steady_clock::now();
+			renderer.Update();
+			double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			glQueryCounter(queries[2 * frame + 1], GL_TIMESTAMP);
+
+			if (frame < options.warmupFrames)
+			{
+				continue;
+			}
+			cpu.push_back(milliseconds);
+			const Renderer::FrameStats& stats = renderer.GetFrameStats();
+			result.drawCalls += stats.drawCalls;
+			result.uploadedBytes += stats.uploadedBytes;
+			result.visibleObjects += stats.visibleObjects;
+		}
+
+		// results of queries are waited for here, after all frames are submitted
+		std::vector<double> gpu;
+		gpu.reserve(options.frames);
+		for (size_t frame = options.warmupFrames; frame < frames; frame++)
+		{
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(queries[2 * frame], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(queries[2 * frame + 1], GL_QUERY_RESULT, &end);
+			gpu.push_back((end - begin) * 1e-6);
+		}
+		glDeleteQueries(queries.size(), queries.data());
+
+		for (const GpuProfiler::Pass& pass : renderer.GetProfiler().Passes())
+		{
+			result.passes.emplace_back(pass.name, pass.average);
+		}
+
+		result.cpu = Compute(std::move(cpu));
+		result.gpu = Compute(std::move(gpu));
+		result.drawCalls /= options.frames;
+		result.uploadedBytes /= options.frames;
+		result.visibleObjects /= options.frames;
+		result.frames = options.frames;
+		result.width = offscreen.Width();
+		result.height = offscreen.Height();
+		return result;
+	}
+
+	Percentiles Compute(std::vector<double> samples)
+	{
+		Percentiles percentiles;
+		if (samples.empty())
+		{
+			return percentiles;
+		}
+		std::sort(samples.begin(), samples.end());
+		auto rank = [&](double percent) -> double
+		{
+			size_t index = static_cast<size_t>(std::ceil(percent / 100.0 * samples.size()));
+			return samples[std::clamp<size_t>(index, 1, samples.size()) - 1];
+		};
+		percentiles.p50 = rank(50.0);
+		percentiles.p95 = rank(95.0);
+		percentiles.p99 = rank(99.0);
+		percentiles.max = samples.back();
+		for (double sample : samples)
+		{
+			percentiles.mean += sample;
+		}
+		percentiles.mean /= samples.size();
+		return percentiles;
+	}
+
+	static void PrintPercentiles(std::ostream& stream, const char* name, const Percentiles& percentiles)
+	{
+		stream << "  \"" << name << "\": { "
+			<< "\"p50\": " << percentiles.p50 << ", "
+			<< "\"p95\": " << percentiles.p95 << ", "
+			<< "\"p99\": " << percentiles.p99 << ", "
+			<< "\"mean\": " << percentiles.mean << ", "
+			<< "\"max\": " << percentiles.max << " },\n";
+	}
+
+	void PrintJSON(std::ostream& stream, const Options& options, const Result& result)
+	{
+		stream << std::setprecision(6) << std::fixed;
+		stream << "{\n"
+			<< "  \"scene\": { "
+			<< "\"objects\": " << options.objects << ", "
+			<< "\"vertices\": " << options.vertices << ", "
+			<< "\"aabb_percent\": " << options.aabbPercent << " },\n"
+			<< "  \"width\": " << result.width << ",\n"
+			<< "  \"height\": " << result.height << ",\n"
+			<< "  \"frames\": " << result.frames << ",\n";
+		PrintPercentiles(stream, "cpu_ms", result.cpu);
+		PrintPercentiles(stream, "gpu_ms", result.gpu);
+		stream << "  \"passes_gpu_ms\": { ";
+		for (size_t i = 0; i < result.passes.size(); i++)
+		{
+			stream << "\"" << result.passes[i].first << "\": " << result.passes[i].second << (i + 1 < result.passes.size() ? ", " : " ");
+		}
+		stream << "},\n";
+		stream << "  \"draw_calls\": " << result.drawCalls << ",\n"
+			<< "  \"uploaded_bytes\": " << result.uploadedBytes << ",\n"
+			<< "  \"visible_objects\": " << result.visibleObjects << "\n"
+			<< "}\n";
+	}
+};
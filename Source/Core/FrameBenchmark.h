@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <ostream>
+
+class Renderer;
+class Offscreen;
+
+/**
+ * 	Namespace, that measures frame times of the renderer on a synthetic scene, e.g. to catch regressions between versions
+ *
+ * 	The scene of the renderer is replaced by random-walk line strips, that are laid out on a square grid.
+ * 	A part of the objects renders its AABB and takes part in collision tests, which are quadratic in the amount of such objects.
+ * 	The camera follows a fixed path, i.e. it circles around the scene and zooms in and out once per run,
+ * 	so every run draws the same frames. Scenes are generated from a fixed seed for the same reason.
+ *
+ * 	CPU time of a frame is the time of Renderer::Update(), i.e. culling, uploads and submission of draw calls.
+ * 	GPU time is measured with GL_TIMESTAMP queries, that are read after the last frame, so that frames aren't serialized.
+ * 	Timestamps are used, as time elapsed queries can't nest, and the renderer measures its passes with them.
+ * 	Warm-up frames, e.g. with shader compilation and VBO growth, aren't included in the statistics.
+ * 	Results are printed as JSON with PrintJSON(). Runs in headless mode, see <Core/Offscreen.h>
+ */
+namespace FrameBenchmark
+{
+	struct Options
+	{
+		size_t objects = 1000;
+		size_t vertices = 256;
+		// percentage of objects, that render their AABB and are colliders
+		float aabbPercent = 10.0f;
+		size_t frames = 600;
+		size_t warmupFrames = 30;
+	};
+
+	struct Percentiles
+	{
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		double mean = 0.0;
+		double max = 0.0;
+	};
+
+	struct Result
+	{
+		// frame times in milliseconds
+		Percentiles cpu;
+		Percentiles gpu;
+		// per frame means of Renderer::FrameStats
+		double drawCalls = 0.0;
+		double uploadedBytes = 0.0;
+		double visibleObjects = 0.0;
+		// average GPU time of passes of the renderer over the latest frames, see <Core/GpuProfiler.h>
+		std::vector<std::pair<std::string, double>> passes;
+		size_t frames = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+	// Replaces the scene of the renderer with a synthetic one and renders the camera path into the offscreen framebuffer
+	Result Run(Offscreen& offscreen, Renderer& renderer, const Options& options);
+	// Nearest-rank percentiles of the samples
+	Percentiles Compute(std::vector<double> samples);
+	void PrintJSON(std::ostream& stream, const Options& options, const Result& result);
+};
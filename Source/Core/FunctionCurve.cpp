@@ -0,0 +1,189 @@
+#include <Core/FunctionCurve.h>
+#include <Core/Camera.h>
+#include <Core/Object.h>
+#include <Utility/Parallel.h>
+
+// visible strip is never assembled from more tiles than this, e.g. when the object is scaled down to zero
+static constexpr long long s_MaxVisibleTiles = 4096;
+
+FunctionCurve::FunctionCurve(Function function, sol::Vec4f color, size_t cacheBudget)
+: m_Function(std::move(function)), m_Color(color), m_Cache(cacheBudget)
+{
+}
+
+FunctionCurve::FunctionCurve(Function function, IntervalFunction intervalFunction, sol::Vec4f color, size_t cacheBudget)
+: m_Function(std::move(function)), m_IntervalFunction(std::move(intervalFunction)), m_Color(color), m_Cache(cacheBudget)
+{
+}
+
+std::shared_ptr<Series> FunctionCurve::Clone() const
+{
+	std::shared_ptr<FunctionCurve> clone = std::make_shared<FunctionCurve>(m_Function, m_IntervalFunction, m_Color, m_Cache.Budget());
+	clone->m_Spacing = m_Spacing;
+	return clone;
+}
+
+void FunctionCurve::Invalidate()
+{
+	m_Cache.Clear();
+	m_IsValid = false;
+}
+
+std::vector<float> FunctionCurve::EvaluateTile(const SampleCache::Key& key) const
+{
+	std::vector<float> samples(SampleCache::TileSamples + 1);
+	for (size_t k = 0; k < samples.size(); k++)
+	{
+		samples[k] = m_Function(static_cast<float>(SampleCache::SampleX(key, k)));
+	}
+	return samples;
+}
+
+void FunctionCurve::Update(Object& object, const Camera& camera)
+{
+	AABB view = camera.LocalAABB(object);
+	float pixelsPerUnit = camera.PixelsPerUnit() * std::abs(object.Scale().x);
+
+	// the finest level, which spacing is still not less than desired
+	double spacing = m_Spacing / pixelsPerUnit;
+	int level = std::clamp(static_cast<int>(std::floor(std::log2(spacing))), -60, 60);
+	double width = SampleCache::TileWidth(level);
+	long long first = static_cast<long long>(std::floor(view.min.position.x / width));
+	long long last = static_cast<long long>(std::floor(view.max.position.x / width));
+	last = std::min(last, first + s_MaxVisibleTiles - 1);
+
+	bool sameTiles = m_IsValid && level == m_Level && first == m_FirstTile && last == m_LastTile;
+	bool insideRejection = view.min.position.y >= m_RejectMin && view.max.position.y <= m_RejectMax;
+	if (sameTiles && (!this->HasIntervalFunction() || insideRejection))
+	{
+		return;
+	}
+	m_IsValid = true;
+	m_Level = level;
+	m_FirstTile = first;
+	m_LastTile = last;
+	float height = view.max.position.y - view.min.position.y;
+	m_RejectMin = view.min.position.y - height;
+	m_RejectMax = view.max.position.y + height;
+
+	// Bound each tile with interval arithmetic. Rejected tiles provably lie outside the view
+	// and are not sampled, discontinuous tiles are additionally checked for line breaks
+	enum class TileState { Sampled, Rejected, Discontinuous };
+	std::vector<TileState> states(last - first + 1, TileState::Sampled);
+	if (this->HasIntervalFunction())
+	{
+		for (long long index = first; index <= last; index++)
+		{
+			SampleCache::Key key = { level, index };
+			sol::Interval x = sol::Interval(static_cast<float>(SampleCache::SampleX(key, 0))
+				, static_cast<float>(SampleCache::SampleX(key, SampleCache::TileSamples)));
+			sol::Interval y = this->Evaluate(x);
+			if (y.discontinuous)
+			{
+				states[index - first] = TileState::Discontinuous;
+			}
+			else if (!y.Overlaps(m_RejectMin, m_RejectMax))
+			{
+				states[index - first] = TileState::Rejected;
+			}
+		}
+	}
+
+	// Evaluate missing tiles in parallel before the strip is assembled
+	std::vector<SampleCache::Key> missing;
+	for (long long index = first; index <= last; index++)
+	{
+		SampleCache::Key key = { level, index };
+		if (states[index - first] != TileState::Rejected && !m_Cache.Contains(key))
+		{
+			missing.push_back(key);
+		}
+	}
+	std::vector<std::vector<float>> evaluated(missing.size());
+	Parallel::For(missing.size(), 4, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			evaluated[i] = this->EvaluateTile(missing[i]);
+		}
+	});
+
+	std::vector<Vertex>& vertices = object.Vertices();
+	vertices.clear();
+	vertices.reserve((last - first + 1) * SampleCache::TileSamples + 1);
+
+	float yMin = std::numeric_limits<float>::max();
+	float yMax = std::numeric_limits<float>::lowest();
+	auto emit = [&](float x, float y)
+	{
+		vertices.emplace_back(x, y, m_Color);
+		if (std::isfinite(y))
+		{
+			yMin = std::min(yMin, y);
+			yMax = std::max(yMax, y);
+		}
+	};
+
+	m_RejectedTiles = 0;
+	m_Breaks = 0;
+	size_t next = 0;
+	for (long long index = first; index <= last; index++)
+	{
+		SampleCache::Key key = { level, index };
+		TileState state = states[index - first];
+		if (state == TileState::Rejected)
+		{
+			// The whole tile is outside the view, so a straight line between its end points is outside too
+			m_RejectedTiles++;
+			for (size_t k : { size_t(0), SampleCache::TileSamples })
+			{
+				if (k == 0 || index == last)
+				{
+					float x = static_cast<float>(SampleCache::SampleX(key, k));
+					emit(x, m_Function(x));
+				}
+			}
+			continue;
+		}
+
+		const std::vector<float>* samples = m_Cache.Find(key);
+		if (!samples)
+		{
+			if (next < missing.size() && missing[next] == key)
+			{
+				samples = &m_Cache.Insert(key, std::move(evaluated[next++]));
+			}
+			else
+			{
+				// the tile was cached, but has been evicted while the strip was assembled
+				samples = &m_Cache.Insert(key, this->EvaluateTile(key));
+			}
+		}
+
+		// the last sample of a tile is the first sample of the next one
+		size_t count = index == last ? samples->size() : samples->size() - 1;
+		for (size_t k = 0; k < count; k++)
+		{
+			float x = static_cast<float>(SampleCache::SampleX(key, k));
+			emit(x, (*samples)[k]);
+			if (state == TileState::Discontinuous && k < SampleCache::TileSamples)
+			{
+				float xNext = static_cast<float>(SampleCache::SampleX(key, k + 1));
+				if (this->Evaluate(sol::Interval(x, xNext)).discontinuous)
+				{
+					// NaN vertex breaks the line strip
+					m_Breaks++;
+					vertices.emplace_back(std::nanf(""), std::nanf(""), m_Color);
+				}
+			}
+		}
+	}
+
+	if (yMin > yMax)
+	{
+		yMin = yMax = 0.0f;
+	}
+	sol::Vec2f min = sol::Vec2f(static_cast<float>(SampleCache::SampleX({ level, first }, 0)), yMin);
+	sol::Vec2f max = sol::Vec2f(static_cast<float>(SampleCache::SampleX({ level, last }, SampleCache::TileSamples)), yMax);
+	object.SetAABB(AABB::Create(min, max));
+}
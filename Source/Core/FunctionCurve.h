@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Core/Series.h>
+#include <Core/SampleCache.h>
+#include <Utility/Vertex.h>
+#include <Utility/Interval.h>
+
+/**
+ * 	FunctionCurve is a Series, that plots a function y = f(x) over the visible range of x
+ *
+ * 	Evaluated samples are stored in a SampleCache. The level of the cache is chosen so that the distance between
+ * 	two samples is not bigger than Spacing() pixels. On pan and zoom the visible strip is assembled from
+ * 	cached tiles and only missing tiles are evaluated, in parallel. The object is rebuilt only when the set
+ * 	of visible tiles changes, so f must be safe to call concurrently
+ *
+ * 	Optionally the function may be given an interval extension, i.e. the same function evaluated over sol::Interval.
+ * 	Then each tile is bounded with a single interval evaluation before it is sampled:
+ * 	-	tiles, that provably lie above or below the view, are not sampled and only their end points are emitted;
+ * 	-	tiles, that may be discontinuous, are checked per sample interval and the line is broken with
+ * 		a NaN vertex where a discontinuity is possible, so that poles are not connected with vertical lines
+ * 	For a reference of writing a function once for both floats and intervals @see @ref <Utility/Interval.h>
+ */
+class FunctionCurve : public Series
+{
+public:
+	using Function = std::function<float(float)>;
+	using IntervalFunction = std::function<sol::Interval(const sol::Interval&)>;
+public:
+	FunctionCurve(Function function, sol::Vec4f color, size_t cacheBudget = 64 * 1024 * 1024);
+	FunctionCurve(Function function, IntervalFunction intervalFunction, sol::Vec4f color, size_t cacheBudget = 64 * 1024 * 1024);
+
+	// rebuilds the object's vertices if the visible range of tiles has changed
+	void Update(Object& object, const Camera& camera) override;
+	// forces the object to be rebuilt and drops all cached samples
+	void Invalidate();
+	// copies the function and the settings. The copy starts with an empty cache and rebuilds its object on the first update
+	std::shared_ptr<Series> Clone() const override;
+
+	inline float Evaluate(float x) const { return m_Function(x); }
+	inline const Function& GetFunction() const { return m_Function; }
+	inline bool HasIntervalFunction() const { return static_cast<bool>(m_IntervalFunction); }
+	// bounds f over [x.lo; x.hi]. Must only be called if the curve has an interval function
+	inline sol::Interval Evaluate(const sol::Interval& x) const { return m_IntervalFunction(x); }
+
+	// Getters and setters
+	inline SampleCache& Cache() { return m_Cache; }
+	inline const SampleCache& Cache() const { return m_Cache; }
+	inline const sol::Vec4f& Color() const { return m_Color; }
+	inline void SetColor(const sol::Vec4f& color) { m_Color = color; m_IsValid = false; }
+	// maximum distance between two neighbour samples in pixels
+	inline float Spacing() const { return m_Spacing; }
+	inline void SetSpacing(float spacing) { m_Spacing = spacing; m_IsValid = false; }
+	// amount of tiles, that were rejected by interval bounds during the last rebuild
+	inline size_t RejectedTiles() const { return m_RejectedTiles; }
+	// amount of line breaks at possible discontinuities during the last rebuild
+	inline size_t Breaks() const { return m_Breaks; }
+private:
+	std::vector<float> EvaluateTile(const SampleCache::Key& key) const;
+private:
+	Function m_Function;
+	IntervalFunction m_IntervalFunction;
+	sol::Vec4f m_Color;
+	float m_Spacing = 1.0f;
+
+	SampleCache m_Cache;
+
+	// range of tiles the object currently holds
+	bool m_IsValid = false;
+	int m_Level = 0;
+	long long m_FirstTile = 0;
+	long long m_LastTile = 0;
+	// tiles are rejected against the view expanded vertically, so that small pans don't cause rebuilds
+	float m_RejectMin = 0.0f;
+	float m_RejectMax = 0.0f;
+	size_t m_RejectedTiles = 0;
+	size_t m_Breaks = 0;
+};
@@ -0,0 +1,121 @@
+#include <Core/GpuProfiler.h>
+
+#include <cstring>
+#include <algorithm>
+#include <GL/glew.h>
+
+GpuProfiler::~GpuProfiler()
+{
+	for (Frame& frame : m_Frames)
+	{
+		if (!frame.queries.empty())
+		{
+			glDeleteQueries(frame.queries.size(), frame.queries.data());
+		}
+	}
+}
+
+void GpuProfiler::BeginFrame()
+{
+	this->End();
+	m_Frame = (m_Frame + 1) % s_Latency;
+	this->Collect(m_Frame);
+}
+
+void GpuProfiler::Begin(const char* name)
+{
+	this->End();
+	Frame& frame = m_Frames[m_Frame];
+	if (frame.used == frame.queries.size())
+	{
+		unsigned int query;
+		glGenQueries(1, &query);
+		frame.queries.push_back(query);
+		frame.passes.push_back(0);
+	}
+	frame.passes[frame.used] = this->FindPass(name);
+	glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.used]);
+	frame.used++;
+	m_IsActive = true;
+}
+
+void GpuProfiler::End()
+{
+	if (m_IsActive)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_IsActive = false;
+	}
+}
+
+void GpuProfiler::Collect(size_t index)
+{
+	Frame& frame = m_Frames[index];
+	if (frame.used == 0)
+	{
+		return;
+	}
+	// queries finish in order, so the results of the frame are available once the last one is
+	int available = 0;
+	glGetQueryObjectiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available)
+	{
+		m_Dropped++;
+		frame.used = 0;
+		return;
+	}
+
+	std::vector<double> times(m_Passes.size(), -1.0);
+	for (size_t i = 0; i < frame.used; i++)
+	{
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds);
+		double& time = times[frame.passes[i]];
+		time = std::max(time, 0.0) + nanoseconds * 1e-6;
+	}
+	frame.used = 0;
+
+	for (size_t i = 0; i < m_Passes.size(); i++)
+	{
+		if (times[i] < 0.0)
+		{
+			continue;
+		}
+		Pass& pass = m_Passes[i];
+		pass.last = static_cast<float>(times[i]);
+		if (pass.samples.size() < s_Window)
+		{
+			pass.samples.push_back(pass.last);
+		}
+		else
+		{
+			pass.samples[pass.offset] = pass.last;
+			pass.offset = (pass.offset + 1) % s_Window;
+		}
+		float sum = 0.0f;
+		pass.max = 0.0f;
+		for (float sample : pass.samples)
+		{
+			sum += sample;
+			pass.max = std::max(pass.max, sample);
+		}
+		pass.average = sum / pass.samples.size();
+	}
+}
+
+size_t GpuProfiler::FindPass(const char* name)
+{
+	// there are only a few passes, so they are compared by name each time
+	for (size_t i = 0; i < m_Passes.size(); i++)
+	{
+		if (std::strcmp(m_Passes[i].name.c_str(), name) == 0)
+		{
+			return i;
+		}
+	}
+	Pass pass;
+	pass.name = name;
+	pass.samples.reserve(s_Window);
+	m_Passes.push_back(std::move(pass));
+	return m_Passes.size() - 1;
+}
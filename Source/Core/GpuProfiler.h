@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+/**
+ * 	GpuProfiler measures GPU time of named render passes with GL_TIME_ELAPSED queries
+ *
+ * 	Passes are measured between Begin() and End(), or by a Scope object. Time elapsed queries can't nest,
+ * 	so passes don't nest either: Begin() ends the active pass. A pass may run more than once a frame, its times are summed then.
+ *
+ * 	Queries of a frame are kept in a ring of s_Latency frames. BeginFrame() reads the results of the frame,
+ * 	that was submitted s_Latency frames ago, so reading never waits for the GPU. If results of that frame
+ * 	still aren't available, they are dropped and counted, instead of stalling the frame.
+ *
+ * 	Each pass keeps a window of its s_Window latest times in milliseconds, the average and maximum of the window.
+ * 	Queries are created on demand, so a profiler may be created before the OpenGL context, but must be used on its thread
+ */
+class GpuProfiler
+{
+public:
+	struct Pass
+	{
+		std::string name;
+		// times in milliseconds
+		float last = 0.0f;
+		float average = 0.0f;
+		float max = 0.0f;
+		// window of the latest times, it is a ring and the oldest time is at offset
+		std::vector<float> samples;
+		size_t offset = 0;
+	};
+
+	// Measures the pass until the end of the scope
+	class Scope
+	{
+	public:
+		Scope(GpuProfiler& profiler, const char* name) : m_Profiler(profiler) { m_Profiler.Begin(name); }
+		~Scope() { m_Profiler.End(); }
+	private:
+		GpuProfiler& m_Profiler;
+	};
+
+	static constexpr size_t s_Latency = 4;
+	static constexpr size_t s_Window = 128;
+public:
+	GpuProfiler() = default;
+	GpuProfiler(const GpuProfiler&) = delete;
+	GpuProfiler& operator=(const GpuProfiler&) = delete;
+	// Deletes all queries, the OpenGL context must still be current
+	~GpuProfiler();
+
+	// Starts a new frame and collects results of the frame, that is s_Latency frames old
+	void BeginFrame();
+	void Begin(const char* name);
+	void End();
+
+	inline const std::vector<Pass>& Passes() const { return m_Passes; }
+	// frames, which results weren't available in time
+	inline size_t Dropped() const { return m_Dropped; }
+private:
+	// Reads the results of the frame and appends them to the windows of passes
+	void Collect(size_t frame);
+	size_t FindPass(const char* name);
+private:
+	struct Frame
+	{
+		// queries, that were created for this slot of the ring, and their passes. Only the first used queries belong to the frame
+		std::vector<unsigned int> queries;
+		std::vector<size_t> passes;
+		size_t used = 0;
+	};
+
+	std::array<Frame, s_Latency> m_Frames;
+	size_t m_Frame = 0;
+	bool m_IsActive = false;
+	std::vector<Pass> m_Passes;
+	size_t m_Dropped = 0;
+};
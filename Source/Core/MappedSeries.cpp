@@ -0,0 +1,282 @@
+#include <Core/MappedSeries.h>
+#include <Core/Camera.h>
+#include <Core/Object.h>
+#include <Utility/Parallel.h>
+
+static constexpr size_t s_None = static_cast<size_t>(-1);
+
+// attribute locations of Data/Column.vert
+static constexpr unsigned int s_XAttribute = 0;
+static constexpr unsigned int s_ColorAttribute = 1;
+static constexpr unsigned int s_YAttribute = 2;
+
+static unsigned int GLType(ColumnFile::Type type)
+{
+	return type == ColumnFile::Type::Float64 ? GL_DOUBLE : GL_FLOAT;
+}
+
+MappedSeries::MappedSeries(std::shared_ptr<const ColumnFile> file, sol::Vec4f color, size_t budget)
+: m_File(std::move(file)), m_Color(color), m_Budget(budget)
+{
+	const ColumnFile& columns = *m_File;
+	m_ChunkSlots.assign(columns.Chunks(), s_None);
+	m_Bounds.resize(columns.Chunks());
+	for (size_t chunk = 0; chunk < columns.Chunks(); chunk++)
+	{
+		m_Bounds[chunk] = columns.ChunkBounds(chunk);
+	}
+	m_Total = columns.GetBounds();
+	if (!std::isfinite(m_Total.yMin) || !std::isfinite(m_Total.yMax))
+	{
+		this->ComputeYBounds();
+	}
+}
+
+MappedSeries::~MappedSeries()
+{
+	if (m_VAO)
+	{
+		unsigned int arrays[] = { m_VAO, m_SummaryVAO };
+		unsigned int buffers[] = { m_XBuffer, m_YBuffer, m_SummaryBuffer };
+		glDeleteVertexArrays(2, arrays);
+		glDeleteBuffers(3, buffers);
+	}
+}
+
+void MappedSeries::Update(Object& object, const Camera& camera)
+{
+	const ColumnFile& file = *m_File;
+	object.SetAABB(AABB::Create(sol::Vec2f(m_Total.xMin, m_Total.yMin), sol::Vec2f(m_Total.xMax, m_Total.yMax)));
+	if (file.Chunks() == 0)
+	{
+		return;
+	}
+	if (!m_VAO)
+	{
+		this->CreateStorage();
+	}
+	m_Frame++;
+
+	// Find chunks, which x-range intersects the view
+	AABB view = camera.LocalAABB(object);
+	double xMin = view.min.position.x, xMax = view.max.position.x;
+	m_Visible.clear();
+	size_t first = 0, last = file.Chunks();
+	if (file.IsXSorted())
+	{
+		// chunk ranges are sorted as well, so visible chunks are a contiguous range
+		size_t low = 0, high = last;
+		while (low < high)
+		{
+			size_t middle = (low + high) / 2;
+			if (file.ChunkBounds(middle).xMax < xMin) low = middle + 1;
+			else high = middle;
+		}
+		first = low;
+		high = last;
+		while (low < high)
+		{
+			size_t middle = (low + high) / 2;
+			if (file.ChunkBounds(middle).xMin <= xMax) low = middle + 1;
+			else high = middle;
+		}
+		last = low;
+	}
+	for (size_t chunk = first; chunk < last; chunk++)
+	{
+		const ColumnFile::Bounds& bounds = file.ChunkBounds(chunk);
+		if (bounds.xMax >= xMin && bounds.xMin <= xMax)
+		{
+			m_Visible.push_back(chunk);
+		}
+	}
+
+	m_Stats.visibleChunks = m_Visible.size();
+	m_Stats.summary = m_Visible.size() > m_SlotChunks.size();
+	if (m_Stats.summary)
+	{
+		return;
+	}
+
+	// Visible resident chunks are touched first, so that they are never evicted by other visible chunks
+	for (size_t chunk : m_Visible)
+	{
+		if (m_ChunkSlots[chunk] != s_None)
+		{
+			m_SlotFrames[m_ChunkSlots[chunk]] = m_Frame;
+		}
+	}
+	for (size_t chunk : m_Visible)
+	{
+		if (m_ChunkSlots[chunk] != s_None)
+		{
+			continue;
+		}
+		size_t slot = 0;
+		for (size_t i = 1; i < m_SlotChunks.size() && m_SlotChunks[slot] != s_None; i++)
+		{
+			if (m_SlotChunks[i] == s_None || m_SlotFrames[i] < m_SlotFrames[slot])
+			{
+				slot = i;
+			}
+		}
+		if (m_SlotChunks[slot] != s_None)
+		{
+			m_ChunkSlots[m_SlotChunks[slot]] = s_None;
+			m_Stats.residentChunks--;
+		}
+		this->Upload(chunk, slot);
+		m_SlotChunks[slot] = chunk;
+		m_SlotFrames[slot] = m_Frame;
+		m_ChunkSlots[chunk] = slot;
+		m_Stats.residentChunks++;
+	}
+
+	// neighbours of the visible range are likely to be uploaded next while panning
+	if (file.IsXSorted() && first < last)
+	{
+		file.Prefetch(first > 0 ? first - 1 : first, first);
+		file.Prefetch(last, std::min(last + 1, file.Chunks()));
+	}
+}
+
+bool MappedSeries::Draw(const Object& object, unsigned int renderMode)
+{
+	if (!m_VAO)
+	{
+		return true;
+	}
+	glVertexAttrib4f(s_ColorAttribute, m_Color.r, m_Color.g, m_Color.b, m_Color.a);
+	if (m_Stats.summary)
+	{
+		glBindVertexArray(m_SummaryVAO);
+		glDrawArrays(renderMode, 0, m_SummaryPoints);
+		return true;
+	}
+
+	m_Firsts.clear();
+	m_Counts.clear();
+	for (size_t chunk : m_Visible)
+	{
+		bool hasNext = chunk + 1 < m_File->Chunks();
+		m_Firsts.push_back(m_ChunkSlots[chunk] * m_SlotPoints);
+		m_Counts.push_back(m_File->ChunkSize(chunk) + hasNext);
+	}
+	glBindVertexArray(m_VAO);
+	glMultiDrawArrays(renderMode, m_Firsts.data(), m_Counts.data(), m_Firsts.size());
+	return true;
+}
+
+void MappedSeries::CreateStorage()
+{
+	const ColumnFile& file = *m_File;
+	size_t xSize = ColumnFile::TypeSize(file.XType());
+	size_t ySize = ColumnFile::TypeSize(file.YType());
+	m_SlotPoints = file.ChunkPoints() + 1;
+	size_t slots = std::clamp<size_t>(m_Budget / (m_SlotPoints * (xSize + ySize)), 1, file.Chunks());
+	m_SlotChunks.assign(slots, s_None);
+	m_SlotFrames.assign(slots, 0);
+	m_Stats.slots = slots;
+
+	glCreateBuffers(1, &m_XBuffer);
+	glCreateBuffers(1, &m_YBuffer);
+	glNamedBufferData(m_XBuffer, slots * m_SlotPoints * xSize, nullptr, GL_DYNAMIC_DRAW);
+	glNamedBufferData(m_YBuffer, slots * m_SlotPoints * ySize, nullptr, GL_DYNAMIC_DRAW);
+
+	// Columns are bound as separate buffers. Doubles are converted to floats by OpenGL when attributes are fetched
+	glCreateVertexArrays(1, &m_VAO);
+	glEnableVertexArrayAttrib(m_VAO, s_XAttribute);
+	glVertexArrayAttribFormat(m_VAO, s_XAttribute, 1, GLType(file.XType()), GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_VAO, s_XAttribute, 0);
+	glVertexArrayVertexBuffer(m_VAO, 0, m_XBuffer, 0, xSize);
+	glEnableVertexArrayAttrib(m_VAO, s_YAttribute);
+	glVertexArrayAttribFormat(m_VAO, s_YAttribute, 1, GLType(file.YType()), GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_VAO, s_YAttribute, 1);
+	glVertexArrayVertexBuffer(m_VAO, 1, m_YBuffer, 0, ySize);
+
+	// Summary is a zig-zag through the bounds of each chunk
+	m_SummaryPoints = 2 * file.Chunks();
+	std::vector<float> summary(2 * m_SummaryPoints);
+	float* xs = summary.data();
+	float* ys = summary.data() + m_SummaryPoints;
+	for (size_t chunk = 0; chunk < file.Chunks(); chunk++)
+	{
+		const ColumnFile::Bounds& bounds = m_Bounds[chunk];
+		xs[2 * chunk] = bounds.xMin;
+		ys[2 * chunk] = bounds.yMin;
+		xs[2 * chunk + 1] = bounds.xMax;
+		ys[2 * chunk + 1] = bounds.yMax;
+	}
+	glCreateBuffers(1, &m_SummaryBuffer);
+	glNamedBufferData(m_SummaryBuffer, summary.size() * sizeof(float), summary.data(), GL_STATIC_DRAW);
+
+	glCreateVertexArrays(1, &m_SummaryVAO);
+	glEnableVertexArrayAttrib(m_SummaryVAO, s_XAttribute);
+	glVertexArrayAttribFormat(m_SummaryVAO, s_XAttribute, 1, GL_FLOAT, GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_SummaryVAO, s_XAttribute, 0);
+	glVertexArrayVertexBuffer(m_SummaryVAO, 0, m_SummaryBuffer, 0, sizeof(float));
+	glEnableVertexArrayAttrib(m_SummaryVAO, s_YAttribute);
+	glVertexArrayAttribFormat(m_SummaryVAO, s_YAttribute, 1, GL_FLOAT, GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_SummaryVAO, s_YAttribute, 1);
+	glVertexArrayVertexBuffer(m_SummaryVAO, 1, m_SummaryBuffer, m_SummaryPoints * sizeof(float), sizeof(float));
+
+	std::cout << "Mapped series of " << file.Path() << " uses " << slots << " GPU slots of " << m_SlotPoints << " points\n";
+}
+
+void MappedSeries::ComputeYBounds()
+{
+	const ColumnFile& file = *m_File;
+	std::cout << "Column file " << file.Path() << " has no y-bounds, computing them\n";
+	Parallel::For(file.Chunks(), 1, [&](size_t begin, size_t end)
+	{
+		for (size_t chunk = begin; chunk < end; chunk++)
+		{
+			ColumnFile::Bounds& bounds = m_Bounds[chunk];
+			if (std::isfinite(bounds.yMin) && std::isfinite(bounds.yMax))
+			{
+				continue;
+			}
+			bounds.yMin = std::numeric_limits<double>::max();
+			bounds.yMax = std::numeric_limits<double>::lowest();
+			size_t first = file.ChunkBegin(chunk);
+			for (size_t i = first; i < first + file.ChunkSize(chunk); i++)
+			{
+				double y = file.Y(i);
+				bounds.yMin = std::min(bounds.yMin, y);
+				bounds.yMax = std::max(bounds.yMax, y);
+			}
+		}
+	});
+
+	// chunks of non-finite values only are left empty and don't contribute to the total
+	m_Total.yMin = std::numeric_limits<double>::max();
+	m_Total.yMax = std::numeric_limits<double>::lowest();
+	for (ColumnFile::Bounds& bounds : m_Bounds)
+	{
+		if (bounds.yMin > bounds.yMax)
+		{
+			bounds.yMin = bounds.yMax = 0.0;
+			continue;
+		}
+		m_Total.yMin = std::min(m_Total.yMin, bounds.yMin);
+		m_Total.yMax = std::max(m_Total.yMax, bounds.yMax);
+	}
+	if (m_Total.yMin > m_Total.yMax)
+	{
+		m_Total.yMin = m_Total.yMax = 0.0;
+	}
+}
+
+void MappedSeries::Upload(size_t chunk, size_t slot)
+{
+	const ColumnFile& file = *m_File;
+	size_t begin = file.ChunkBegin(chunk);
+	size_t count = file.ChunkSize(chunk) + (chunk + 1 < file.Chunks());
+	size_t xSize = ColumnFile::TypeSize(file.XType());
+	size_t ySize = ColumnFile::TypeSize(file.YType());
+
+	// data goes from the mapping straight to the driver, pages are read from disk on the first access
+	glNamedBufferSubData(m_XBuffer, slot * m_SlotPoints * xSize, count * xSize, file.XData(begin));
+	glNamedBufferSubData(m_YBuffer, slot * m_SlotPoints * ySize, count * ySize, file.YData(begin));
+	m_Stats.uploadedBytes += count * (xSize + ySize);
+}
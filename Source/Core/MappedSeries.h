@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <Core/Series.h>
+#include <Utility/ColumnFile.h>
+#include <Utility/Matrix.h>
+
+/**
+ * 	MappedSeries is a Series, that draws points of a memory-mapped ColumnFile
+ *
+ * 	Only chunks, which x-range intersects the view, are uploaded to GPU. Chunks are uploaded straight from
+ * 	the mapping without any intermediate copy, as the columns are already in the layout, that OpenGL reads:
+ * 	x and y columns are separate vertex attributes and float64 columns are converted by OpenGL.
+ * 	Thus a file of any size opens immediately and only the pages of visible chunks are ever read from disk.
+ * 	The only exception are files without stored y-bounds, their y column is scanned in parallel once the series is created,
+ * 	so that the object's AABB and the summary cover the real y-range.
+ *
+ * 	GPU storage is split into slots of one chunk each. Uploaded chunks stay resident until their slot is needed
+ * 	for another visible chunk, the least recently visible chunk is evicted then.
+ * 	Each slot also holds the first point of the next chunk, so that line strips are continuous across chunks.
+ * 	If more chunks are visible than fit into the budget, a coarse summary is drawn instead,
+ * 	that is a min-max zig-zag over the chunk bounds, so zooming out of a huge file never uploads it whole.
+ *
+ * 	Objects with this series must use a material with "Column" shader, as x and y are separate attributes.
+ * 	Note that float64 coordinates are rendered in float32, so huge offsets, e.g. unix timestamps, lose precision
+ */
+class MappedSeries : public Series
+{
+public:
+	struct Stats
+	{
+		size_t visibleChunks = 0;
+		size_t residentChunks = 0;
+		size_t slots = 0;
+		// total amount of bytes, that were uploaded to GPU
+		size_t uploadedBytes = 0;
+		bool summary = false;
+	};
+public:
+	MappedSeries(std::shared_ptr<const ColumnFile> file, sol::Vec4f color, size_t budget = 64 * 1024 * 1024);
+	MappedSeries(const MappedSeries&) = delete;
+	MappedSeries& operator=(const MappedSeries&) = delete;
+	// Deletes VAOs and VBOs
+	~MappedSeries();
+
+	// Finds visible chunks and uploads those, that are not resident yet
+	void Update(Object& object, const Camera& camera) override;
+	// Draws visible chunks with a single multi-draw call, or the summary
+	bool Draw(const Object& object, unsigned int renderMode) override;
+
+	inline const ColumnFile& File() const { return *m_File; }
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline const sol::Vec4f& Color() const { return m_Color; }
+	inline void SetColor(const sol::Vec4f& color) { m_Color = color; }
+private:
+	// creates OpenGL objects on the first update, as the series may be created before the context
+	void CreateStorage();
+	// completes y-bounds of chunks and the total, that the file doesn't store
+	void ComputeYBounds();
+	// uploads the chunk to the slot
+	void Upload(size_t chunk, size_t slot);
+private:
+	std::shared_ptr<const ColumnFile> m_File;
+	sol::Vec4f m_Color;
+	size_t m_Budget;
+
+	// bounds of the file and of its chunks with finite y-ranges
+	std::vector<ColumnFile::Bounds> m_Bounds;
+	ColumnFile::Bounds m_Total;
+
+	// amount of points in a slot, i.e. a chunk and the first point of the next one
+	size_t m_SlotPoints = 0;
+	// chunk of each slot or npos if the slot is free, and the frame the slot was visible last
+	std::vector<size_t> m_SlotChunks;
+	std::vector<size_t> m_SlotFrames;
+	// slot of each chunk or npos if the chunk isn't resident
+	std::vector<size_t> m_ChunkSlots;
+	std::vector<size_t> m_Visible;
+	size_t m_Frame = 0;
+
+	// arguments of glMultiDrawArrays()
+	std::vector<int> m_Firsts;
+	std::vector<int> m_Counts;
+
+	unsigned int m_VAO = 0;
+	unsigned int m_XBuffer = 0;
+	unsigned int m_YBuffer = 0;
+	unsigned int m_SummaryVAO = 0;
+	unsigned int m_SummaryBuffer = 0;
+	size_t m_SummaryPoints = 0;
+
+	Stats m_Stats;
+};
@@ -1,5 +1,10 @@
 #include <Core/Material.h>
 
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <GL/glew.h>
+
 Shader::Shader(const std::string& name)
 : m_Name(name), m_Program(glCreateProgram())
 , m_Vertex(glCreateShader(GL_VERTEX_SHADER)), m_Fragment(glCreateShader(GL_FRAGMENT_SHADER))
@@ -106,11 +111,16 @@ Shader& Shader::operator=(Shader&& other)
 
 Shader::~Shader()
 {
+	// moved-from and default constructed shaders own nothing, so no OpenGL calls are made for them
+	if (m_Program == 0)
+	{
+		return;
+	}
 	glDetachShader(m_Program, m_Vertex);
     glDetachShader(m_Program, m_Fragment);
 
 	glDeleteShader(m_Vertex);
-	glDeleteProgram(m_Fragment);
+	glDeleteShader(m_Fragment);
 
 	glDeleteProgram(m_Program);
 }
@@ -131,6 +141,15 @@ void Shader::SetUniformMat4(const char* uniform, const sol::Mat4f& mat) const
 	glUniformMatrix4fv(location, 1, GL_FALSE, &mat[0].x);
 }
 
+void Shader::SetUniformAffine2(const char* uniform, const sol::Affine2f& mat) const
+{
+	auto iterator = m_UniformCache.find(uniform);
+	unsigned int location = iterator == m_UniformCache.end() ? glGetUniformLocation(m_Program, uniform) : iterator->second;
+	m_UniformCache.emplace(uniform, location);
+	// Affine2f rows are uploaded as the rows of mat3x2 with transpose = GL_TRUE
+	glUniformMatrix3x2fv(location, 1, GL_TRUE, &mat[0].x);
+}
+
 void Shader::SetUniformVec4(const char* uniform, const sol::Vec4f& vec) const 
 {
 	auto iterator = m_UniformCache.find(uniform);
@@ -184,6 +203,9 @@ Material::Material(const std::string& shaderName, unsigned int renderMode)
 Material::Material(std::string&& shaderName, unsigned int renderMode)
 : m_Shader(Shader(std::move(shaderName))), m_RenderMode(renderMode) {}
 
+Material::Material(Shader&& shader, unsigned int renderMode)
+: m_Shader(std::move(shader)), m_RenderMode(renderMode) {}
+
 
 Material::Material(Material&& other)
 : m_Shader(std::move(other.m_Shader)), m_RenderMode(other.m_RenderMode)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+#include <ostream>
 #include <unordered_map>
 #include <Utility/Matrix.h>
 
@@ -30,6 +32,8 @@ public:
 
 	// Convenient uniform setters for all required types
 	void SetUniformMat4(const char* uniform, const sol::Mat4f& mat) const;
+	// Uploads the affine transform to a mat3x2 uniform
+	void SetUniformAffine2(const char* uniform, const sol::Affine2f& mat) const;
 	void SetUniformVec4(const char* uniform, const sol::Vec4f& vec) const;
 	void SetUniformVec3(const char* uniform, const sol::Vec3f& vec) const;
 	void SetUniformVec2(const char* uniform, const sol::Vec2f& vec) const;
@@ -45,12 +49,12 @@ public:
 private:
 	// Shader stores it's name for convenience, despite the fact it is stored in Material
 	std::string m_Name;
-	// OpenGL Shader program id
-	unsigned int m_Program;
+	// OpenGL Shader program id. Default constructed and moved-from shaders have no program
+	unsigned int m_Program = 0;
 	// vertex shader id
-	unsigned int m_Vertex;
+	unsigned int m_Vertex = 0;
 	// fragment shader id
-	unsigned int m_Fragment;
+	unsigned int m_Fragment = 0;
 
 	// UniformCache is mutable, as it's not entirely describes object's state, thus may be changed in const methods
 	mutable UniformCache m_UniformCache;
@@ -66,6 +70,8 @@ class Material
 public:
 	Material(const std::string& shaderName, unsigned int renderMode);
 	Material(std::string&& shaderName, unsigned int renderMode);
+	// Constructor of material with an already created shader, e.g. a default constructed one, that needs no OpenGL context
+	Material(Shader&& shader, unsigned int renderMode);
 
 	Material(const Material&) = default;
 	Material(Material&&);
@@ -1,5 +1,9 @@
 #include <Core/Object.h>
 
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
 Object::Object(std::initializer_list<Vertex> list, Material* material, bool isCollider, std::function<bool(const Shader&, Object&)> uniformCallback)
 : m_UniformCallback(uniformCallback), m_Vertices(list)
 , m_Material(material), m_IsCollider(isCollider), m_UUID(UUID::Generate_UUID_V4())
@@ -12,24 +16,39 @@ Object::Object(std::vector<Vertex>&& vector, Material* material, bool isCollider
 {
 }
 
-sol::Mat4f Object::RotationMat() const
-{
-	return sol::RotateZ(this->Angle());
-}
-
-sol::Mat4f Object::ScaleMat() const
+Object::Object(std::vector<Vertex>&& vector, Material* material, UUID::uuid&& uuid, bool isCollider, std::function<bool(const Shader&, Object&)> uniformCallback)
+: m_UniformCallback(uniformCallback), m_Vertices(std::move(vector))
+, m_Material(material), m_IsCollider(isCollider), m_UUID(std::move(uuid))
 {
-	return sol::Scale(this->Scale());
 }
 
-sol::Mat4f Object::TranslationMat() const
+sol::Affine2f Object::ModelMat() const
 {
-	return sol::Translate(sol::Mat4f(1.0f), this->Transform());
+	return sol::TRS(sol::Vec2f(this->Transform()), this->Angle(), sol::Vec2f(this->Scale()));
 }
 
 void Object::AddVertices(std::initializer_list<Vertex> vertices)
 {
-	std::for_each(vertices.begin(), vertices.end(), [&](const Vertex& vertex) { m_Vertices.push_back(vertex); });
+	std::for_each(vertices.begin(), vertices.end(), [&](const Vertex& vertex)
+	{
+		if (m_IsSortedX && !m_Vertices.empty() && !(vertex.position.x >= m_Vertices.back().position.x))
+		{
+			m_IsSortedX = false;
+		}
+		m_Vertices.push_back(vertex);
+	});
+
+	// only the new vertices are scanned, unless the object had no vertices or no AABB before
+	if (!m_AABB || m_Vertices.size() == vertices.size())
+	{
+		this->CreateAABB();
+		return;
+	}
+	sol::Vec2f min, max;
+	if (AABB::Bounds(vertices.begin(), vertices.size(), min, max))
+	{
+		m_AABB->Extend(min, max);
+	}
 }
 
 void Object::FillColor(const sol::Vec4f color)
@@ -45,28 +64,59 @@ void Object::CreateAABB()
 	this->m_AABB = std::make_unique<AABB>(AABB::Create(this->Vertices()));
 }
 
+void Object::SetAABB(const AABB& aabb)
+{
+	if (this->m_AABB)
+	{
+		*this->m_AABB = aabb;
+		return;
+	}
+	this->m_AABB = std::make_unique<AABB>(aabb);
+}
+
+bool Object::DetectSortedX()
+{
+	// NaN x breaks the order as well, as binary search can't skip it
+	auto unordered = std::adjacent_find(m_Vertices.begin(), m_Vertices.end(), [](const Vertex& a, const Vertex& b)
+	{
+		return !(b.position.x >= a.position.x);
+	});
+	bool hasNaN = !m_Vertices.empty() && std::isnan(m_Vertices.front().position.x);
+	m_IsSortedX = unordered == m_Vertices.end() && !hasNaN;
+	return m_IsSortedX;
+}
+
+// Series of a copied object, see Series::Clone()
+static std::shared_ptr<Series> CopySeries(const std::shared_ptr<Series>& series)
+{
+	std::shared_ptr<Series> clone = series ? series->Clone() : nullptr;
+	return clone ? clone : series;
+}
+
 Object::Object(const Object& other)
 : m_Vertices(other.m_Vertices)
 , m_UniformCallback(other.m_UniformCallback)
 , m_RotationAngle(other.m_RotationAngle), m_Scale(other.m_Scale), m_Transform(other.m_Transform)
 , m_Material(other.m_Material), m_IsCollider(other.m_IsCollider), m_UUID(UUID::Generate_UUID_V4())
-, m_AABB(std::make_unique<AABB>(*other.m_AABB))
+, m_AABB(other.m_AABB ? std::make_unique<AABB>(*other.m_AABB) : nullptr), m_Series(::CopySeries(other.m_Series))
 {
 	m_Selected = other.m_Selected;
 	m_RenderAABB = other.m_RenderAABB;
 	m_IsSealed = other.m_IsSealed;
+	m_IsSortedX = other.m_IsSortedX;
 }
 
-Object::Object(Object&& other)
+Object::Object(Object&& other) noexcept
 : m_Vertices(std::move(other.m_Vertices))
 , m_UniformCallback(std::move(other.m_UniformCallback))
 , m_RotationAngle(other.m_RotationAngle), m_Scale(other.m_Scale), m_Transform(other.m_Transform)
 , m_Material(other.m_Material), m_IsCollider(other.m_IsCollider), m_UUID(std::move(other.m_UUID))
-, m_AABB(std::move(other.m_AABB))
+, m_AABB(std::move(other.m_AABB)), m_Series(std::move(other.m_Series))
 {
 	m_Selected = other.m_Selected;
 	m_RenderAABB = other.m_RenderAABB;
 	m_IsSealed = other.m_IsSealed;
+	m_IsSortedX = other.m_IsSortedX;
 
 	// We should also steal the state of previous object
 	other.m_Selected = false;
@@ -77,6 +127,7 @@ Object::Object(Object&& other)
 	other.m_IsCollider = true;
 	other.m_RenderAABB = false;
 	other.m_IsSealed = false;
+	other.m_IsSortedX = false;
 }
 
 Object& Object::operator=(const Object& other)
@@ -93,14 +144,16 @@ Object& Object::operator=(const Object& other)
 	this->m_Material = other.m_Material;
 	this->m_IsCollider = other.m_IsCollider;
 	this->m_UUID = UUID::Generate_UUID_V4();
-	this->m_AABB = std::make_unique<AABB>(*other.m_AABB);
+	this->m_AABB = other.m_AABB ? std::make_unique<AABB>(*other.m_AABB) : nullptr;
+	this->m_Series = ::CopySeries(other.m_Series);
 	this->m_IsSealed = other.m_IsSealed;
+	this->m_IsSortedX = other.m_IsSortedX;
 	this->m_RenderAABB = false;
 
 	return *this;
 }
 
-Object& Object::operator=(Object&& other)
+Object& Object::operator=(Object&& other) noexcept
 {
 	if (this == &other)
         return *this;
@@ -114,8 +167,10 @@ Object& Object::operator=(Object&& other)
 	this->m_Material = other.m_Material;
 	this->m_IsCollider = other.m_IsCollider;
 	this->m_UUID = std::move(other.m_UUID);
-	this->m_AABB = std::make_unique<AABB>(*other.m_AABB);
+	this->m_AABB = std::move(other.m_AABB);
+	this->m_Series = std::move(other.m_Series);
 	this->m_IsSealed = other.m_IsSealed;
+	this->m_IsSortedX = other.m_IsSortedX;
 	this->m_RenderAABB = other.m_RenderAABB;
 
 	// We should also steal the state of previous object
@@ -130,6 +185,7 @@ Object& Object::operator=(Object&& other)
 	other.m_IsSealed = false;
 	other.m_IsSealed = false;
 	other.m_RenderAABB = false;
+	other.m_IsSortedX = false;
 
 	return *this;
 }
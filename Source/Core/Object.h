@@ -1,22 +1,25 @@
 #pragma once
 
+#include <memory>
 #include <vector>
+#include <functional>
 #include <unordered_map>
 #include <Utility/UUID.h>
 #include <Utility/AABB.h>
 #include <Utility/Vertex.h>
 #include <Core/Material.h>
 #include <Core/Events.h>
+#include <Core/Series.h>
 
 /**
  * 	Object class is a wrapper for an array of vertices. It provides convenient interface 
  *  for translating, rotating and scaling vertices, and wrapping them into a single object
  * 	
- * 	AddVertices() method allows to add new vertices to an object. 
- * 	It's important to remember that AABB is not updated after adding vertices, so it should be done manually
- * 	by calling CreateAABB() method
+ * 	AddVertices() method allows to add new vertices to an object. AABB is extended by the new vertices only,
+ * 	so appending is O(k) for k new vertices. Direct modifications of Vertices() require calling CreateAABB() method
  * 
  * 	Every object contains its own UUID. If copy constructor or copy operator is called, the new UUID is created. 
+ * 	Objects, that are restored from a scene file, are constructed with their saved UUID
  * 	
  * 	UniformCallback is a function, that is called each time an object is being rendered.
  * 	May be used to set an object color according to object's state. 
@@ -27,10 +30,16 @@
  * 	- 	Private field m_IsSealed tells the renderer whether the object is modifiable. 
  * 		If false, there will be no object reference in ImGui window. The only way to modify a sealed object - via code.
  * 	- 	Private field m_IsCollider tells the renderer whether object should take place in AABB collision tests
+ * 	- 	Private field m_IsSortedX tells the renderer that vertices are sorted by x, so only the visible range of them
+ * 		is found with binary search and drawn. It is set by DetectSortedX() and cleared by AddVertices() once the order breaks
  * 
  * 	Every object holds a pointer to a certain material, which is stored in ObjectHandler object.
  * 	Thus material can be easily changed at runtime
  * 	For more information about materials @see @ref <Core/Material.h>
+ * 
+ * 	An object may also have a Series attached. Series regenerates object's vertices and AABB each frame,
+ * 	e.g. curves are resampled according to the camera zoom. Copies of the object get Series::Clone() of it or share it
+ * 	For more information about series @see @ref <Core/Series.h>
  */
 class Object
 {
@@ -42,6 +51,9 @@ public:
 	Object(std::initializer_list<Vertex> list, Material* material, bool isCollider = true, UniformCallback uniformCallback = Events::OnObjectRender);
 	// Constructor of object with rvalue vector
 	Object(std::vector<Vertex>&& vector, Material* material, bool isCollider = true, UniformCallback uniformCallback = Events::OnObjectRender);
+	// Constructor of object with rvalue vector, that keeps the given UUID instead of generating a new one,
+	// e.g. for objects, that are loaded from a scene file
+	Object(std::vector<Vertex>&& vector, Material* material, UUID::uuid&& uuid, bool isCollider = true, UniformCallback uniformCallback = Events::OnObjectRender);
 	
 	// Rule of 5
 
@@ -50,24 +62,27 @@ public:
 	// Move constructor steals all data from object, avoiding new UUID generation and AABB allocation
 	// Old moved object won't be sealed, won't render it's AABB and will be a collider by default.
 	// Moved object's material will be nullptr and vertices will be cleared
-	Object(Object&&);
+	// Moves are noexcept, so that std::vector moves objects on reallocation instead of copying them with new UUIDs
+	Object(Object&&) noexcept;
 	// Same as copy constructor
 	Object& operator=(const Object&);
 	// Same as move constructor
-	Object& operator=(Object&&);
+	Object& operator=(Object&&) noexcept;
 	
 	~Object() = default;
 		
-	// This method returns a ready-to-go MVP matrix
-	sol::Mat4f RotationMat() const;
-	sol::Mat4f ScaleMat() const;
-	sol::Mat4f TranslationMat() const;
-	// will push_back vertices to object's vertex array 
+	// Returns the model matrix, i.e. the object's vertices are scaled, rotated and translated
+	sol::Affine2f ModelMat() const;
+	// will push_back vertices to object's vertex array and extend the AABB
 	void AddVertices(std::initializer_list<Vertex> vertices);
 	// changes the color of each vertex in the object's current vertex array
 	void FillColor(const sol::Vec4f color);
 	// creates AABB from the object's current vertex array
 	void CreateAABB();
+	// sets already computed AABB, e.g. when the bounds are known while vertices are generated
+	void SetAABB(const AABB& aabb);
+	// checks whether the object's current vertex array is sorted by x and marks the object accordingly
+	bool DetectSortedX();
 
 	// UniformCallback is a function, that is called each time an object is being rendered.
 	// Called right before Renderer::FrameCallback() callback
@@ -76,7 +91,11 @@ public:
 
 	// Many getters and setters
 	inline const Material* GetMaterial() { return m_Material; }
+	inline const Material* GetMaterial() const { return m_Material; }
 	inline void SetMaterial(Material* material) { m_Material = material; }
+	inline Series* GetSeries() { return m_Series.get(); }
+	inline const Series* GetSeries() const { return m_Series.get(); }
+	inline void SetSeries(std::shared_ptr<Series> series) { m_Series = std::move(series); }
 
 	constexpr inline float& Angle() { return m_RotationAngle; }
 	constexpr inline const float& Angle() const { return m_RotationAngle; }
@@ -85,9 +104,11 @@ public:
 	constexpr inline sol::Vec3f& Transform() { return m_Transform; }
 	constexpr inline const sol::Vec3f& Transform() const { return m_Transform; }
 
+	inline bool HasAABB() const { return m_AABB != nullptr; }
 	inline AABB& GetAABB() { return *m_AABB.get(); }
 	inline const AABB& GetAABB() const { return *m_AABB.get(); }
 	constexpr inline const UUID::uuid& GetUUID() const { return m_UUID; }
+	constexpr inline std::vector<Vertex>& Vertices() { return m_Vertices; }
 	constexpr inline const std::vector<Vertex>& Vertices() const { return m_Vertices; }
 
 	constexpr bool& Selected() { return m_Selected; }
@@ -98,10 +119,13 @@ public:
 	constexpr void SetSealed(bool isSealed) { m_IsSealed = isSealed; }
 	constexpr bool& Collider() { return m_IsCollider; }
 	constexpr const bool& Collider() const { return m_IsCollider; }
+	constexpr bool IsSortedX() const { return m_IsSortedX; }
+	// There is no setter, DetectSortedX() sets the flag, as drawing unsorted vertices as sorted would cut them
+	constexpr void ResetSortedX() { m_IsSortedX = false; }
 private:
 	std::vector<Vertex> m_Vertices;
 
-	// Components of MVP matrix, that can be modified at runtime
+	// Components of the model matrix, that can be modified at runtime. Only x and y of scale and translation are used
 	float m_RotationAngle = 0.0f;
 	sol::Vec3f m_Scale = sol::Vec3f(1.0f);
 	sol::Vec3f m_Transform = sol::Vec3f(0.0f);
@@ -109,11 +133,13 @@ private:
 	bool m_Selected = false;
 	bool m_RenderAABB = false;
 	bool m_IsSealed = false;
+	bool m_IsSortedX = false;
 	bool m_IsCollider;
 
 	Material* m_Material;
 	UUID::uuid m_UUID;
 	std::unique_ptr<AABB> m_AABB;
+	std::shared_ptr<Series> m_Series;
 
 	UniformCallback m_UniformCallback;
 };
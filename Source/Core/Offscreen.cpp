@@ -0,0 +1,195 @@
+#include <Core/Offscreen.h>
+
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <GL/glew.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+// Surfaceless platform of Mesa needs neither X11 nor a DRM device, the default display is a fallback for other drivers
+static EGLDisplay GetDisplay()
+{
+	const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless"))
+	{
+		auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		EGLDisplay display = getPlatformDisplay ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr) : EGL_NO_DISPLAY;
+		if (display != EGL_NO_DISPLAY)
+		{
+			return display;
+		}
+	}
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+Offscreen::Offscreen(int width, int height)
+: m_Width(width), m_Height(height)
+{
+	if (width <= 0 || height <= 0)
+	{
+		throw std::invalid_argument("Offscreen framebuffer must have a positive size");
+	}
+
+	try
+	{
+		EGLDisplay display = GetDisplay();
+		EGLint major, minor;
+		if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+		{
+			throw std::runtime_error("Failed to initialize EGL display");
+		}
+		m_Display = display;
+		std::cout << "Offscreen: EGL " << major << "." << minor << " (" << eglQueryString(display, EGL_VENDOR) << ")\n";
+
+		const EGLint configAttributes[] =
+		{
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_RED_SIZE, 8,
+			EGL_GREEN_SIZE, 8,
+			EGL_BLUE_SIZE, 8,
+			EGL_ALPHA_SIZE, 8,
+			EGL_NONE
+		};
+		EGLConfig config;
+		EGLint configs = 0;
+		if (!eglChooseConfig(display, configAttributes, &config, 1, &configs) || configs == 0)
+		{
+			throw std::runtime_error("EGL display has no config for desktop OpenGL");
+		}
+		if (!eglBindAPI(EGL_OPENGL_API))
+		{
+			throw std::runtime_error("EGL display doesn't support desktop OpenGL");
+		}
+
+		// the same version and profile, that Application requests from GLFW, as shaders are written for them
+		const EGLint contextAttributes[] =
+		{
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 5,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		m_Context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+		if (m_Context == EGL_NO_CONTEXT)
+		{
+			m_Context = nullptr;
+			throw std::runtime_error("Failed to create OpenGL 4.5 core context with EGL");
+		}
+
+		if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_Context))
+		{
+			// without EGL_KHR_surfaceless_context a context needs a surface to be current
+			const EGLint surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+			m_Surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+			if (m_Surface == EGL_NO_SURFACE || !eglMakeCurrent(display, m_Surface, m_Surface, m_Context))
+			{
+				throw std::runtime_error("Failed to make EGL context current");
+			}
+		}
+
+		GLenum status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+		// GLEW, that is built for GLX, reports a missing X display, although functions are loaded for the current EGL context
+		if (status == GLEW_ERROR_NO_GLX_DISPLAY)
+		{
+			status = GLEW_OK;
+		}
+#endif
+		if (status != GLEW_OK)
+		{
+			throw std::runtime_error("Failed to initialize OpenGL bindings");
+		}
+		std::cout << "Offscreen: " << glGetString(GL_RENDERER) << ", OpenGL " << glGetString(GL_VERSION) << std::endl;
+
+		glGenRenderbuffers(1, &m_Colorbuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_Colorbuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+		glGenFramebuffers(1, &m_Framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_Colorbuffer);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		{
+			throw std::runtime_error("Offscreen framebuffer is incomplete");
+		}
+		this->Bind();
+	}
+	catch (...)
+	{
+		this->Release();
+		throw;
+	}
+}
+
+Offscreen::~Offscreen()
+{
+	this->Release();
+}
+
+void Offscreen::Release()
+{
+	// OpenGL objects exist only once GLEW is initialized and the context is current, otherwise its functions are null
+	if (m_Framebuffer)
+	{
+		glDeleteFramebuffers(1, &m_Framebuffer);
+	}
+	if (m_Colorbuffer)
+	{
+		glDeleteRenderbuffers(1, &m_Colorbuffer);
+	}
+	if (m_Context)
+	{
+		eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(m_Display, m_Context);
+	}
+	if (m_Surface)
+	{
+		eglDestroySurface(m_Display, m_Surface);
+	}
+	if (m_Display)
+	{
+		eglTerminate(m_Display);
+	}
+	m_Framebuffer = m_Colorbuffer = 0;
+	m_Display = m_Context = m_Surface = nullptr;
+}
+
+void Offscreen::Bind() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+	glViewport(0, 0, m_Width, m_Height);
+}
+
+void Offscreen::ReadPixels(std::vector<unsigned char>& pixels) const
+{
+	const size_t row = static_cast<size_t>(m_Width) * 3;
+	pixels.resize(row * m_Height);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Framebuffer);
+	// rows of RGB pixels aren't padded to 4 bytes
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, m_Width, m_Height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+	// OpenGL returns rows from bottom to top
+	for (size_t top = 0, bottom = m_Height - 1; top < bottom; top++, bottom--)
+	{
+		std::swap_ranges(pixels.begin() + top * row, pixels.begin() + (top + 1) * row, pixels.begin() + bottom * row);
+	}
+}
+
+void Offscreen::WritePPM(const std::string& path) const
+{
+	std::vector<unsigned char> pixels;
+	this->ReadPixels(pixels);
+
+	std::ofstream file(path, std::ios::binary);
+	file << "P6\n" << m_Width << " " << m_Height << "\n255\n";
+	file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+	if (!file)
+	{
+		throw std::runtime_error("Failed to write image " + path);
+	}
+}
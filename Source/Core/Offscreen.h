@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * 	Offscreen is an OpenGL context without any window, that renders into a framebuffer object
+ *
+ * 	The context is created with EGL on the surfaceless platform of Mesa, if it is available, or on the default display.
+ * 	It needs neither a display server nor a GPU, e.g. Mesa's llvmpipe renders on the CPU.
+ * 	If the driver doesn't support surfaceless contexts, a 1x1 pbuffer is made current instead, as all drawing goes to the FBO anyway.
+ * 	Neither GLFW nor ImGui are used, so a Renderer, that is created with the size of the framebuffer, renders the scene into it.
+ *
+ * 	Pixels are read back with ReadPixels() and may be written to a binary PPM image with WritePPM().
+ * 	Constructor throws std::runtime_error if the context or the framebuffer can't be created
+ */
+class Offscreen
+{
+public:
+	// Creates an OpenGL 4.5 core context and a framebuffer of the given size and makes both current
+	Offscreen(int width, int height);
+	Offscreen(const Offscreen&) = delete;
+	Offscreen& operator=(const Offscreen&) = delete;
+	// Deletes the framebuffer and destroys the context
+	~Offscreen();
+
+	// Binds the framebuffer and sets the viewport to its size
+	void Bind() const;
+	// Reads RGB pixels of the framebuffer with rows from top to bottom, as images store them
+	void ReadPixels(std::vector<unsigned char>& pixels) const;
+	// Writes the framebuffer to a binary PPM image. Throws std::runtime_error if the file can't be written
+	void WritePPM(const std::string& path) const;
+
+	inline int Width() const { return m_Width; }
+	inline int Height() const { return m_Height; }
+private:
+	// Deletes everything, that was created, so that a partially constructed object is cleaned up as well
+	void Release();
+private:
+	int m_Width;
+	int m_Height;
+	// EGLDisplay, EGLContext and EGLSurface are opaque pointers, so that EGL headers aren't included everywhere
+	void* m_Display = nullptr;
+	void* m_Context = nullptr;
+	void* m_Surface = nullptr;
+	unsigned int m_Framebuffer = 0;
+	unsigned int m_Colorbuffer = 0;
+};
@@ -0,0 +1,290 @@
+#include <Core/PagedSeries.h>
+#include <Core/Camera.h>
+#include <Core/Object.h>
+
+static constexpr size_t s_None = static_cast<size_t>(-1);
+
+// attribute locations of Data/Column.vert
+static constexpr unsigned int s_XAttribute = 0;
+static constexpr unsigned int s_ColorAttribute = 1;
+static constexpr unsigned int s_YAttribute = 2;
+
+static unsigned int GLType(ColumnFile::Type type)
+{
+	return type == ColumnFile::Type::Float64 ? GL_DOUBLE : GL_FLOAT;
+}
+
+PagedSeries::PagedSeries(std::shared_ptr<const ColumnFile> file, sol::Vec4f color, size_t memoryBudget, size_t gpuBudget)
+: m_Cache(std::move(file), memoryBudget), m_Color(color), m_GpuBudget(gpuBudget)
+{
+	const ColumnFile& columns = m_Cache.File();
+	m_ChunkSlots.assign(columns.Chunks(), s_None);
+	m_HasSummary.assign(columns.Chunks(), false);
+	for (size_t chunk = 0; chunk < columns.Chunks(); chunk++)
+	{
+		const ColumnFile::Bounds& bounds = columns.ChunkBounds(chunk);
+		m_HasSummary[chunk] = std::isfinite(bounds.yMin) && std::isfinite(bounds.yMax);
+	}
+	const ColumnFile::Bounds& total = columns.GetBounds();
+	if (std::isfinite(total.yMin) && std::isfinite(total.yMax))
+	{
+		m_YMin = total.yMin;
+		m_YMax = total.yMax;
+	}
+}
+
+PagedSeries::~PagedSeries()
+{
+	if (m_VAO)
+	{
+		unsigned int arrays[] = { m_VAO, m_SummaryVAO };
+		unsigned int buffers[] = { m_XBuffer, m_YBuffer, m_SummaryBuffer };
+		glDeleteVertexArrays(2, arrays);
+		glDeleteBuffers(3, buffers);
+	}
+}
+
+void PagedSeries::Update(Object& object, const Camera& camera)
+{
+	const ColumnFile& file = m_Cache.File();
+	const ColumnFile::Bounds& total = file.GetBounds();
+	AABB view = camera.LocalAABB(object);
+	// until a page is loaded, y-range of a file without stored y-bounds is unknown, so it follows the view and is never culled
+	bool hasRange = m_YMin <= m_YMax;
+	object.SetAABB(AABB::Create(sol::Vec2f(total.xMin, hasRange ? m_YMin : view.min.position.y),
+		sol::Vec2f(total.xMax, hasRange ? m_YMax : view.max.position.y)));
+	if (file.Chunks() == 0)
+	{
+		return;
+	}
+	if (!m_VAO)
+	{
+		this->CreateStorage();
+	}
+	m_Frame++;
+
+	double xMin = view.min.position.x, xMax = view.max.position.x;
+	m_Visible.clear();
+	size_t first = 0, last = file.Chunks();
+	if (file.IsXSorted())
+	{
+		// chunk ranges are sorted as well, so visible chunks are a contiguous range
+		size_t low = 0, high = last;
+		while (low < high)
+		{
+			size_t middle = (low + high) / 2;
+			if (file.ChunkBounds(middle).xMax < xMin) low = middle + 1;
+			else high = middle;
+		}
+		first = low;
+		high = last;
+		while (low < high)
+		{
+			size_t middle = (low + high) / 2;
+			if (file.ChunkBounds(middle).xMin <= xMax) low = middle + 1;
+			else high = middle;
+		}
+		last = low;
+	}
+	for (size_t chunk = first; chunk < last; chunk++)
+	{
+		const ColumnFile::Bounds& bounds = file.ChunkBounds(chunk);
+		if (bounds.xMax >= xMin && bounds.xMin <= xMax)
+		{
+			m_Visible.push_back(chunk);
+		}
+	}
+
+	m_Stats.visibleChunks = m_Visible.size();
+	m_Stats.summary = m_Visible.size() > m_SlotChunks.size();
+	m_Wanted.clear();
+	if (!m_Stats.summary)
+	{
+		m_Wanted = m_Visible;
+		// Camera moves continuously, so the chunks next to the view are reached first, whichever way it pans or zooms out.
+		// Half of the visible width is prefetched on each side, nearest chunks first
+		if (file.IsXSorted() && first < last)
+		{
+			size_t margin = std::max<size_t>(1, m_Visible.size() / 2);
+			for (size_t i = 1; i <= margin; i++)
+			{
+				if (first >= i) m_Wanted.push_back(first - i);
+				if (last - 1 + i < file.Chunks()) m_Wanted.push_back(last - 1 + i);
+			}
+		}
+	}
+	m_Cache.Request(m_Wanted);
+	if (m_Stats.summary)
+	{
+		m_Stats.pendingChunks = 0;
+		return;
+	}
+
+	// Visible resident chunks are touched first, so that they are never evicted by other visible chunks
+	for (size_t chunk : m_Visible)
+	{
+		if (m_ChunkSlots[chunk] != s_None)
+		{
+			m_SlotFrames[m_ChunkSlots[chunk]] = m_Frame;
+		}
+	}
+	m_Stats.pendingChunks = 0;
+	for (size_t chunk : m_Visible)
+	{
+		if (m_ChunkSlots[chunk] != s_None)
+		{
+			continue;
+		}
+		std::shared_ptr<const PageCache::Page> page = m_Cache.Find(chunk);
+		if (!page)
+		{
+			m_Stats.pendingChunks++;
+			continue;
+		}
+		size_t slot = 0;
+		for (size_t i = 1; i < m_SlotChunks.size() && m_SlotChunks[slot] != s_None; i++)
+		{
+			if (m_SlotChunks[i] == s_None || m_SlotFrames[i] < m_SlotFrames[slot])
+			{
+				slot = i;
+			}
+		}
+		if (m_SlotChunks[slot] != s_None)
+		{
+			m_ChunkSlots[m_SlotChunks[slot]] = s_None;
+			m_Stats.residentChunks--;
+		}
+		this->Upload(*page, slot);
+		m_SlotChunks[slot] = chunk;
+		m_SlotFrames[slot] = m_Frame;
+		m_ChunkSlots[chunk] = slot;
+		m_Stats.residentChunks++;
+	}
+}
+
+bool PagedSeries::Draw(const Object& object, unsigned int renderMode)
+{
+	if (!m_VAO)
+	{
+		return true;
+	}
+	const ColumnFile& file = m_Cache.File();
+	glVertexAttrib4f(s_ColorAttribute, m_Color.r, m_Color.g, m_Color.b, m_Color.a);
+
+	// Each run of pending chunks is drawn as one range of the summary, that also reaches the first point of the next chunk
+	m_Firsts.clear();
+	m_Counts.clear();
+	m_SummaryFirsts.clear();
+	m_SummaryCounts.clear();
+	for (size_t i = 0; i < m_Visible.size(); i++)
+	{
+		size_t chunk = m_Visible[i];
+		bool hasNext = chunk + 1 < file.Chunks();
+		if (!m_Stats.summary && m_ChunkSlots[chunk] != s_None)
+		{
+			m_Firsts.push_back(m_ChunkSlots[chunk] * m_SlotPoints);
+			m_Counts.push_back(file.ChunkSize(chunk) + hasNext);
+			continue;
+		}
+		bool continues = !m_SummaryFirsts.empty() && i > 0 && m_Visible[i - 1] + 1 == chunk
+			&& (m_Stats.summary || m_ChunkSlots[m_Visible[i - 1]] == s_None);
+		if (continues)
+		{
+			m_SummaryCounts.back() = 2 * (chunk + 1) + hasNext - m_SummaryFirsts.back();
+		}
+		else
+		{
+			m_SummaryFirsts.push_back(2 * chunk);
+			m_SummaryCounts.push_back(2 + hasNext);
+		}
+	}
+
+	if (!m_Firsts.empty())
+	{
+		glBindVertexArray(m_VAO);
+		glMultiDrawArrays(renderMode, m_Firsts.data(), m_Counts.data(), m_Firsts.size());
+	}
+	if (!m_SummaryFirsts.empty())
+	{
+		glBindVertexArray(m_SummaryVAO);
+		glMultiDrawArrays(renderMode, m_SummaryFirsts.data(), m_SummaryCounts.data(), m_SummaryFirsts.size());
+	}
+	return true;
+}
+
+void PagedSeries::CreateStorage()
+{
+	const ColumnFile& file = m_Cache.File();
+	size_t xSize = ColumnFile::TypeSize(file.XType());
+	size_t ySize = ColumnFile::TypeSize(file.YType());
+	m_SlotPoints = file.ChunkPoints() + 1;
+	size_t slots = std::clamp<size_t>(m_GpuBudget / (m_SlotPoints * (xSize + ySize)), 1, file.Chunks());
+	m_SlotChunks.assign(slots, s_None);
+	m_SlotFrames.assign(slots, 0);
+	m_Stats.slots = slots;
+
+	glCreateBuffers(1, &m_XBuffer);
+	glCreateBuffers(1, &m_YBuffer);
+	glNamedBufferData(m_XBuffer, slots * m_SlotPoints * xSize, nullptr, GL_DYNAMIC_DRAW);
+	glNamedBufferData(m_YBuffer, slots * m_SlotPoints * ySize, nullptr, GL_DYNAMIC_DRAW);
+
+	glCreateVertexArrays(1, &m_VAO);
+	glEnableVertexArrayAttrib(m_VAO, s_XAttribute);
+	glVertexArrayAttribFormat(m_VAO, s_XAttribute, 1, GLType(file.XType()), GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_VAO, s_XAttribute, 0);
+	glVertexArrayVertexBuffer(m_VAO, 0, m_XBuffer, 0, xSize);
+	glEnableVertexArrayAttrib(m_VAO, s_YAttribute);
+	glVertexArrayAttribFormat(m_VAO, s_YAttribute, 1, GLType(file.YType()), GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_VAO, s_YAttribute, 1);
+	glVertexArrayVertexBuffer(m_VAO, 1, m_YBuffer, 0, ySize);
+
+	// Summary is a zig-zag through the bounds of each chunk. Unknown bounds are NaN, that break the line until the page is loaded
+	size_t summaryPoints = 2 * file.Chunks();
+	std::vector<float> summary(2 * summaryPoints);
+	float* xs = summary.data();
+	float* ys = summary.data() + summaryPoints;
+	for (size_t chunk = 0; chunk < file.Chunks(); chunk++)
+	{
+		const ColumnFile::Bounds& bounds = file.ChunkBounds(chunk);
+		xs[2 * chunk] = bounds.xMin;
+		ys[2 * chunk] = m_HasSummary[chunk] ? bounds.yMin : std::numeric_limits<float>::quiet_NaN();
+		xs[2 * chunk + 1] = bounds.xMax;
+		ys[2 * chunk + 1] = m_HasSummary[chunk] ? bounds.yMax : std::numeric_limits<float>::quiet_NaN();
+	}
+	glCreateBuffers(1, &m_SummaryBuffer);
+	glNamedBufferData(m_SummaryBuffer, summary.size() * sizeof(float), summary.data(), GL_DYNAMIC_DRAW);
+
+	glCreateVertexArrays(1, &m_SummaryVAO);
+	glEnableVertexArrayAttrib(m_SummaryVAO, s_XAttribute);
+	glVertexArrayAttribFormat(m_SummaryVAO, s_XAttribute, 1, GL_FLOAT, GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_SummaryVAO, s_XAttribute, 0);
+	glVertexArrayVertexBuffer(m_SummaryVAO, 0, m_SummaryBuffer, 0, sizeof(float));
+	glEnableVertexArrayAttrib(m_SummaryVAO, s_YAttribute);
+	glVertexArrayAttribFormat(m_SummaryVAO, s_YAttribute, 1, GL_FLOAT, GL_FALSE, 0);
+	glVertexArrayAttribBinding(m_SummaryVAO, s_YAttribute, 1);
+	glVertexArrayVertexBuffer(m_SummaryVAO, 1, m_SummaryBuffer, summaryPoints * sizeof(float), sizeof(float));
+
+	std::cout << "Paged series of " << file.Path() << " uses " << slots << " GPU slots of " << m_SlotPoints << " points and "
+		<< m_Cache.Budget() / (1024 * 1024) << " MB of memory\n";
+}
+
+void PagedSeries::Upload(const PageCache::Page& page, size_t slot)
+{
+	const ColumnFile& file = m_Cache.File();
+	size_t xSize = ColumnFile::TypeSize(file.XType());
+	size_t ySize = ColumnFile::TypeSize(file.YType());
+	glNamedBufferSubData(m_XBuffer, slot * m_SlotPoints * xSize, page.x.size(), page.x.data());
+	glNamedBufferSubData(m_YBuffer, slot * m_SlotPoints * ySize, page.y.size(), page.y.data());
+	m_Stats.uploadedBytes += page.x.size() + page.y.size();
+
+	// the page is read anyway, so its bounds complete the summary for files without stored y-bounds
+	if (!m_HasSummary[page.chunk] && page.yMin <= page.yMax)
+	{
+		float ys[2] = { static_cast<float>(page.yMin), static_cast<float>(page.yMax) };
+		glNamedBufferSubData(m_SummaryBuffer, (2 * file.Chunks() + 2 * page.chunk) * sizeof(float), sizeof(ys), ys);
+		m_HasSummary[page.chunk] = true;
+		// the object's AABB grows with the pages, that were seen so far. Visible pages are always loaded, so the view is covered
+		m_YMin = std::min(m_YMin, page.yMin);
+		m_YMax = std::max(m_YMax, page.yMax);
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+#include <Core/Series.h>
+#include <Utility/PageCache.h>
+#include <Utility/Matrix.h>
+
+/**
+ * 	PagedSeries is a Series, that draws a ColumnFile, which may be larger than RAM, without ever waiting for disk
+ *
+ * 	Points are stored on disk in pages, i.e. chunks of the file. There are three levels of residency:
+ * 	-	disk: the whole file, only read by the loader thread of the PageCache;
+ * 	-	memory: the PageCache, a bounded LRU of recently used pages;
+ * 	-	GPU: slots of one page each, that hold pages of the current view, the least recently visible slot is reused.
+ *
+ * 	Each update requests visible pages and pages around the view, that the camera is likely to reach next,
+ * 	and uploads visible pages, that have arrived to memory since. The render thread never reads the file.
+ * 	Visible pages, that are not on GPU yet, are drawn from the coarsest level, that is a min-max zig-zag
+ * 	over the chunk bounds, until their points arrive. The same summary is drawn for views, that don't fit the GPU slots.
+ * 	For files without stored y-bounds the summary of a chunk is known only after its page is loaded once.
+ * 	The object's AABB of such files spans the y-range of the pages, that were loaded so far, or the view, until the first page arrives.
+ *
+ * 	Compared to MappedSeries the file is never accessed through the mapping while drawing, so a slow disk
+ * 	causes coarse frames instead of stalls. Objects with this series must use a material with "Column" shader
+ */
+class PagedSeries : public Series
+{
+public:
+	struct Stats
+	{
+		size_t visibleChunks = 0;
+		// visible chunks, that are drawn from the summary, as their pages are not loaded yet
+		size_t pendingChunks = 0;
+		size_t residentChunks = 0;
+		size_t slots = 0;
+		size_t uploadedBytes = 0;
+		bool summary = false;
+	};
+public:
+	PagedSeries(std::shared_ptr<const ColumnFile> file, sol::Vec4f color, size_t memoryBudget = 256 * 1024 * 1024, size_t gpuBudget = 64 * 1024 * 1024);
+	PagedSeries(const PagedSeries&) = delete;
+	PagedSeries& operator=(const PagedSeries&) = delete;
+	// Deletes VAOs and VBOs. The loader thread is joined by the cache
+	~PagedSeries();
+
+	// Requests pages around the view and uploads visible pages, that are in memory
+	void Update(Object& object, const Camera& camera) override;
+	// Draws resident visible chunks and the summary of pending ones
+	bool Draw(const Object& object, unsigned int renderMode) override;
+
+	inline const ColumnFile& File() const { return m_Cache.File(); }
+	inline const PageCache& Cache() const { return m_Cache; }
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline const sol::Vec4f& Color() const { return m_Color; }
+	inline void SetColor(const sol::Vec4f& color) { m_Color = color; }
+private:
+	// creates OpenGL objects on the first update, as the series may be created before the context
+	void CreateStorage();
+	void Upload(const PageCache::Page& page, size_t slot);
+private:
+	PageCache m_Cache;
+	sol::Vec4f m_Color;
+	size_t m_GpuBudget;
+
+	size_t m_SlotPoints = 0;
+	// chunk of each slot or npos if the slot is free, and the frame the slot was visible last
+	std::vector<size_t> m_SlotChunks;
+	std::vector<size_t> m_SlotFrames;
+	// slot of each chunk or npos if the chunk isn't on GPU
+	std::vector<size_t> m_ChunkSlots;
+	// whether the summary of the chunk is known, i.e. the file has its y-bounds or its page was loaded
+	std::vector<bool> m_HasSummary;
+	// y-range of the file, or of the pages, that were loaded so far, if the file has no y-bounds. Empty until it is known
+	double m_YMin = std::numeric_limits<double>::max();
+	double m_YMax = std::numeric_limits<double>::lowest();
+	std::vector<size_t> m_Visible;
+	// visible chunks and chunks around the view in the order of priority
+	std::vector<size_t> m_Wanted;
+	size_t m_Frame = 0;
+
+	// arguments of glMultiDrawArrays() for resident chunks and the summary
+	std::vector<int> m_Firsts;
+	std::vector<int> m_Counts;
+	std::vector<int> m_SummaryFirsts;
+	std::vector<int> m_SummaryCounts;
+
+	unsigned int m_VAO = 0;
+	unsigned int m_XBuffer = 0;
+	unsigned int m_YBuffer = 0;
+	unsigned int m_SummaryVAO = 0;
+	unsigned int m_SummaryBuffer = 0;
+
+	Stats m_Stats;
+};
@@ -0,0 +1,146 @@
+#include <Core/RingSeries.h>
+#include <Core/Object.h>
+
+// attribute locations of Data/Scope.vert
+static constexpr unsigned int s_ColorAttribute = 1;
+static constexpr unsigned int s_YAttribute = 2;
+static constexpr unsigned int s_ScopeAttribute = 4;
+
+RingSeries::RingSeries(size_t capacity, float sampleInterval, sol::Vec4f color, size_t queueCapacity)
+: m_Capacity(std::max<size_t>(capacity, 2)), m_SampleInterval(sampleInterval), m_Color(color), m_Queue(queueCapacity)
+, m_YMin(std::numeric_limits<float>::max()), m_YMax(std::numeric_limits<float>::lowest())
+{
+}
+
+RingSeries::~RingSeries()
+{
+	if (m_VAO)
+	{
+		glDeleteVertexArrays(1, &m_VAO);
+		glDeleteBuffers(1, &m_VBO);
+	}
+}
+
+bool RingSeries::Push(Batch&& batch)
+{
+	if (batch.empty())
+	{
+		return true;
+	}
+	size_t count = batch.size();
+	if (!m_Queue.TryPush(std::move(batch)))
+	{
+		m_DroppedBatches.fetch_add(1, std::memory_order_relaxed);
+		m_DroppedSamples.fetch_add(count, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+bool RingSeries::Push(const float* samples, size_t count)
+{
+	return this->Push(Batch(samples, samples + count));
+}
+
+void RingSeries::Update(Object& object, const Camera& camera)
+{
+	if (!m_VAO)
+	{
+		// the extra slot mirrors slot 0
+		glCreateBuffers(1, &m_VBO);
+		glNamedBufferData(m_VBO, (m_Capacity + 1) * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+		glCreateVertexArrays(1, &m_VAO);
+		glEnableVertexArrayAttrib(m_VAO, s_YAttribute);
+		glVertexArrayAttribFormat(m_VAO, s_YAttribute, 1, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribBinding(m_VAO, s_YAttribute, 0);
+		glVertexArrayVertexBuffer(m_VAO, 0, m_VBO, 0, sizeof(float));
+	}
+
+	m_Staging.clear();
+	Batch batch;
+	// at most one lap of the queue is drained, so that fast producers can't stall the frame
+	for (size_t i = 0; i < m_Queue.Capacity() && m_Queue.TryPop(batch); i++)
+	{
+		m_Staging.insert(m_Staging.end(), batch.begin(), batch.end());
+	}
+	m_UploadedBytes = 0;
+	if (!m_Staging.empty())
+	{
+		m_Received += m_Staging.size();
+		// samples, that would be overwritten in the same frame, are never uploaded
+		size_t skipped = m_Staging.size() > m_Capacity ? m_Staging.size() - m_Capacity : 0;
+		m_Head = (m_Head + skipped) % m_Capacity;
+		for (size_t i = skipped; i < m_Staging.size(); i++)
+		{
+			// comparisons are false for NaN, so non-finite samples don't spoil the bounds
+			if (m_Staging[i] < m_YMin) m_YMin = m_Staging[i];
+			if (m_Staging[i] > m_YMax) m_YMax = m_Staging[i];
+		}
+		this->Write(m_Staging.data() + skipped, m_Staging.size() - skipped);
+	}
+
+	float width = (m_Capacity - 1) * m_SampleInterval;
+	if (m_Count == 0)
+	{
+		object.SetAABB(AABB::Create(sol::Vec2f(-width, 0.0f), sol::Vec2f(0.0f)));
+		return;
+	}
+	object.SetAABB(AABB::Create(sol::Vec2f(-width, m_YMin), sol::Vec2f(0.0f, m_YMax)));
+}
+
+bool RingSeries::Draw(const Object& object, unsigned int renderMode)
+{
+	if (m_Count == 0)
+	{
+		return true;
+	}
+	glBindVertexArray(m_VAO);
+	glVertexAttrib4f(s_ColorAttribute, m_Color.r, m_Color.g, m_Color.b, m_Color.a);
+
+	// x = offset + gl_VertexID * step, where the offset makes the newest sample, at head - 1, land at x = 0
+	size_t newest = m_Head == 0 ? m_Capacity - 1 : m_Head - 1;
+	if (m_Count == m_Capacity && m_Head > 0)
+	{
+		// older samples [head; N) and the mirrored slot N, that continues them to slot 0
+		glVertexAttrib2f(s_ScopeAttribute, -static_cast<float>(newest + m_Capacity) * m_SampleInterval, m_SampleInterval);
+		glDrawArrays(renderMode, m_Head, m_Capacity + 1 - m_Head);
+	}
+	// newer samples [0; head), or the whole ring, if the head has just wrapped
+	size_t count = m_Head == 0 ? m_Count : m_Head;
+	size_t first = m_Head == 0 ? m_Capacity - m_Count : 0;
+	glVertexAttrib2f(s_ScopeAttribute, -static_cast<float>(newest) * m_SampleInterval, m_SampleInterval);
+	glDrawArrays(renderMode, first, count);
+	return true;
+}
+
+RingSeries::Stats RingSeries::GetStats() const
+{
+	Stats stats;
+	stats.samples = m_Count;
+	stats.received = m_Received;
+	stats.droppedBatches = m_DroppedBatches.load(std::memory_order_relaxed);
+	stats.droppedSamples = m_DroppedSamples.load(std::memory_order_relaxed);
+	stats.uploadedBytes = m_UploadedBytes;
+	return stats;
+}
+
+void RingSeries::Write(const float* samples, size_t count)
+{
+	// DSA functions are used, so that buffer bindings of the renderer stay untouched
+	size_t first = std::min(count, m_Capacity - m_Head);
+	glNamedBufferSubData(m_VBO, m_Head * sizeof(float), first * sizeof(float), samples);
+	if (count > first)
+	{
+		glNamedBufferSubData(m_VBO, 0, (count - first) * sizeof(float), samples + first);
+	}
+	m_UploadedBytes += count * sizeof(float);
+	if (m_Head == 0 || count > first)
+	{
+		// slot 0 was written, so its mirror is updated as well
+		const float* zero = m_Head == 0 ? samples : samples + first;
+		glNamedBufferSubData(m_VBO, m_Capacity * sizeof(float), sizeof(float), zero);
+		m_UploadedBytes += sizeof(float);
+	}
+	m_Head = (m_Head + count) % m_Capacity;
+	m_Count = std::min(m_Capacity, m_Count + count);
+}
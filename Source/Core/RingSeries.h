@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <Core/Series.h>
+#include <Utility/MPSCQueue.h>
+#include <Utility/Matrix.h>
+
+/**
+ * 	RingSeries is an oscilloscope-like Series, that shows the last N samples of a live signal in a fixed window
+ *
+ * 	Producers push batches of y values with Push() from any thread, the same way as to <Core/StreamingSeries.h>.
+ * 	Samples are equally spaced: the newest sample is at x = 0 and older ones go to the left by the sample interval,
+ * 	so the window scrolls while the object itself and the camera stay still.
+ *
+ * 	GPU storage is a circular buffer of N y values. Each frame only the newly arrived samples are written over
+ * 	the oldest ones, with at most two glNamedBufferSubData() calls, so the upload cost is proportional to new samples.
+ * 	Nothing is shifted: the ring is drawn as two sub-ranges, [head; N) with the older samples and [0; head)
+ * 	with the newer ones. x is computed by the "Scope" shader from gl_VertexID and a per-draw offset and step,
+ * 	that are passed as a constant vertex attribute, the same way the color is passed.
+ * 	The buffer has one extra slot, that mirrors slot 0, so the line strip is continuous across the wrap.
+ *
+ * 	Y-bounds only grow, as recomputing them over the window would cost O(N) per frame.
+ * 	Objects with this series must use a material with "Scope" shader
+ */
+class RingSeries : public Series
+{
+public:
+	using Batch = std::vector<float>;
+
+	struct Stats
+	{
+		// samples in the window and samples, that were received in total
+		size_t samples = 0;
+		size_t received = 0;
+		size_t droppedBatches = 0;
+		size_t droppedSamples = 0;
+		// bytes, that were uploaded by the last update
+		size_t uploadedBytes = 0;
+	};
+public:
+	RingSeries(size_t capacity, float sampleInterval, sol::Vec4f color, size_t queueCapacity = 1024);
+	RingSeries(const RingSeries&) = delete;
+	RingSeries& operator=(const RingSeries&) = delete;
+	// Deletes VAO and VBO
+	~RingSeries();
+
+	// Producer side. Safe to call from any thread, never blocks. Returns false if the batch was dropped
+	bool Push(Batch&& batch);
+	bool Push(const float* samples, size_t count);
+
+	// Drains the queue and writes new samples into the ring
+	void Update(Object& object, const Camera& camera) override;
+	// Draws the window as two sub-ranges of the ring
+	bool Draw(const Object& object, unsigned int renderMode) override;
+
+	Stats GetStats() const;
+	inline size_t Capacity() const { return m_Capacity; }
+	inline float SampleInterval() const { return m_SampleInterval; }
+	inline const sol::Vec4f& Color() const { return m_Color; }
+	inline void SetColor(const sol::Vec4f& color) { m_Color = color; }
+private:
+	// writes count samples to the ring starting at the head, wrapping around the end
+	void Write(const float* samples, size_t count);
+private:
+	size_t m_Capacity;
+	float m_SampleInterval;
+	sol::Vec4f m_Color;
+	MPSCQueue<Batch> m_Queue;
+
+	// Written by producers only
+	std::atomic<size_t> m_DroppedBatches = 0;
+	std::atomic<size_t> m_DroppedSamples = 0;
+
+	// Render thread data
+	Batch m_Staging;
+	// index of the slot, that the next sample is written to
+	size_t m_Head = 0;
+	size_t m_Count = 0;
+	size_t m_Received = 0;
+	size_t m_UploadedBytes = 0;
+	float m_YMin;
+	float m_YMax;
+	unsigned int m_VAO = 0;
+	unsigned int m_VBO = 0;
+};
@@ -0,0 +1,78 @@
+#include <Core/SampleCache.h>
+
+SampleCache::SampleCache(size_t budget)
+: m_Budget(budget)
+{
+}
+
+const std::vector<float>* SampleCache::Find(const Key& key)
+{
+	auto iterator = m_Tiles.find(key);
+	if (iterator == m_Tiles.end())
+	{
+		m_Stats.misses++;
+		return nullptr;
+	}
+	m_Stats.hits++;
+	m_LRU.splice(m_LRU.begin(), m_LRU, iterator->second.lru);
+	return &iterator->second.samples;
+}
+
+const std::vector<float>& SampleCache::Insert(const Key& key, std::vector<float>&& samples)
+{
+	auto iterator = m_Tiles.find(key);
+	if (iterator != m_Tiles.end())
+	{
+		m_Stats.bytes -= iterator->second.samples.size() * sizeof(float);
+		iterator->second.samples = std::move(samples);
+		m_LRU.splice(m_LRU.begin(), m_LRU, iterator->second.lru);
+	}
+	else
+	{
+		m_LRU.push_front(key);
+		iterator = m_Tiles.emplace(key, Entry{ std::move(samples), m_LRU.begin() }).first;
+	}
+	m_Stats.bytes += iterator->second.samples.size() * sizeof(float);
+	m_Stats.tiles = m_Tiles.size();
+
+	// Never evict the tile, that has just been inserted
+	Evict();
+	return iterator->second.samples;
+}
+
+void SampleCache::Clear()
+{
+	m_Tiles.clear();
+	m_LRU.clear();
+	m_Stats.bytes = 0;
+	m_Stats.tiles = 0;
+}
+
+double SampleCache::SampleX(const Key& key, size_t k)
+{
+	return std::ldexp(static_cast<double>(key.index) * TileSamples + k, key.level);
+}
+
+double SampleCache::TileWidth(int level)
+{
+	return std::ldexp(static_cast<double>(TileSamples), level);
+}
+
+void SampleCache::SetBudget(size_t budget)
+{
+	m_Budget = budget;
+	Evict();
+}
+
+void SampleCache::Evict()
+{
+	while (m_Stats.bytes > m_Budget && m_LRU.size() > 1)
+	{
+		auto iterator = m_Tiles.find(m_LRU.back());
+		m_Stats.bytes -= iterator->second.samples.size() * sizeof(float);
+		m_Tiles.erase(iterator);
+		m_LRU.pop_back();
+		m_Stats.evictions++;
+	}
+	m_Stats.tiles = m_Tiles.size();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <list>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * 	SampleCache stores evaluated samples of a function y = f(x) as a pyramid of tiles over x, like mipmaps.
+ *
+ * 	Tile at (level, index) holds TileSamples + 1 values of f at x = (index * TileSamples + k) * 2^level,
+ * 	k in [0; TileSamples]. The last sample duplicates the first sample of the next tile, so that tiles
+ * 	can be stitched together without gaps. The finer the level, the smaller the distance between samples
+ *
+ * 	Tiles are evicted in least-recently-used order when the memory budget is exceeded.
+ * 	Cache is not thread-safe and is meant to be used from the render thread only
+ */
+class SampleCache
+{
+public:
+	static constexpr size_t TileSamples = 256;
+
+	struct Key
+	{
+		int level;
+		long long index;
+
+		bool operator==(const Key& other) const { return level == other.level && index == other.index; }
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const
+		{
+			return std::hash<long long>{}(key.index) ^ (std::hash<int>{}(key.level) << 1);
+		}
+	};
+
+	struct Stats
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+		size_t bytes = 0;
+		size_t tiles = 0;
+
+		inline float HitRate() const { return hits + misses == 0 ? 0.0f : static_cast<float>(hits) / (hits + misses); }
+	};
+public:
+	SampleCache(size_t budget = 64 * 1024 * 1024);
+
+	// returns the tile and marks it as most recently used. nullptr is returned if there is no such tile
+	const std::vector<float>* Find(const Key& key);
+	// checks whether the tile is cached without touching LRU order and statistics
+	inline bool Contains(const Key& key) const { return m_Tiles.find(key) != m_Tiles.end(); }
+	// inserts the tile and evicts least recently used tiles, if cache is over budget
+	const std::vector<float>& Insert(const Key& key, std::vector<float>&& samples);
+	// removes all tiles. Statistics are preserved
+	void Clear();
+
+	// x coordinate of the sample k of tile key
+	static double SampleX(const Key& key, size_t k);
+	// width of a tile at level
+	static double TileWidth(int level);
+
+	// Getters and setters
+	inline size_t Budget() const { return m_Budget; }
+	void SetBudget(size_t budget);
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline void ResetStats() { m_Stats.hits = m_Stats.misses = m_Stats.evictions = 0; }
+private:
+	void Evict();
+private:
+	struct Entry
+	{
+		std::vector<float> samples;
+		std::list<Key>::iterator lru;
+	};
+
+	size_t m_Budget;
+	Stats m_Stats;
+	// front is the most recently used tile
+	std::list<Key> m_LRU;
+	std::unordered_map<Key, Entry, KeyHash> m_Tiles;
+};
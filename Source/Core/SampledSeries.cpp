@@ -0,0 +1,126 @@
+#include <Core/SampledSeries.h>
+#include <Core/Camera.h>
+#include <Core/Object.h>
+
+static bool CompareX(const Vertex& vertex, float x)
+{
+	return vertex.position.x < x;
+}
+
+// Amount of pixel columns, that the local x-range [xMin; xMax] of the object spans on screen.
+// Equals the viewport width for unrotated objects, rotated ones are measured along their x-axis
+static size_t Columns(const Object& object, const Camera& camera, float xMin, float xMax)
+{
+	const sol::Affine2f model = object.ModelMat();
+	sol::Vec2f a = model * sol::Vec2f(xMin, 0.0f);
+	sol::Vec2f b = model * sol::Vec2f(xMax, 0.0f);
+	float length = std::hypot(b.x - a.x, b.y - a.y);
+	float width = camera.aabb.max.position.x - camera.aabb.min.position.x;
+	float pixels = width > 0.0f ? length * camera.viewport.x / width : camera.viewport.x;
+	// the x-axis never spans more than the diagonal of the viewport, unless the view is degenerate
+	float diagonal = std::hypot(camera.viewport.x, camera.viewport.y);
+	return std::max<size_t>(1, static_cast<size_t>(std::ceil(std::min(pixels, diagonal))));
+}
+
+SampledSeries::SampledSeries(std::vector<Vertex>&& input)
+{
+	std::shared_ptr<Data> data = std::make_shared<Data>();
+	std::vector<Vertex>& vertices = data->vertices;
+	vertices = std::move(input);
+	sol::Vec2f min = sol::Vec2f(std::numeric_limits<float>::max());
+	sol::Vec2f max = sol::Vec2f(std::numeric_limits<float>::lowest());
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const sol::Vec2f& p = vertices[i].position;
+		min = sol::Vec2f(std::min(min.x, p.x), std::min(min.y, p.y));
+		max = sol::Vec2f(std::max(max.x, p.x), std::max(max.y, p.y));
+		// NaN x is unsorted as well, as binary search can't skip it
+		if (i > 0 && !(p.x >= vertices[i - 1].position.x))
+		{
+			m_IsSorted = false;
+		}
+	}
+	if (min.x > max.x)
+	{
+		min = max = sol::Vec2f(0.0f);
+	}
+	m_AABB = AABB::Create(min, max);
+
+	if (m_IsSorted)
+	{
+		data->pyramid.Build(vertices.data(), vertices.size());
+	}
+	else
+	{
+		m_Stride = (vertices.size() + s_UnsortedPoints - 1) / s_UnsortedPoints;
+		std::cout << "Sampled series of " << vertices.size() << " points isn't sorted by x, it will be drawn decimated, every "
+			<< m_Stride << " point\n";
+	}
+	m_Data = std::move(data);
+}
+
+std::shared_ptr<Series> SampledSeries::Clone() const
+{
+	return std::make_shared<SampledSeries>(*this);
+}
+
+void SampledSeries::Update(Object& object, const Camera& camera)
+{
+	const std::vector<Vertex>& vertices = m_Data->vertices;
+	const MinMaxPyramid& pyramid = m_Data->pyramid;
+	object.SetAABB(m_AABB);
+	std::vector<Vertex>& output = object.Vertices();
+	if (!m_IsSorted)
+	{
+		// the decimated polyline doesn't depend on the view, so it is emitted once
+		if (output.empty() && !vertices.empty())
+		{
+			output.reserve(vertices.size() / m_Stride + 1);
+			for (size_t i = 0; i < vertices.size(); i += m_Stride)
+			{
+				output.push_back(vertices[i]);
+			}
+			m_Emitted = output.size();
+		}
+		return;
+	}
+
+	// Pixel columns are taken in the object's local space, where x is the data x, so rotated objects are aggregated
+	// along their own x-axis. The view is the local bounding box of the camera's view then, that is wider than the view itself
+	AABB view = camera.LocalAABB(object);
+	float xMin = view.min.position.x, xMax = view.max.position.x;
+	size_t columns = ::Columns(object, camera, xMin, xMax);
+	if (xMin == m_XMin && xMax == m_XMax && columns == m_Columns && !output.empty())
+	{
+		return;
+	}
+	m_XMin = xMin;
+	m_XMax = xMax;
+	m_Columns = columns;
+
+	output.clear();
+	size_t first = std::lower_bound(vertices.begin(), vertices.end(), xMin, CompareX) - vertices.begin();
+	size_t last = std::upper_bound(vertices.begin(), vertices.end(), xMax, [](float x, const Vertex& vertex) { return x < vertex.position.x; }) - vertices.begin();
+	// neighbours outside of the view
+	size_t begin = first > 0 ? first - 1 : first;
+	size_t end = std::min(vertices.size(), last + 1);
+
+	if (end - begin <= 4 * columns)
+	{
+		output.assign(vertices.begin() + begin, vertices.begin() + end);
+		m_Emitted = output.size();
+		return;
+	}
+
+	output.reserve(4 * columns + 2);
+	if (begin < first)
+	{
+		output.push_back(vertices[begin]);
+	}
+	pyramid.Aggregate(vertices.data(), first, last, xMin, xMax, columns, output);
+	if (last < end)
+	{
+		output.push_back(vertices[last]);
+	}
+	m_Emitted = output.size();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <Core/Series.h>
+#include <Utility/AABB.h>
+#include <Utility/MinMaxPyramid.h>
+
+/**
+ * 	SampledSeries is a Series, that owns a large x-sorted polyline and draws it with M4 aggregation
+ *
+ * 	The visible x-range is split into pixel columns and for each column only 4 points are emitted:
+ * 	the first, the last and the points with the minimum and the maximum y, in their original order.
+ * 	A line strip through these points rasterizes to the same pixels as the full polyline, while the amount of vertices
+ * 	is bounded by 4 times the amount of pixel columns, i.e. the viewport width, regardless of the data size.
+ * 	Column ranges are found with binary search over x and extrema with a MinMaxPyramid, that is built once on creation,
+ * 	so regenerating the object's vertices costs O(width * log n)
+ *
+ * 	If the visible range contains less than 4 points per column, it is emitted as it is.
+ * 	Points just outside of the view are emitted as well, so that the polyline enters the view from its edges.
+ * 	Vertices are regenerated only when the view or the viewport width changes.
+ *
+ * 	Rotated objects are aggregated along their own x-axis, with as many columns as the visible part of the axis spans pixels.
+ * 	Unsorted data can't be aggregated, so it is decimated once to at most s_UnsortedPoints points, i.e. every n-th point is drawn
+ */
+class SampledSeries : public Series
+{
+public:
+	static constexpr size_t s_UnsortedPoints = 1 << 16;
+public:
+	// Takes the vertices over. Checks whether x is sorted and builds the pyramid
+	SampledSeries(std::vector<Vertex>&& vertices);
+
+	// Emits the aggregated visible range into the object's vertex array
+	void Update(Object& object, const Camera& camera) override;
+	// The copy shares the points and the pyramid, only the view, that its object was emitted for, is its own
+	std::shared_ptr<Series> Clone() const override;
+
+	// Getters
+	inline const std::vector<Vertex>& Vertices() const { return m_Data->vertices; }
+	inline const MinMaxPyramid& Pyramid() const { return m_Data->pyramid; }
+	inline const AABB& GetAABB() const { return m_AABB; }
+	inline bool IsSorted() const { return m_IsSorted; }
+	// amount of vertices, that were emitted by the last update
+	inline size_t Emitted() const { return m_Emitted; }
+private:
+	// points are never modified after creation, so they are shared by copies of the series
+	struct Data
+	{
+		std::vector<Vertex> vertices;
+		MinMaxPyramid pyramid;
+	};
+private:
+	std::shared_ptr<const Data> m_Data;
+	AABB m_AABB;
+	bool m_IsSorted = true;
+	// step between points, that are drawn, of unsorted data
+	size_t m_Stride = 1;
+
+	// view, that the object's vertices were emitted for
+	float m_XMin = 0.0f;
+	float m_XMax = 0.0f;
+	size_t m_Columns = 0;
+	size_t m_Emitted = 0;
+};
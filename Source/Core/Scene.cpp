@@ -0,0 +1,118 @@
+#include <Core/Scene.h>
+#include <Core/Object.h>
+#include <Utility/SceneFile.h>
+
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+
+Scene::Result Scene::Save(const ObjectHandler& handler, const std::string& path)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Result result;
+	SceneWriter writer(path);
+
+	std::unordered_map<const Material*, uint32_t> materials;
+	for (const auto& [name, material] : handler.Materials())
+	{
+		materials[&material] = writer.AddMaterial(name, material.GetShader().Name(), material.GetRenderMode());
+	}
+
+	for (const Object& object : handler.Objects())
+	{
+		if (object.GetSeries())
+		{
+			result.skipped++;
+			continue;
+		}
+		SceneFile::ObjectRecord record = {};
+		record.angle = object.Angle();
+		std::memcpy(record.scale, &object.Scale(), sizeof(record.scale));
+		std::memcpy(record.transform, &object.Transform(), sizeof(record.transform));
+		record.flags = (object.Collider() ? static_cast<uint32_t>(SceneFile::ObjectFlags_Collider) : 0u)
+			| (object.IsSealed() ? static_cast<uint32_t>(SceneFile::ObjectFlags_Sealed) : 0u)
+			| (object.RenderAABB() ? static_cast<uint32_t>(SceneFile::ObjectFlags_RenderAABB) : 0u)
+			| (object.IsSortedX() ? static_cast<uint32_t>(SceneFile::ObjectFlags_SortedX) : 0u);
+		if (object.HasAABB())
+		{
+			record.flags |= SceneFile::ObjectFlags_AABB;
+			const AABB& aabb = object.GetAABB();
+			std::memcpy(record.aabbMin, &aabb.min.position, sizeof(record.aabbMin));
+			std::memcpy(record.aabbMax, &aabb.max.position, sizeof(record.aabbMax));
+		}
+		auto material = materials.find(object.GetMaterial());
+		record.material = material == materials.end() ? SceneFile::s_NoMaterial : material->second;
+		std::memcpy(record.uuid, object.GetUUID().data(), std::min(object.GetUUID().size(), sizeof(record.uuid)));
+
+		writer.AddObject(record, object.Vertices().data(), object.Vertices().size());
+		result.objects++;
+		result.vertices += object.Vertices().size();
+	}
+	writer.Close();
+
+	result.bytes = writer.Bytes();
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+Scene::Result Scene::Load(ObjectHandler& handler, const std::string& path, bool replace)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Result result;
+	SceneFile file(path);
+	if (replace)
+	{
+		// objects with a series aren't saved, so they aren't replaced either. Their sources, e.g. served streams, keep feeding them
+		ObjectHandler::Object_Array& objects = handler.Objects();
+		objects.erase(std::remove_if(objects.begin(), objects.end(), [](const Object& object) { return !object.GetSeries(); }), objects.end());
+		handler.SetCurrentIndex(-1);
+	}
+
+	std::vector<Material*> materials(file.Materials());
+	for (size_t i = 0; i < file.Materials(); i++)
+	{
+		std::string name = file.MaterialName(i);
+		materials[i] = handler.FindMaterial(name);
+		if (!materials[i])
+		{
+			materials[i] = handler.AddMaterial(name, Material(file.ShaderName(i), file.GetMaterial(i).renderMode));
+		}
+	}
+
+	// the array is grown once instead of reallocating while loading
+	ObjectHandler::Object_Array& objects = handler.Objects();
+	objects.reserve(objects.size() + file.Objects());
+	for (size_t i = 0; i < file.Objects(); i++)
+	{
+		const SceneFile::ObjectRecord& record = file.GetObject(i);
+		const Vertex* vertices = file.ObjectVertices(record);
+		Material* material = record.material == SceneFile::s_NoMaterial ? nullptr : materials[record.material];
+		Object object = Object(std::vector<Vertex>(vertices, vertices + record.vertexCount), material
+			, UUID::uuid(record.uuid, strnlen(record.uuid, sizeof(record.uuid))), record.flags & SceneFile::ObjectFlags_Collider);
+
+		object.Angle() = record.angle;
+		object.Scale() = sol::Vec3f(record.scale[0], record.scale[1], record.scale[2]);
+		object.Transform() = sol::Vec3f(record.transform[0], record.transform[1], record.transform[2]);
+		object.SetSealed(record.flags & SceneFile::ObjectFlags_Sealed);
+		object.RenderAABB() = record.flags & SceneFile::ObjectFlags_RenderAABB;
+		if (record.flags & SceneFile::ObjectFlags_AABB)
+		{
+			// AABB takes the color of the first vertex, as AABB::Create() does for vertex arrays
+			sol::Vec2f min = sol::Vec2f(record.aabbMin[0], record.aabbMin[1]);
+			sol::Vec2f max = sol::Vec2f(record.aabbMax[0], record.aabbMax[1]);
+			object.SetAABB(record.vertexCount > 0 ? AABB::Create(min, max, vertices[0].color) : AABB::Create(min, max));
+		}
+		// the flag is verified instead of trusted, as drawing unsorted vertices as sorted would cut them
+		if (record.flags & SceneFile::ObjectFlags_SortedX)
+		{
+			object.DetectSortedX();
+		}
+		objects.push_back(std::move(object));
+		result.objects++;
+		result.vertices += record.vertexCount;
+	}
+
+	result.bytes = file.Bytes();
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
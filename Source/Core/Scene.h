@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+class ObjectHandler;
+
+/**
+ * 	Namespace, that saves objects of an ObjectHandler to a scene file and restores them
+ *
+ * 	Objects are stored with their vertices, transforms, flags, AABB, UUID and the name of their material.
+ * 	Materials are referred to by name: on load a material is taken from the handler if it has one with the same name,
+ * 	otherwise it is created from the stored shader name and render mode.
+ *
+ * 	Objects with a Series aren't saved, as their vertices are generated from a source, that is not a part of the scene,
+ * 	e.g. a function, a stream or a column file. Uniform callbacks aren't saved either, restored objects use the default one.
+ * 	Functions throw std::runtime_error on I/O errors and malformed files. For the file layout @see @ref <Utility/SceneFile.h>
+ */
+namespace Scene
+{
+	struct Result
+	{
+		size_t objects = 0;
+		size_t vertices = 0;
+		// objects, that were not saved, as they have a Series
+		size_t skipped = 0;
+		size_t bytes = 0;
+		double seconds = 0.0;
+	};
+
+	Result Save(const ObjectHandler& handler, const std::string& path);
+	// Appends objects of the file to the handler, or replaces them, once the file is validated, if replace is true.
+	// Objects with a Series are never replaced, as they are never saved.
+	// Should be called on the thread with OpenGL context, as materials may be created
+	Result Load(ObjectHandler& handler, const std::string& path, bool replace = false);
+};
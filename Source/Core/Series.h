@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+class Object;
+class Camera;
+
+/**
+ * 	Series is a source of vertex data, that can be attached to an Object.
+ *
+ * 	Ordinary objects hold a fixed array of vertices. Objects with a series attached are also updated
+ * 	by the renderer once per frame before culling, so that the series may (re)generate the object's vertices
+ * 	and AABB according to the camera. The object itself is still culled, transformed and rendered as usual.
+ *
+ * 	Series may also keep its vertices in its own GPU storage and draw the object itself with Draw(),
+ * 	so that the renderer does not upload the object's vertex array each frame, e.g. <Core/StreamingSeries.h>
+ *
+ * 	Copies of an object get the series from Clone(). Series, that keep per-object state, e.g. the view, that the object's vertices
+ * 	were generated for, return a copy of themselves, others are shared between copies of an object, e.g. series, that own GPU storage.
+ * 	Update() and Draw() are always called from the render thread
+ * 	For a reference see curves in <Core/Curve.h>
+ */
+class Series
+{
+public:
+	virtual ~Series() = default;
+
+	// Called each frame before the object is culled
+	virtual void Update(Object& object, const Camera& camera) = 0;
+	// Called instead of uploading the object's vertices, when the object's shader is bound and its uniforms are set
+	// Returns false if the renderer should upload and draw the object's vertex array as usual
+	virtual bool Draw(const Object& object, unsigned int renderMode) { return false; }
+	// Returns the series for a copy of the object, or nullptr if the copy shares this series
+	virtual std::shared_ptr<Series> Clone() const { return nullptr; }
+};
@@ -0,0 +1,165 @@
+#include <Core/StreamingSeries.h>
+#include <Core/Object.h>
+
+// GPU storage never starts smaller than this amount of points
+static constexpr size_t s_MinCapacity = 4096;
+
+StreamingSeries::StreamingSeries(sol::Vec4f color, size_t queueCapacity)
+: m_Color(color), m_Queue(queueCapacity)
+, m_Min(std::numeric_limits<float>::max()), m_Max(std::numeric_limits<float>::lowest())
+{
+}
+
+StreamingSeries::~StreamingSeries()
+{
+	if (m_VAO)
+	{
+		glDeleteVertexArrays(1, &m_VAO);
+	}
+	if (m_VBO)
+	{
+		glDeleteBuffers(1, &m_VBO);
+	}
+}
+
+bool StreamingSeries::Push(Batch&& batch)
+{
+	if (batch.empty())
+	{
+		return true;
+	}
+	size_t count = batch.size();
+	if (!m_Queue.TryPush(std::move(batch)))
+	{
+		m_DroppedBatches.fetch_add(1, std::memory_order_relaxed);
+		m_DroppedPoints.fetch_add(count, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+bool StreamingSeries::Push(const sol::Vec2f* points, size_t count)
+{
+	return this->Push(Batch(points, points + count));
+}
+
+void StreamingSeries::Update(Object& object, const Camera& camera)
+{
+	if (this->Drain() > 0)
+	{
+		this->Upload();
+	}
+
+	if (m_Count == 0)
+	{
+		// the object is still culled and collided, so it needs some AABB before the first points arrive
+		object.SetAABB(AABB::Create(sol::Vec2f(0.0f), sol::Vec2f(0.0f)));
+		return;
+	}
+	object.SetAABB(AABB::Create(m_Min, m_Max));
+}
+
+bool StreamingSeries::Draw(const Object& object, unsigned int renderMode)
+{
+	if (m_Count == 0)
+	{
+		return true;
+	}
+	glBindVertexArray(m_VAO);
+	// color attribute array is disabled in the series' VAO, so the constant value is used for every vertex
+	glVertexAttrib4f(1, m_Color.r, m_Color.g, m_Color.b, m_Color.a);
+	glDrawArrays(renderMode, 0, m_Count);
+	return true;
+}
+
+size_t StreamingSeries::Drain()
+{
+	m_Staging.clear();
+	sol::Vec2f min = m_Min, max = m_Max;
+	Batch batch;
+	// at most one lap of the queue is drained, so that fast producers can't stall the frame
+	for (size_t i = 0; i < m_Queue.Capacity() && m_Queue.TryPop(batch); i++)
+	{
+		for (const sol::Vec2f& p : batch)
+		{
+			// comparisons are false for NaN, so non-finite coordinates don't spoil the bounds
+			if (p.x < min.x) min.x = p.x;
+			if (p.y < min.y) min.y = p.y;
+			if (p.x > max.x) max.x = p.x;
+			if (p.y > max.y) max.y = p.y;
+		}
+		m_Staging.insert(m_Staging.end(), batch.begin(), batch.end());
+		m_Batches++;
+	}
+	m_Min = min;
+	m_Max = max;
+	return m_Staging.size();
+}
+
+void StreamingSeries::Clear()
+{
+	this->Drain();
+	m_Staging.clear();
+	m_Count = 0;
+	m_Min = sol::Vec2f(std::numeric_limits<float>::max());
+	m_Max = sol::Vec2f(std::numeric_limits<float>::lowest());
+}
+
+StreamingSeries::Stats StreamingSeries::GetStats() const
+{
+	Stats stats;
+	stats.points = m_Count;
+	stats.batches = m_Batches;
+	stats.droppedBatches = m_DroppedBatches.load(std::memory_order_relaxed);
+	stats.droppedPoints = m_DroppedPoints.load(std::memory_order_relaxed);
+	stats.bytes = m_Capacity * sizeof(sol::Vec2f);
+	return stats;
+}
+
+void StreamingSeries::Upload()
+{
+	if (m_Staging.empty())
+	{
+		return;
+	}
+	this->Reserve(m_Count + m_Staging.size());
+	// DSA functions are used, so that buffer bindings of the renderer stay untouched
+	glNamedBufferSubData(m_VBO, m_Count * sizeof(sol::Vec2f), m_Staging.size() * sizeof(sol::Vec2f), m_Staging.data());
+	m_Count += m_Staging.size();
+	m_Staging.clear();
+}
+
+void StreamingSeries::Reserve(size_t points)
+{
+	if (!m_VAO)
+	{
+		glCreateVertexArrays(1, &m_VAO);
+		glEnableVertexArrayAttrib(m_VAO, 0);
+		glVertexArrayAttribFormat(m_VAO, 0, 2, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribBinding(m_VAO, 0, 0);
+	}
+	if (points <= m_Capacity)
+	{
+		return;
+	}
+
+	size_t capacity = std::max(m_Capacity, s_MinCapacity);
+	while (capacity < points)
+	{
+		capacity *= 2;
+	}
+	std::cout << "Growing streaming VBO to " << capacity << " points\n";
+
+	unsigned int buffer;
+	glCreateBuffers(1, &buffer);
+	glNamedBufferData(buffer, capacity * sizeof(sol::Vec2f), nullptr, GL_DYNAMIC_DRAW);
+	if (m_VBO)
+	{
+		// already uploaded points are copied on GPU instead of being uploaded again
+		glCopyNamedBufferSubData(m_VBO, buffer, 0, 0, m_Count * sizeof(sol::Vec2f));
+		glDeleteBuffers(1, &m_VBO);
+	}
+	m_VBO = buffer;
+	m_Capacity = capacity;
+	glVertexArrayVertexBuffer(m_VAO, 0, m_VBO, 0, sizeof(sol::Vec2f));
+}
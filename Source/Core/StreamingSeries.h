@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <Core/Series.h>
+#include <Utility/MPSCQueue.h>
+#include <Utility/Matrix.h>
+
+/**
+ * 	StreamingSeries is a Series of live points, that are pushed by producer threads
+ *
+ * 	Producers push batches of points with Push() from any thread. Batches go through a bounded lock-free queue,
+ * 	so producers never block on the render thread. If the queue is full, the batch is dropped and counted in Stats.
+ * 	Batching matters: a queue operation per point would cost more than the point itself at millions of points per second
+ *
+ * 	The render thread drains the queue once per frame in Update(), appends the new points to the series' own
+ * 	GPU buffer with a single glNamedBufferSubData() call and extends the object's AABB with the new points only.
+ * 	Points are never uploaded twice: the buffer grows twice as big with a GPU-side copy, when the points don't fit.
+ * 	Only positions are stored on GPU, color is a constant vertex attribute, that is set in Draw()
+ *
+ * 	The object's vertex array stays empty, the series draws the object itself.
+ * 	The series owns OpenGL objects, so it must be destroyed while the OpenGL context is alive
+ */
+class StreamingSeries : public Series
+{
+public:
+	using Batch = std::vector<sol::Vec2f>;
+
+	struct Stats
+	{
+		// points, that are uploaded to GPU
+		size_t points = 0;
+		size_t batches = 0;
+		size_t droppedBatches = 0;
+		size_t droppedPoints = 0;
+		// size of GPU storage in bytes
+		size_t bytes = 0;
+	};
+public:
+	StreamingSeries(sol::Vec4f color, size_t queueCapacity = 1024);
+	StreamingSeries(const StreamingSeries&) = delete;
+	StreamingSeries& operator=(const StreamingSeries&) = delete;
+	// Deletes VAO and VBO
+	~StreamingSeries();
+
+	// Producer side. Safe to call from any thread, never blocks. Returns false if the batch was dropped
+	bool Push(Batch&& batch);
+	bool Push(const sol::Vec2f* points, size_t count);
+
+	// Drains the queue, uploads new points and updates the object's AABB
+	void Update(Object& object, const Camera& camera) override;
+	// Draws all uploaded points with the currently bound shader
+	bool Draw(const Object& object, unsigned int renderMode) override;
+
+	// Moves all queued batches into the staging array and extends the bounds with them. Doesn't touch OpenGL
+	// Returns the amount of drained points
+	size_t Drain();
+	// Discards queued and uploaded points, GPU storage is kept for the next ones. Must be called from the render thread
+	void Clear();
+
+	Stats GetStats() const;
+	inline const sol::Vec4f& Color() const { return m_Color; }
+	inline void SetColor(const sol::Vec4f& color) { m_Color = color; }
+	inline sol::Vec2f Min() const { return m_Min; }
+	inline sol::Vec2f Max() const { return m_Max; }
+private:
+	// Appends the staging array to GPU storage
+	void Upload();
+	// Makes sure GPU storage fits at least points points, keeping the uploaded ones
+	void Reserve(size_t points);
+private:
+	sol::Vec4f m_Color;
+	MPSCQueue<Batch> m_Queue;
+
+	// Written by producers only
+	std::atomic<size_t> m_DroppedBatches = 0;
+	std::atomic<size_t> m_DroppedPoints = 0;
+
+	// Render thread data
+	Batch m_Staging;
+	sol::Vec2f m_Min;
+	sol::Vec2f m_Max;
+	size_t m_Batches = 0;
+	size_t m_Count = 0;
+	size_t m_Capacity = 0;
+	unsigned int m_VAO = 0;
+	unsigned int m_VBO = 0;
+};
@@ -1,5 +1,6 @@
 #include <Core/Window.h>
 #include <Renderer.h>
+#include <Utility/Profiler.h>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
@@ -69,26 +70,35 @@ void Window::Open()
 	std::cout << "Window is opening. Creating rendering context\n";
 
 	CreateRenderContext();
+	PROFILE_THREAD("Render");
 
 	while (!glfwWindowShouldClose(m_Window))
 	{
+		PROFILE_ZONE("Frame");
 		glClear(GL_COLOR_BUFFER_BIT);
 		glClearColor(0.11f, 0.11f, 0.12f, 1.0f);
 
-		m_FrameCallback(this);
+		{
+			PROFILE_ZONE("FrameCallback");
+			m_FrameCallback(this);
+		}
 
 		// std::cout << "Render frame in Window\n";
 		RenderContext()->Update();
 
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
-		ImGui::NewFrame();
+		{
+			PROFILE_ZONE("ImGui");
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplGlfw_NewFrame();
+			ImGui::NewFrame();
 
-		// std::cout << "ImGui frame in Window\n";
-		RenderContext()->ImGuiUpdate(io);
+			// std::cout << "ImGui frame in Window\n";
+			RenderContext()->ImGuiUpdate(io);
 
-		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			ImGui::Render();
+			GpuProfiler::Scope scope(RenderContext()->GetProfiler(), "ImGui");
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		}
 
 		// Update and Render additional Platform Windows
         // (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
@@ -103,8 +113,14 @@ void Window::Open()
 
 		glViewport(0, 0, m_Width, m_Height);
 
-		glfwSwapBuffers(m_Window);
-		glfwPollEvents();
+		{
+			PROFILE_ZONE("SwapBuffers");
+			glfwSwapBuffers(m_Window);
+		}
+		{
+			PROFILE_ZONE("PollEvents");
+			glfwPollEvents();
+		}
 	}
 }
 
@@ -1,6 +1,19 @@
 #include <Renderer.h>
 #include <Core/Window.h>
 #include <Core/Object.h>
+#include <Core/Curve.h>
+#include <Core/FunctionCurve.h>
+#include <Core/StreamingSeries.h>
+#include <Core/MappedSeries.h>
+#include <Core/SampledSeries.h>
+#include <Core/PagedSeries.h>
+#include <Core/DensitySeries.h>
+#include <Core/RingSeries.h>
+#include <Core/ChannelSeries.h>
+#include <Core/Scene.h>
+#include <Utility/VertexTransform.h>
+#include <Utility/Profiler.h>
+#include <array>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
@@ -8,7 +21,9 @@
 
 sol::Mat4f projection;
 sol::Mat4f view;
-sol::Mat4f model;
+
+// capacity of the message queue of the series server and of the queues of served series
+static constexpr size_t s_ServerQueueCapacity = 4096;
 
 // Simple scene setup function
 static void LoadScene(Renderer* renderer);
@@ -19,12 +34,38 @@ static void ImGuiMaterialControlMenu(ObjectHandler& handler, bool* materialCreat
 static void ImGuiObjectCreationMenu(ObjectHandler& handler, bool* objectCreation);
 static void ImGuiMaterialCreationMenu(ObjectHandler& handler, bool* materialCreation);
 static void ImGuiCursorInfoMenu(ObjectHandler& handler, const sol::Vec2f cursorPos);
+static void ImGuiSampleCacheMenu(ObjectHandler& handler);
+static void ImGuiAnalysisMenu(Renderer* renderer, const sol::Vec2f cursorPos);
+static void ImGuiStreamingMenu(Renderer* renderer);
+static void ImGuiDataFilesMenu(Renderer* renderer);
+static void ImGuiSceneMenu(ObjectHandler& handler);
+static void ImGuiProfilerMenu(Renderer* renderer);
+static void ImGuiCpuProfilerMenu();
 
 // Overall data
 Renderer::Renderer(Window* const window, size_t vertices)
-: m_Window(window), m_Camera(window->AspectRatio()), m_Vertices(vertices), m_ObjectHandler(std::make_unique<ObjectHandler>())
+: Renderer(window, sol::Vec2f(window->Width(), window->Height()), vertices)
+{
+}
+
+Renderer::Renderer(int width, int height, size_t vertices)
+: Renderer(nullptr, sol::Vec2f(static_cast<float>(width), static_cast<float>(height)), vertices)
 {
-	if (glewInit() != GLEW_OK)
+}
+
+Renderer::Renderer(Window* const window, sol::Vec2f viewport, size_t vertices)
+: m_Window(window), m_Viewport(viewport), m_Camera(viewport.x / viewport.y), m_Vertices(vertices), m_ObjectHandler(std::make_unique<ObjectHandler>())
+{
+	GLenum status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+	// without a window the context is created with EGL, GLEW built for GLX reports a missing X display then,
+	// although it has loaded the functions
+	if (!window && status == GLEW_ERROR_NO_GLX_DISPLAY)
+	{
+		status = GLEW_OK;
+	}
+#endif
+	if (status != GLEW_OK)
 	{
 		throw std::runtime_error("Failed to initialize OpenGL bindings");
 	}
@@ -55,69 +96,83 @@ Renderer::Renderer(Window* const window, size_t vertices)
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	ObjectHandler& handler = this->GetObjectHandler();
+	Camera& cam = this->GetCamera();
+	cam.viewport = this->Viewport();
 
 	::LoadScene(this);
 
-	Camera& cam = this->GetCamera();
-
-	projection = sol::Perspective(sol::Radians(cam.fov),this->GetWindow()->AspectRatio(), 0.1f, 1000.0f);
+	projection = sol::Perspective(sol::Radians(cam.fov), this->AspectRatio(), 0.1f, 1000.0f);
 	view = sol::Transpose(sol::LookAt(cam.position, cam.lookPosition));
-	model = sol::Mat4f(1.0f);
 }
 
-static void LoadScene(Renderer* renderer)
-{
-	ObjectHandler& handler = renderer->GetObjectHandler();
-	
-	Material* basicLMaterial = handler.AddMaterial("Basic_Lines", std::move(Material("Basic", GL_LINES)));
-	Material* basicTFMaterial = handler.AddMaterial("Basic_Triangle_Fan", std::move(Material("Basic", GL_TRIANGLE_FAN)));
-	Material* aabbMaterial = handler.AddMaterial("AABB_Material", std::move(Material("AABBShader", GL_LINE_LOOP)));	
-
-	sol::Vec4f blue = sol::Vec4f(0.4f, 0.5f, 0.7f, 0.3f);
-	sol::Vec4f white = sol::Vec4f(0.9f, 0.9f, 0.9f, 0.5f);
-	sol::Vec4f red = {0.9f, 0.3f, 0.6f, 1.0f};
-	sol::Vec4f green = {0.6f, 0.9f, 0.6f, 1.0f};
-	sol::Vec4f yellow = {0.8f, 0.6f, 0.1f, 1.0f};
+// Grid lines with x in [-19; 19] and y in [-9; 9] and both axes with arrows
+using SceneGrid = std::array<Vertex, 39 * 2 + 19 * 2 + 2 * 6>;
 
-	Object scene = Object({}, basicLMaterial, false);
+static constexpr SceneGrid MakeSceneGrid(sol::Vec4f gridColor, sol::Vec4f axisColor)
+{
+	SceneGrid grid = {};
+	size_t i = 0;
 	// we won't start from 20 and 10, so that
 	// the scene would look more like a grid, than a chess board
 	for (float f = -19.0f; f < 20; f += 1.0f)
 	{
-		scene.AddVertices
-		({
-			Vertex(f, -10.0f, blue),
-			Vertex(f,  10.0f, blue),
-		});
+		grid[i++] = Vertex(f, -10.0f, gridColor);
+		grid[i++] = Vertex(f,  10.0f, gridColor);
 	}
 	for (float f = -9.0f; f < 10; f += 1.0f)
 	{
-		scene.AddVertices
-		({
-			Vertex(-20.0f, f, blue),
-			Vertex( 20.0f, f, blue),
-		});
+		grid[i++] = Vertex(-20.0f, f, gridColor);
+		grid[i++] = Vertex( 20.0f, f, gridColor);
 	}
-	scene.AddVertices
-	({
-		Vertex(-21.0f, 0.0f, white),
-		Vertex( 21.0f, 0.0f, white),
+	const Vertex axes[] =
+	{
+		Vertex(-21.0f, 0.0f, axisColor),
+		Vertex( 21.0f, 0.0f, axisColor),
 		// axis arrows
-		Vertex(20.8f,  0.2f, white),
-		Vertex(21.0f,  0.0f, white),
-		Vertex(20.8f, -0.2f, white),
-		Vertex(21.0f,  0.0f, white),
-	});
-	scene.AddVertices
-	({
-		Vertex(0.0f, -11.0f, white),
-		Vertex(0.0f,  11.0f, white),
+		Vertex(20.8f,  0.2f, axisColor),
+		Vertex(21.0f,  0.0f, axisColor),
+		Vertex(20.8f, -0.2f, axisColor),
+		Vertex(21.0f,  0.0f, axisColor),
+
+		Vertex(0.0f, -11.0f, axisColor),
+		Vertex(0.0f,  11.0f, axisColor),
 		// axis arrows
-		Vertex(-0.2f, 10.8f, white),
-		Vertex( 0.0f, 11.0f, white),
-		Vertex( 0.2f, 10.8f, white),
-		Vertex( 0.0f, 11.0f, white),
-	});
+		Vertex(-0.2f, 10.8f, axisColor),
+		Vertex( 0.0f, 11.0f, axisColor),
+		Vertex( 0.2f, 10.8f, axisColor),
+		Vertex( 0.0f, 11.0f, axisColor),
+	};
+	for (const Vertex& vertex : axes)
+	{
+		grid[i++] = vertex;
+	}
+	return grid;
+}
+
+static void LoadScene(Renderer* renderer)
+{
+	ObjectHandler& handler = renderer->GetObjectHandler();
+	
+	Material* basicLMaterial = handler.AddMaterial("Basic_Lines", std::move(Material("Basic", GL_LINES)));
+	Material* basicTFMaterial = handler.AddMaterial("Basic_Triangle_Fan", std::move(Material("Basic", GL_TRIANGLE_FAN)));
+	Material* basicLSMaterial = handler.AddMaterial("Basic_Line_Strip", std::move(Material("Basic", GL_LINE_STRIP)));
+	Material* aabbMaterial = handler.AddMaterial("AABB_Material", std::move(Material("AABBShader", GL_LINE_LOOP)));	
+	// Column shader reads x and y from separate attributes, it is used by objects with MappedSeries
+	handler.AddMaterial("Column_Line_Strip", std::move(Material("Column", GL_LINE_STRIP)));
+	// Density shader colors a histogram texture, it is used by objects with DensitySeries
+	handler.AddMaterial("Density_Quad", std::move(Material("Density", GL_TRIANGLE_STRIP)));
+	// Scope shader computes x from the index of a sample, it is used by objects with RingSeries
+	handler.AddMaterial("Scope_Line_Strip", std::move(Material("Scope", GL_LINE_STRIP)));
+
+	constexpr sol::Vec4f blue = sol::Vec4f(0.4f, 0.5f, 0.7f, 0.3f);
+	constexpr sol::Vec4f white = sol::Vec4f(0.9f, 0.9f, 0.9f, 0.5f);
+	constexpr sol::Vec4f red = {0.9f, 0.3f, 0.6f, 1.0f};
+	constexpr sol::Vec4f green = {0.6f, 0.9f, 0.6f, 1.0f};
+	constexpr sol::Vec4f yellow = {0.8f, 0.6f, 0.1f, 1.0f};
+
+	// the grid is built at compile time and stored in the binary
+	static constexpr SceneGrid grid = ::MakeSceneGrid(blue, white);
+	Object scene = Object(std::vector<Vertex>(grid.begin(), grid.end()), basicLMaterial, false);
 	/* As of 02.06
 	We should use std::move for object, as we wont be able to affect those objects,
 	that are being rendered with this variables, thus it's ambiguous to make a copy,
@@ -137,14 +192,53 @@ static void LoadScene(Renderer* renderer)
 
 	quad.CreateAABB();
 	handler.AddObject(std::move(quad));
+
+	// Curves are sampled once here, so that they have valid AABB before the first frame
+	// After that they are resampled by the renderer when the camera zoom changes
+	const Camera& camera = renderer->GetCamera();
+
+	std::shared_ptr<ParametricCurve> lissajous = std::make_shared<ParametricCurve>(
+		[](float t) { return 8.0f + 1.5f * std::sin(3.0f * t); },
+		[](float t) { return 1.5f * std::sin(4.0f * t); },
+		0.0f, 2.0f * M_PI, yellow);
+	Object lissajousObject = Object({}, basicLSMaterial);
+	lissajous->Sample(lissajousObject, camera.PixelsPerUnit());
+	lissajousObject.SetSeries(std::move(lissajous));
+	handler.AddObject(std::move(lissajousObject));
+
+	std::shared_ptr<PolarCurve> rose = std::make_shared<PolarCurve>(
+		[](float theta) { return 2.0f * std::cos(4.0f * theta); },
+		0.0f, 2.0f * M_PI, green);
+	Object roseObject = Object({}, basicLSMaterial);
+	rose->Sample(roseObject, camera.PixelsPerUnit());
+	roseObject.SetSeries(std::move(rose));
+	roseObject.Transform() = sol::Vec3f(-8.0f, 0.0f, 0.0f);
+	handler.AddObject(std::move(roseObject));
+
+	// generic lambda is used both for point samples and for interval bounds
+	auto waveFunction = [](auto x) { using std::sin; using sol::sqr; return 4.0f * sin(x) / (1.0f + 0.05f * sqr(x)); };
+	std::shared_ptr<FunctionCurve> wave = std::make_shared<FunctionCurve>(waveFunction, waveFunction, red);
+	Object waveObject = Object({}, basicLSMaterial);
+	wave->Update(waveObject, camera);
+	waveObject.SetSeries(std::move(wave));
+	handler.AddObject(std::move(waveObject));
 }
 
 Renderer::~Renderer()
 {
+	// Analysis job, demo stream and import may still be running, stop them before objects are destroyed
+	m_Analyzer.Cancel();
+	this->StopDemoStream();
+	m_Importer.Cancel();
+	this->StopSeriesServer();
+
 	// Delete VAO and VBO
 	glDeleteVertexArrays(1, &m_VAO);
 	glDeleteBuffers(1, &m_VBO);
 	
+	// Delete all Objects. Series may own OpenGL buffers, which are deleted with the last object, that shares them
+	this->GetObjectHandler().Objects().clear();
+
 	// Delete all Materials
 	// This will call Shader destructor and effectively cleanup all OpenGL shaders and programs
 	this->GetObjectHandler().Materials().clear();
@@ -153,7 +247,8 @@ Renderer::~Renderer()
 static const sol::Vec2f GetCursorPos(Renderer* renderer)
 {
 	Window* const window = renderer->GetWindow();
-	GLFWwindow* context = window->Context();
+	// there is no cursor without a window, e.g. in headless mode
+	GLFWwindow* context = window ? window->Context() : nullptr;
 	Camera* camera = &renderer->GetCamera();
 	// just for extra safety
 	if (window && context && camera)
@@ -174,23 +269,53 @@ static sol::Vec2f cursorPos = {};
 // This method will be called each frame in main loop
 void Renderer::Update()
 {
+	PROFILE_ZONE("Renderer::Update");
 	Camera& camera = this->GetCamera();
-	camera.Update(this->GetWindow()->AspectRatio());
+	if (m_Window)
+	{
+		m_Viewport = sol::Vec2f(m_Window->Width(), m_Window->Height());
+	}
+	camera.viewport = this->Viewport();
+	camera.Update(this->AspectRatio());
+	m_FrameStats = FrameStats();
+	m_Profiler.BeginFrame();
+
+	// series upload their vertices to their own buffers while they are updated
+	m_Profiler.Begin("Series");
+	{
+		PROFILE_ZONE("Series");
+		this->PollSeriesServer();
+		for (Object& object : this->GetObjectHandler().Objects())
+		{
+			if (Series* series = object.GetSeries())
+			{
+				series->Update(object, camera);
+			}
+		}
+	}
+	m_Profiler.End();
 
 	cursorPos = ::GetCursorPos(this);
-	projection = sol::Perspective(sol::Radians(camera.fov), this->GetWindow()->AspectRatio(), 0.1f, 1000.0f);
+	projection = sol::Perspective(sol::Radians(camera.fov), this->AspectRatio(), 0.1f, 1000.0f);
 	view = sol::LookAt(camera.position, camera.lookPosition);
 
-	RenderDrawData([&](const Shader& shader) -> void 
+	auto renderCallback = [&](const Shader& shader) -> void 
 	{
 		shader.SetUniformMat4("u_Projection", projection);
 		shader.SetUniformMat4("u_View", view);
-	});
+	};
+	RenderDrawData(renderCallback);
+
+	m_Analyzer.Poll(m_Markers);
+	PROFILE_ZONE("Markers");
+	GpuProfiler::Scope markers(m_Profiler, "Markers");
+	RenderMarkers(renderCallback);
 }
 
 // This ImGui context method will be called each frame in main loop
 void Renderer::ImGuiUpdate(ImGuiIO& io) 
 {
+	PROFILE_ZONE("Renderer::ImGuiUpdate");
 	static bool objectCreation = false;
 	static bool materialCreation = false;
 
@@ -200,6 +325,13 @@ void Renderer::ImGuiUpdate(ImGuiIO& io)
 	::ImGuiObjectControlMenu(handler, &objectCreation);
    	::ImGuiMaterialControlMenu(handler, &materialCreation);
    	::ImGuiCursorInfoMenu(handler, cursorPos);
+   	::ImGuiSampleCacheMenu(handler);
+   	::ImGuiAnalysisMenu(this, cursorPos);
+   	::ImGuiStreamingMenu(this);
+   	::ImGuiDataFilesMenu(this);
+   	::ImGuiSceneMenu(handler);
+   	::ImGuiProfilerMenu(this);
+   	::ImGuiCpuProfilerMenu();
     ImGui::TextColored({0.7f, 0.7f, 0.7f, 1.0f}, "Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
 	ImGui::End();
 
@@ -213,77 +345,377 @@ Drawcall is being called per each object that is in DynamicBatching map
 */
 void Renderer::RenderDrawData(const std::function<void(const Shader&)>& renderCallback)
 {
+	PROFILE_ZONE("Renderer::RenderDrawData");
 	Camera& camera = this->GetCamera();
 	ObjectHandler& handler = this->GetObjectHandler();
+	std::vector<Object*> visible;
+	std::vector<Object*> overlays;
 	std::vector<Object>& objects = handler.Objects();
 	sol::Vec2f cursorPos = ::GetCursorPos(this);
-	size_t offset = 0;
-	for (Object& object : objects)
+
+	// objects are culled before any of them is drawn, so that culling is profiled apart from submission
 	{
-		if (!camera.IsVisible(object))
+		PROFILE_ZONE("Culling");
+		visible.reserve(objects.size());
+		for (Object& object : objects)
 		{
-			continue;
+			if (object.GetMaterial() && camera.IsVisible(object))
+			{
+				visible.push_back(&object);
+			}
 		}
+	}
+
+	m_Profiler.Begin("Scene");
+	{
+		PROFILE_ZONE("Scene");
+		for (Object* visibleObject : visible)
+		{
+			Object& object = *visibleObject;
+			const Material* material = object.GetMaterial();
+			sol::Affine2f model = object.ModelMat();
+			m_FrameStats.visibleObjects++;
+
+			const Shader& shader = material->GetShader();
+			shader.Bind();
+			shader.SetUniformAffine2("u_Model", model);
+			object.CallUniformCallback(shader, object);
+			renderCallback(shader);
+
+			Series* series = object.GetSeries();
+			if (series && series->Draw(object, material->GetRenderMode()))
+			{
+				// series drew the object from its own VAO
+				glBindVertexArray(m_VAO);
+				m_FrameStats.drawCalls++;
+			}
+			else
+			{
+				const std::vector<Vertex>& objectVertices = object.Vertices();
+				GLenum renderMode = material->GetRenderMode();
+				size_t first = 0, last = objectVertices.size();
+				// Strips and points may be cut anywhere, separate lines only at their pairs
+				if (object.IsSortedX() && (renderMode == GL_LINE_STRIP || renderMode == GL_POINTS || renderMode == GL_LINES))
+				{
+					std::tie(first, last) = camera.VisibleRange(object);
+					if (renderMode == GL_LINES)
+					{
+						first &= ~size_t(1);
+						last = std::min(objectVertices.size(), (last + 1) & ~size_t(1));
+					}
+				}
+				size_t offset = this->UploadVertices(objectVertices.data() + first, last - first);
+				glDrawArrays(renderMode, offset, last - first);
+				m_FrameStats.drawCalls++;
+			}
+
+			if (object.RenderAABB())
+			{
+				overlays.push_back(&object);
+			}
+		}
+	}
+
+	// AABB Render Part
+	// AABBs are drawn over all objects in a pass of their own, so that their GPU time is measured separately
+	Material* aabbMaterial = m_ObjectHandler->FindMaterial("AABB_Material");
+	if (overlays.empty() || !aabbMaterial)
+	{
+		m_Profiler.End();
+		return;
+	}
+	m_Profiler.Begin("AABB");
+	{
+		PROFILE_ZONE("AABB");
+		const Shader& aabbShader = aabbMaterial->GetShader();
+		for (Object* object : overlays)
+		{
+			AABB aabb = object->GetAABB();
+			aabb = aabb.Transform(object->ModelMat());
+
+			bool collides = false;
+
+			if (object->Collider())
+			{
+				PROFILE_ZONE("Collision");
+				collides = std::any_of(objects.begin(), objects.end(), [&](Object& other) -> bool
+				{
+					if (&other != object && !other.IsSealed() && other.Collider())
+					{
+						AABB otherAabb = other.GetAABB();
+						otherAabb = otherAabb.Transform(other.ModelMat());
+						return aabb.CollideWith(otherAabb);
+					}
+					return false;
+				});
+			}
+
+			size_t aabbOffset = this->UploadVertices(reinterpret_cast<Vertex*>(&aabb), 4);
+		
+			aabbShader.Bind();
+			aabbShader.SetUniformBool("u_Collides", collides);
+			renderCallback(aabbShader);
+
+			glDrawArrays(aabbMaterial->GetRenderMode(), aabbOffset, 4);
+			m_FrameStats.drawCalls++;
+		}
+	}
+	m_Profiler.End();
+}
+
+void Renderer::AnalyzeVisibleRange(Analyzer::Options options)
+{
+	std::vector<Analysis::Curve> curves;
+	for (Object& object : this->GetObjectHandler().Objects())
+	{
 		const Material* material = object.GetMaterial();
-		if (!material)
+		if (object.IsSealed() || !material || material->GetRenderMode() != GL_LINE_STRIP)
 		{
 			continue;
 		}
 
-		sol::Mat4f model = object.TranslationMat()  * object.RotationMat() * object.ScaleMat();
-		
-		const std::vector<Vertex>& objectVertices = object.Vertices();		
-		
-		glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(Vertex), objectVertices.size() * sizeof(Vertex), objectVertices.data());
+		sol::Affine2f model = object.ModelMat();
+		Analysis::Curve curve;
+		curve.points.resize(object.Vertices().size());
+		VertexTransform::Apply(model, object.Vertices().data(), object.Vertices().size(), curve.points.data());
+
+		// Functions of rotated objects are not functions of world x anymore, so only their polylines are analyzed
+		const FunctionCurve* function = dynamic_cast<const FunctionCurve*>(object.GetSeries());
+		if (function && object.Angle() == 0.0f)
+		{
+			curve.function = function->GetFunction();
+			curve.scale = object.Scale();
+			curve.translation = object.Transform();
+		}
+		curves.push_back(std::move(curve));
+	}
+
+	const Camera& camera = this->GetCamera();
+	m_Markers.clear();
+	m_Analyzer.Start(std::move(curves), camera.aabb.min.position.x, camera.aabb.max.position.x, options);
+}
 
-		const Shader& shader = material->GetShader();
-		shader.Bind();
-		shader.SetUniformMat4("u_Model", sol::Transpose(model));
-		object.CallUniformCallback(shader, object);
-		renderCallback(shader);
+void Renderer::StartDemoStream(size_t pointsPerSecond, bool scope)
+{
+	this->StopDemoStream();
 
-		glDrawArrays(material->GetRenderMode(), offset, objectVertices.size());
-		offset = (offset + objectVertices.size()) % m_Vertices;
+	ObjectHandler& handler = this->GetObjectHandler();
+	const char* materialName = scope ? "Scope_Line_Strip" : "Basic_Line_Strip";
+	Material* material = handler.FindMaterial(materialName);
+	if (!material)
+	{
+		std::cout << "No material with name " << materialName << " was found. Not able to start a demo stream\n";
+		return;
+	}
 
-		// AABB Render Part
-		if (object.RenderAABB())
+	// producer pushes samples [produced; produced + due) of the signal
+	std::function<void(size_t, size_t)> push;
+	Object object = Object({}, material, false);
+	if (scope)
+	{
+		size_t window = std::clamp<size_t>(2 * pointsPerSecond, 1024, 1 << 24);
+		std::shared_ptr<RingSeries> series = std::make_shared<RingSeries>(window, 1.0f / pointsPerSecond, sol::Vec4f(0.4f, 0.9f, 0.5f, 1.0f));
+		object.SetSeries(series);
+		push = [series, pointsPerSecond](size_t produced, size_t due)
 		{
-			Material* aabbMaterial = m_ObjectHandler->FindMaterial("AABB_Material");
-			if (aabbMaterial)
+			thread_local std::mt19937 engine(std::random_device{}());
+			std::normal_distribution<float> noise(0.0f, 0.05f);
+			RingSeries::Batch batch(due);
+			for (size_t i = 0; i < due; i++)
 			{
-				const Shader& aabbShader = aabbMaterial->GetShader();
+				double t = static_cast<double>(produced + i) / pointsPerSecond;
+				batch[i] = static_cast<float>(std::sin(t * 6.0) + std::sin(t * 41.0) * 0.3) + noise(engine);
+			}
+			series->Push(std::move(batch));
+		};
+	}
+	else
+	{
+		std::shared_ptr<StreamingSeries> series = std::make_shared<StreamingSeries>(sol::Vec4f(0.3f, 0.8f, 0.9f, 1.0f));
+		object.SetSeries(series);
+		push = [series, pointsPerSecond](size_t produced, size_t due)
+		{
+			thread_local std::mt19937 engine(std::random_device{}());
+			std::normal_distribution<float> noise(0.0f, 0.05f);
+			StreamingSeries::Batch batch(due);
+			for (size_t i = 0; i < due; i++)
+			{
+				float x = static_cast<float>(static_cast<double>(produced + i) / pointsPerSecond);
+				batch[i] = sol::Vec2f(x, std::sin(x) + noise(engine));
+			}
+			// a dropped batch is lost, as a sensor would lose it
+			series->Push(std::move(batch));
+		};
+	}
+	object.GetSeries()->Update(object, this->GetCamera());
+	handler.AddObject(std::move(object));
 
-				AABB aabb = object.GetAABB();	
-				aabb = aabb.Transform(model);
+	m_IsStreaming.store(true, std::memory_order_relaxed);
+	m_StreamProducer = std::thread([this, push, pointsPerSecond]()
+	{
+		using Clock = std::chrono::steady_clock;
+		Clock::time_point start = Clock::now();
+		size_t produced = 0;
+		while (m_IsStreaming.load(std::memory_order_relaxed))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+			size_t due = static_cast<size_t>(elapsed * pointsPerSecond) - produced;
+			push(produced, due);
+			produced += due;
+		}
+	});
+}
+
+void Renderer::StopDemoStream()
+{
+	m_IsStreaming.store(false, std::memory_order_relaxed);
+	if (m_StreamProducer.joinable())
+	{
+		m_StreamProducer.join();
+	}
+}
 
-				bool collides = false;
+void Renderer::StartSeriesServer(const std::string& path)
+{
+	this->StopSeriesServer();
+	m_SeriesServer = std::make_unique<SeriesServer>(path, s_ServerQueueCapacity);
+}
+
+void Renderer::StopSeriesServer()
+{
+	m_SeriesServer.reset();
+	m_ServedSeries.clear();
+}
 
-				if (object.Collider())
+void Renderer::PollSeriesServer()
+{
+	if (!m_SeriesServer)
+	{
+		return;
+	}
+	ObjectHandler& handler = this->GetObjectHandler();
+	SeriesServer::Message message;
+	// series are created with queues of the same capacity, so a frame never drops batches of a series
+	for (size_t i = 0; i < s_ServerQueueCapacity && m_SeriesServer->Poll(message); i++)
+	{
+		auto served = m_ServedSeries.find(message.series);
+		switch (message.command)
+		{
+		case SeriesServer::Command::Create:
+		{
+			if (served != m_ServedSeries.end())
+			{
+				served->second->SetColor(message.color);
+				break;
+			}
+			Material* material = handler.FindMaterial("Basic_Line_Strip");
+			if (!material)
+			{
+				std::cout << "No material with name Basic_Line_Strip was found. Not able to create served series " << message.series << std::endl;
+				break;
+			}
+			std::shared_ptr<StreamingSeries> series = std::make_shared<StreamingSeries>(message.color, s_ServerQueueCapacity);
+			Object object = Object({}, material, false);
+			object.SetSeries(series);
+			handler.AddObject(std::move(object));
+			m_ServedSeries.emplace(message.series, std::move(series));
+			break;
+		}
+		// messages for unknown series are ignored, as the series might have been deleted by another client
+		case SeriesServer::Command::Replace:
+			if (served != m_ServedSeries.end())
+			{
+				served->second->Clear();
+				served->second->Push(std::move(message.points));
+			}
+			break;
+		case SeriesServer::Command::Append:
+			if (served != m_ServedSeries.end())
+			{
+				served->second->Push(std::move(message.points));
+			}
+			break;
+		case SeriesServer::Command::Delete:
+			if (served != m_ServedSeries.end())
+			{
+				std::vector<Object>& objects = handler.Objects();
+				auto object = std::find_if(objects.begin(), objects.end(), [&](const Object& object) { return object.GetSeries() == served->second.get(); });
+				if (object != objects.end())
 				{
-					collides = std::any_of(objects.begin(), objects.end(), [&](Object& other) -> bool
-					{
-						if (&other != &object && !other.IsSealed() && other.Collider())
-						{
-							AABB otherAabb = other.GetAABB();
-							sol::Mat4f otherModel = other.TranslationMat() * other.RotationMat() * other.ScaleMat();
-							otherAabb = otherAabb.Transform(otherModel);
-							return aabb.CollideWith(otherAabb);
-						}
-						return false;
-					});
+					handler.RemoveObject(object - objects.begin());
+					handler.SetCurrentIndex(-1);
 				}
+				m_ServedSeries.erase(served);
+			}
+			break;
+		}
+	}
+}
 
-				glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(Vertex), 4 * sizeof(Vertex), reinterpret_cast<Vertex*>(&aabb));
-				
-				aabbShader.Bind();
-				aabbShader.SetUniformBool("u_Collides", collides);
-				renderCallback(aabbShader);
+void Renderer::RenderMarkers(const std::function<void(const Shader&)>& renderCallback)
+{
+	Material* material = m_ObjectHandler->FindMaterial("Basic_Lines");
+	if (m_Markers.empty() || !material)
+	{
+		return;
+	}
 
-				glDrawArrays(aabbMaterial->GetRenderMode(), offset, 4);
-				offset = (offset + 4) % m_Vertices;
-			}
+	// half of the cross size is 5 pixels
+	float size = 5.0f / this->GetCamera().PixelsPerUnit();
+	std::vector<Vertex> vertices;
+	vertices.reserve(m_Markers.size() * 4);
+	for (const Analysis::Marker& marker : m_Markers)
+	{
+		sol::Vec4f color;
+		switch (marker.type)
+		{
+		case Analysis::Marker::Type::Root: color = sol::Vec4f(0.9f, 0.9f, 0.9f, 1.0f); break;
+		case Analysis::Marker::Type::Minimum: color = sol::Vec4f(0.3f, 0.6f, 0.9f, 1.0f); break;
+		case Analysis::Marker::Type::Maximum: color = sol::Vec4f(0.9f, 0.6f, 0.3f, 1.0f); break;
+		case Analysis::Marker::Type::Intersection: color = sol::Vec4f(0.9f, 0.3f, 0.6f, 1.0f); break;
+		}
+		const sol::Vec2f& p = marker.position;
+		vertices.emplace_back(p.x - size, p.y - size, color);
+		vertices.emplace_back(p.x + size, p.y + size, color);
+		vertices.emplace_back(p.x - size, p.y + size, color);
+		vertices.emplace_back(p.x + size, p.y - size, color);
+	}
+
+	size_t offset = this->UploadVertices(vertices.data(), vertices.size());
+	const Shader& shader = material->GetShader();
+	shader.Bind();
+	shader.SetUniformAffine2("u_Model", sol::Affine2f(1.0f));
+	shader.SetUniformBool("u_Selected", false);
+	renderCallback(shader);
+	glDrawArrays(material->GetRenderMode(), offset, vertices.size());
+	m_FrameStats.drawCalls++;
+}
+
+size_t Renderer::UploadVertices(const Vertex* vertices, size_t count)
+{
+	if (count > m_Vertices)
+	{
+		// Orphan the old storage. VAO keeps referencing the same buffer object, so attributes are still valid
+		m_Vertices = std::max<size_t>(m_Vertices, 1);
+		while (m_Vertices < count)
+		{
+			m_Vertices *= 2;
 		}
+		std::cout << "Growing VBO to " << m_Vertices << " vertices\n";
+		glBufferData(GL_ARRAY_BUFFER, m_Vertices * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+		m_Offset = 0;
+	}
+	if (m_Offset + count > m_Vertices)
+	{
+		m_Offset = 0;
 	}
+
+	size_t offset = m_Offset;
+	glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(Vertex), count * sizeof(Vertex), vertices);
+	m_Offset += count;
+	m_FrameStats.uploadedBytes += count * sizeof(Vertex);
+	return offset;
 }
 
 static void ImGuiObjectControlMenu(ObjectHandler& handler, bool* objectCreation)
@@ -377,6 +809,19 @@ static void ImGuiCurrentObjectMenu(ObjectHandler& handler, int currentIndex)
 					std::cout << "No material with name AABB_Material was found. Not able to render AABB\n";
 				}
 			}
+			// series regenerate vertices each frame, so only static vertex arrays may be marked
+			bool sortedX = object->IsSortedX();
+			if (!object->GetSeries() && ImGui::Checkbox("Sorted by X (draw visible range only)", &sortedX))
+			{
+				if (sortedX && !object->DetectSortedX())
+				{
+					std::cout << "Object's vertices are not sorted by x. Drawing the whole vertex array\n";
+				}
+				else if (!sortedX)
+				{
+					object->ResetSortedX();
+				}
+			}
 			ImGui::SliderAngle("Object's Rotation Angle", &object->Angle());
 			ImGui::SliderFloat2("Object's Scale", reinterpret_cast<float*>(&object->Scale()), 0.2f, 10.0f);
 			ImGui::SliderFloat2("Object's Translation", reinterpret_cast<float*>(&object->Transform()), -100.0f, 100.0f);
@@ -543,4 +988,733 @@ static void ImGuiMaterialCreationMenu(ObjectHandler& handler, bool* materialCrea
 static void ImGuiCursorInfoMenu(ObjectHandler& handler, const sol::Vec2f cursorPos)
 {
 	ImGui::TextColored({0.3f, 0.6f, 0.9f, 1.0f}, "Cursor position: %.2f, %.2f", cursorPos.x, cursorPos.y);
-}
\ No newline at end of file
+}
+
+static void ImGuiSampleCacheMenu(ObjectHandler& handler)
+{
+	static int budget = 64;
+	if (ImGui::TreeNode("Sample Cache"))
+	{
+		bool budgetChanged = ImGui::SliderInt("Cache budget (MB)", &budget, 1, 1024);
+		if (ImGui::BeginTable("Function objects", 5, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "UUID");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Hit Rate");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Memory");
+			ImGui::TableSetColumnIndex(3); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Tiles");
+			ImGui::TableSetColumnIndex(4); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Interval Rejected / Breaks");
+			for (Object& object : handler.Objects())
+			{
+				FunctionCurve* function = dynamic_cast<FunctionCurve*>(object.GetSeries());
+				if (!function)
+				{
+					continue;
+				}
+				SampleCache& cache = function->Cache();
+				if (budgetChanged)
+				{
+					cache.SetBudget(static_cast<size_t>(budget) * 1024 * 1024);
+				}
+				const SampleCache::Stats& stats = cache.GetStats();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s", object.GetUUID().c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%.1f%% (%lu / %lu)", stats.HitRate() * 100.0f, stats.hits, stats.hits + stats.misses);
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%.2f / %.0f MB", stats.bytes / (1024.0f * 1024.0f), cache.Budget() / (1024.0f * 1024.0f));
+				ImGui::TableSetColumnIndex(3); ImGui::Text("%lu (%lu evicted)", stats.tiles, stats.evictions);
+				ImGui::TableSetColumnIndex(4); ImGui::Text("%lu / %lu", function->RejectedTiles(), function->Breaks());
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+}
+
+static void ImGuiAnalysisMenu(Renderer* renderer, const sol::Vec2f cursorPos)
+{
+	static Analyzer::Options options;
+	if (ImGui::TreeNode("Analysis"))
+	{
+		Analyzer& analyzer = renderer->GetAnalyzer();
+		std::vector<Analysis::Marker>& markers = renderer->Markers();
+
+		ImGui::Checkbox("Roots", &options.roots);
+		ImGui::SameLine();
+		ImGui::Checkbox("Extrema", &options.extrema);
+		ImGui::SameLine();
+		ImGui::Checkbox("Intersections", &options.intersections);
+		if (ImGui::Button("Analyze visible range"))
+		{
+			renderer->AnalyzeVisibleRange(options);
+		}
+		ImGui::SameLine();
+		if (analyzer.IsRunning())
+		{
+			if (ImGui::Button("Cancel"))
+			{
+				analyzer.Cancel();
+			}
+		}
+		else if (ImGui::Button("Clear markers"))
+		{
+			markers.clear();
+		}
+		ImGui::Text("%s, %lu markers found", analyzer.IsRunning() ? "Running" : "Idle", markers.size());
+
+		// nearest marker within 10 pixels of the cursor
+		float radius = 10.0f / renderer->GetCamera().PixelsPerUnit();
+		const Analysis::Marker* nearest = nullptr;
+		float nearestDistance = radius * radius;
+		for (const Analysis::Marker& marker : markers)
+		{
+			float dx = marker.position.x - cursorPos.x, dy = marker.position.y - cursorPos.y;
+			if (dx * dx + dy * dy < nearestDistance)
+			{
+				nearestDistance = dx * dx + dy * dy;
+				nearest = &marker;
+			}
+		}
+		if (nearest)
+		{
+			ImGui::TextColored({0.3f, 0.6f, 0.9f, 1.0f}, "Under cursor: %s at (%.4f, %.4f)", Analysis::ToString(nearest->type), nearest->position.x, nearest->position.y);
+		}
+
+		if (ImGui::BeginTable("Markers", 2, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Type");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Position");
+			// the table is limited, as there may be thousands of markers on noisy data
+			for (size_t i = 0; i < markers.size() && i < 256; i++)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s", Analysis::ToString(markers[i].type));
+				ImGui::TableSetColumnIndex(1); ImGui::Text("(%.4f, %.4f)", markers[i].position.x, markers[i].position.y);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+}
+static void ImGuiStreamingMenu(Renderer* renderer)
+{
+	static int rate = 100000;
+	static std::string channelName = "/cartesian-plotter";
+	static int channelCapacity = 1 << 22;
+	static std::string socketPath = "/tmp/cartesian-plotter.sock";
+	if (ImGui::TreeNode("Streaming"))
+	{
+		ImGui::SliderInt("Demo rate (points/s)", &rate, 1000, 10000000, "%d", ImGuiSliderFlags_Logarithmic);
+		if (renderer->IsDemoStreaming())
+		{
+			if (ImGui::Button("Stop demo stream"))
+			{
+				renderer->StopDemoStream();
+			}
+		}
+		else
+		{
+			if (ImGui::Button("Start demo stream"))
+			{
+				renderer->StartDemoStream(static_cast<size_t>(rate));
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Start scope"))
+			{
+				renderer->StartDemoStream(static_cast<size_t>(rate), true);
+			}
+		}
+		ImGui::Separator();
+
+		// points of another process come through a shared memory segment, either side may create it
+		ImGui::InputText("Channel name", &channelName);
+		ImGui::InputInt("Channel capacity (points)", &channelCapacity);
+		bool createChannel = ImGui::Button("Create channel");
+		ImGui::SameLine();
+		bool attachChannel = ImGui::Button("Attach channel");
+		if (createChannel || attachChannel)
+		{
+			ObjectHandler& handler = renderer->GetObjectHandler();
+			Material* material = handler.FindMaterial("Basic_Line_Strip");
+			if (!material)
+			{
+				std::cout << "No material with name Basic_Line_Strip was found. Not able to open a shared channel\n";
+			}
+			else
+			{
+				try
+				{
+					std::unique_ptr<SharedChannel> channel = createChannel
+						? std::make_unique<SharedChannel>(channelName, static_cast<size_t>(std::max(channelCapacity, 2)))
+						: std::make_unique<SharedChannel>(channelName);
+					std::cout << (createChannel ? "Created" : "Attached to") << " shared channel " << channelName << " of " << channel->Capacity() << " points\n";
+					Object object = Object({}, material, false);
+					object.SetSeries(std::make_shared<ChannelSeries>(std::move(channel), sol::Vec4f(0.9f, 0.5f, 0.3f, 1.0f)));
+					object.GetSeries()->Update(object, renderer->GetCamera());
+					handler.AddObject(std::move(object));
+				}
+				catch (const std::runtime_error& error)
+				{
+					std::cout << error.what() << std::endl;
+				}
+			}
+		}
+
+		ImGui::Separator();
+
+		// clients create, append to, replace and delete series through a socket
+		ImGui::InputText("Socket path", &socketPath);
+		if (const SeriesServer* server = renderer->GetSeriesServer())
+		{
+			if (ImGui::Button("Stop server"))
+			{
+				renderer->StopSeriesServer();
+			}
+			else
+			{
+				SeriesServer::Stats stats = server->GetStats();
+				ImGui::Text("Connections: %lu, messages: %lu, points: %lu (%.1f MB)", stats.connections, stats.messages, stats.points, stats.bytes / (1024.0f * 1024.0f));
+				ImGui::Text("Queued points: %lu, stalls: %lu, errors: %lu", server->QueuedPoints(), stats.stalls, stats.errors);
+			}
+		}
+		else if (ImGui::Button("Start server"))
+		{
+			try
+			{
+				renderer->StartSeriesServer(socketPath);
+				std::cout << "Series server listens on " << socketPath << std::endl;
+			}
+			catch (const std::runtime_error& error)
+			{
+				std::cout << error.what() << std::endl;
+			}
+		}
+
+		if (ImGui::BeginTable("Streaming objects", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "UUID");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Points (Batches)");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "GPU Memory");
+			ImGui::TableSetColumnIndex(3); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Dropped Points (Batches)");
+			for (Object& object : renderer->GetObjectHandler().Objects())
+			{
+				const StreamingSeries* series = dynamic_cast<const StreamingSeries*>(object.GetSeries());
+				if (!series)
+				{
+					continue;
+				}
+				StreamingSeries::Stats stats = series->GetStats();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s", object.GetUUID().c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lu (%lu)", stats.points, stats.batches);
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%.2f MB", stats.bytes / (1024.0f * 1024.0f));
+				ImGui::TableSetColumnIndex(3); ImGui::Text("%lu (%lu)", stats.droppedPoints, stats.droppedBatches);
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::BeginTable("Channel objects", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Channel");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Received");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Ring Fill");
+			ImGui::TableSetColumnIndex(3); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Dropped by Producer");
+			for (Object& object : renderer->GetObjectHandler().Objects())
+			{
+				const ChannelSeries* series = dynamic_cast<const ChannelSeries*>(object.GetSeries());
+				if (!series)
+				{
+					continue;
+				}
+				const SharedChannel& channel = series->Channel();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s%s", channel.Name().c_str(), channel.IsOwner() ? " (owner)" : "");
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lu", series->Received());
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%lu / %lu", static_cast<size_t>(channel.Written() - channel.Consumed()), channel.Capacity());
+				ImGui::TableSetColumnIndex(3); ImGui::Text("%lu", static_cast<size_t>(channel.Dropped()));
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::BeginTable("Scope objects", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "UUID");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Window (Received)");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Uploaded per frame");
+			ImGui::TableSetColumnIndex(3); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Dropped Samples (Batches)");
+			for (Object& object : renderer->GetObjectHandler().Objects())
+			{
+				const RingSeries* series = dynamic_cast<const RingSeries*>(object.GetSeries());
+				if (!series)
+				{
+					continue;
+				}
+				RingSeries::Stats stats = series->GetStats();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s", object.GetUUID().c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lu / %lu (%lu)", stats.samples, series->Capacity(), stats.received);
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%.1f KB", stats.uploadedBytes / 1024.0f);
+				ImGui::TableSetColumnIndex(3); ImGui::Text("%lu (%lu)", stats.droppedSamples, stats.droppedBatches);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+}
+
+static void AddDensityObject(ObjectHandler& handler, std::vector<sol::Vec2f>&& points)
+{
+	Material* material = handler.FindMaterial("Density_Quad");
+	if (!material)
+	{
+		std::cout << "No material with name Density_Quad was found. Not able to add a density plot\n";
+		return;
+	}
+	std::shared_ptr<DensitySeries> series = std::make_shared<DensitySeries>(std::move(points));
+	Object object = Object({}, material, false);
+	object.SetAABB(series->GetAABB());
+	object.SetSeries(std::move(series));
+	handler.AddObject(std::move(object));
+}
+
+// Imported polylines with at least this amount of points are drawn with M4 aggregation
+static constexpr size_t s_SampledSeriesPoints = 1 << 20;
+
+static void ImGuiDataFilesMenu(Renderer* renderer)
+{
+	static std::string path = "capture.cpcol";
+	static int samplePoints = 16;
+	static bool sampleDoubles = false;
+	static std::string csvPath = "data.csv";
+	static CSVImporter::Options csvOptions;
+	static bool csvDensity = false;
+	static int densityPoints = 10;
+
+	ObjectHandler& handler = renderer->GetObjectHandler();
+	CSVImporter& importer = renderer->GetImporter();
+	// finished import is taken even if the menu is collapsed
+	CSVImporter::Result imported;
+	if (importer.Poll(imported))
+	{
+		Material* material = handler.FindMaterial("Basic_Line_Strip");
+		if (!imported.error.empty())
+		{
+			std::cout << imported.error << std::endl;
+		}
+		else if (imported.cancelled)
+		{
+			std::cout << "Import of " << imported.path << " was cancelled\n";
+		}
+		else if (imported.vertices.empty() || !material)
+		{
+			std::cout << "Nothing was imported from " << imported.path << std::endl;
+		}
+		else if (csvDensity)
+		{
+			std::cout << "Imported " << imported.vertices.size() << " points from " << imported.path << " as a density plot\n";
+			std::vector<sol::Vec2f> points(imported.vertices.size());
+			std::transform(imported.vertices.begin(), imported.vertices.end(), points.begin(), [](const Vertex& vertex) { return vertex.position; });
+			::AddDensityObject(handler, std::move(points));
+		}
+		else
+		{
+			std::cout << "Imported " << imported.vertices.size() << " points from " << imported.path << " in " << imported.seconds << " s ("
+				<< imported.bytes / (1024.0 * 1024.0) / imported.seconds << " MB/s), " << imported.skipped << " lines skipped\n";
+			// vertices are moved into the object, so the imported data is never copied.
+			// Large imports are kept by a sampled series, that emits only a few points per pixel column of the view
+			if (imported.vertices.size() >= s_SampledSeriesPoints)
+			{
+				std::shared_ptr<SampledSeries> series = std::make_shared<SampledSeries>(std::move(imported.vertices));
+				Object object = Object({}, material, false);
+				object.SetAABB(series->GetAABB());
+				object.SetSeries(std::move(series));
+				handler.AddObject(std::move(object));
+			}
+			else
+			{
+				Object object = Object(std::move(imported.vertices), material);
+				object.CreateAABB();
+				object.DetectSortedX();
+				handler.AddObject(std::move(object));
+			}
+		}
+	}
+
+	if (ImGui::TreeNode("Data Files"))
+	{
+		ImGui::InputText("CSV file", &csvPath);
+		ImGui::InputInt("X column (negative for line index)", &csvOptions.xColumn);
+		ImGui::InputInt("Y column", &csvOptions.yColumn);
+		ImGui::ColorEdit4("Color", &csvOptions.color.r);
+		ImGui::Checkbox("Import as density plot", &csvDensity);
+		if (importer.IsRunning())
+		{
+			ImGui::ProgressBar(importer.Progress());
+			ImGui::SameLine();
+			if (ImGui::Button("Cancel import"))
+			{
+				importer.Cancel();
+			}
+		}
+		else if (ImGui::Button("Import CSV"))
+		{
+			importer.Start(csvPath, csvOptions);
+		}
+		ImGui::Separator();
+
+		// Demo scatter is a mixture of gaussian clusters of different size and spread
+		ImGui::InputInt("Scatter points (millions)", &densityPoints);
+		ImGui::SameLine();
+		if (ImGui::Button("Add density plot"))
+		{
+			std::vector<sol::Vec2f> points(static_cast<size_t>(std::max(densityPoints, 1)) * 1000000);
+			std::mt19937 engine(7);
+			std::normal_distribution<float> normal(0.0f, 1.0f);
+			const sol::Vec4f clusters[] = { {-4.0f, -2.0f, 2.5f, 0.5f}, {3.0f, 2.0f, 0.6f, 0.3f}, {1.0f, -3.0f, 1.2f, 0.2f} };
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				const sol::Vec4f& cluster = clusters[i % 3];
+				points[i] = sol::Vec2f(cluster.x + normal(engine) * cluster.z, cluster.y + normal(engine) * cluster.z);
+			}
+			::AddDensityObject(handler, std::move(points));
+		}
+		ImGui::Separator();
+
+		ImGui::InputText("Column file", &path);
+		// mapped files are read by the driver on upload, paged files only by the loader thread of the series
+		bool openMapped = ImGui::Button("Open");
+		ImGui::SameLine();
+		bool openPaged = ImGui::Button("Open paged");
+		if (openMapped || openPaged)
+		{
+			Material* material = handler.FindMaterial("Column_Line_Strip");
+			if (!material)
+			{
+				std::cout << "No material with name Column_Line_Strip was found. Not able to open a column file\n";
+			}
+			else
+			{
+				try
+				{
+					std::shared_ptr<const ColumnFile> file = std::make_shared<const ColumnFile>(path);
+					std::cout << "Opened column file " << path << ": " << file->Points() << " points in " << file->Chunks() << " chunks\n";
+					Object object = Object({}, material, false);
+					if (openPaged)
+					{
+						object.SetSeries(std::make_shared<PagedSeries>(std::move(file), sol::Vec4f(0.3f, 0.8f, 0.9f, 1.0f)));
+					}
+					else
+					{
+						object.SetSeries(std::make_shared<MappedSeries>(std::move(file), sol::Vec4f(0.9f, 0.8f, 0.3f, 1.0f)));
+					}
+					// AABB is set by the series on the first update, the empty one is only needed until then
+					object.SetAABB(AABB::Create(sol::Vec2f(0.0f), sol::Vec2f(0.0f)));
+					handler.AddObject(std::move(object));
+				}
+				catch (const std::runtime_error& error)
+				{
+					std::cout << error.what() << std::endl;
+				}
+			}
+		}
+
+		// Sample file is a random walk with x from 0 to the amount of points. It is written on this thread
+		ImGui::InputInt("Sample points (millions)", &samplePoints);
+		ImGui::Checkbox("Float64 columns", &sampleDoubles);
+		ImGui::SameLine();
+		if (ImGui::Button("Write sample"))
+		{
+			try
+			{
+				ColumnFile::Type type = sampleDoubles ? ColumnFile::Type::Float64 : ColumnFile::Type::Float32;
+				size_t points = static_cast<size_t>(std::max(samplePoints, 1)) * 1000000;
+				ColumnWriter writer(path, points, type, type);
+				std::mt19937 engine(42);
+				std::normal_distribution<double> step(0.0, 0.01);
+				std::vector<double> xs(65536), ys(65536);
+				double y = 0.0;
+				for (size_t written = 0; written < points; written += xs.size())
+				{
+					size_t count = std::min(xs.size(), points - written);
+					for (size_t i = 0; i < count; i++)
+					{
+						y += step(engine);
+						xs[i] = static_cast<double>(written + i) * 1e-3;
+						ys[i] = y;
+					}
+					writer.Append(xs.data(), ys.data(), count);
+				}
+				writer.Close();
+				std::cout << "Written " << points << " points to " << path << std::endl;
+			}
+			catch (const std::runtime_error& error)
+			{
+				std::cout << error.what() << std::endl;
+			}
+		}
+
+		if (ImGui::BeginTable("Mapped objects", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "File");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Points (Size)");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Visible / Resident / Slots");
+			ImGui::TableSetColumnIndex(3); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Uploaded");
+			for (Object& object : handler.Objects())
+			{
+				const MappedSeries* series = dynamic_cast<const MappedSeries*>(object.GetSeries());
+				if (!series)
+				{
+					continue;
+				}
+				const ColumnFile& file = series->File();
+				const MappedSeries::Stats& stats = series->GetStats();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s", file.Path().c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lu (%.1f MB)", file.Points(), file.Bytes() / (1024.0f * 1024.0f));
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%lu / %lu / %lu%s", stats.visibleChunks, stats.residentChunks, stats.slots, stats.summary ? " (summary)" : "");
+				ImGui::TableSetColumnIndex(3); ImGui::Text("%.1f MB", stats.uploadedBytes / (1024.0f * 1024.0f));
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::BeginTable("Paged objects", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Paged file");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Visible / Pending / Resident / Slots");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Memory pages");
+			ImGui::TableSetColumnIndex(3); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Loaded");
+			for (Object& object : handler.Objects())
+			{
+				const PagedSeries* series = dynamic_cast<const PagedSeries*>(object.GetSeries());
+				if (!series)
+				{
+					continue;
+				}
+				const PagedSeries::Stats& stats = series->GetStats();
+				PageCache::Stats cache = series->Cache().GetStats();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s", series->File().Path().c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lu / %lu / %lu / %lu%s", stats.visibleChunks, stats.pendingChunks, stats.residentChunks, stats.slots, stats.summary ? " (summary)" : "");
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%lu (%.1f / %.1f MB)", cache.pages, cache.bytes / (1024.0f * 1024.0f), series->Cache().Budget() / (1024.0f * 1024.0f));
+				ImGui::TableSetColumnIndex(3); ImGui::Text("%lu pages, %.1f MB/s", cache.loads, cache.loadSeconds > 0.0 ? cache.loadedBytes / cache.loadSeconds / (1024.0 * 1024.0) : 0.0);
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::BeginTable("Density objects", 3, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Scatter points");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Bins (Max count)");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Rebins (Last)");
+			for (Object& object : handler.Objects())
+			{
+				const DensitySeries* series = dynamic_cast<const DensitySeries*>(object.GetSeries());
+				if (!series)
+				{
+					continue;
+				}
+				const Histogram2D::Grid& grid = series->Histogram().GetGrid();
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%lu", series->Points().size());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lux%lu (%u)", grid.columns, grid.rows, series->Histogram().MaxCount());
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%lu (%.1f ms)", series->Rebins(), series->BinSeconds() * 1000.0);
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::BeginTable("Sampled objects", 3, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Object");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Points / Emitted");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Pyramid");
+			for (size_t i = 0; i < handler.Objects().size(); i++)
+			{
+				const SampledSeries* series = dynamic_cast<const SampledSeries*>(handler.Objects()[i].GetSeries());
+				if (!series)
+				{
+					continue;
+				}
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%lu", i);
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lu / %lu%s", series->Vertices().size(), series->Emitted(), series->IsSorted() ? "" : " (unsorted)");
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%lu levels (%.1f KB)", series->Pyramid().Levels(), series->Pyramid().Bytes() / 1024.0f);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+}
+
+static void ImGuiSceneMenu(ObjectHandler& handler)
+{
+	static std::string path = "scene.cpscene";
+	static bool replace = false;
+	if (ImGui::TreeNode("Scene"))
+	{
+		ImGui::InputText("Scene file", &path);
+		ImGui::Checkbox("Replace objects on load", &replace);
+		// objects with series are skipped, as their data comes from functions, streams and files
+		if (ImGui::Button("Save scene"))
+		{
+			try
+			{
+				Scene::Result result = Scene::Save(handler, path);
+				std::cout << "Saved " << result.objects << " objects (" << result.vertices << " vertices, " << result.skipped << " objects with series skipped) to "
+					<< path << " in " << result.seconds << " s (" << result.bytes / (1024.0 * 1024.0) / result.seconds << " MB/s)\n";
+			}
+			catch (const std::runtime_error& error)
+			{
+				std::cout << error.what() << std::endl;
+			}
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Load scene"))
+		{
+			try
+			{
+				Scene::Result result = Scene::Load(handler, path, replace);
+				std::cout << "Loaded " << result.objects << " objects (" << result.vertices << " vertices) from "
+					<< path << " in " << result.seconds << " s (" << result.bytes / (1024.0 * 1024.0) / result.seconds << " MB/s)\n";
+			}
+			catch (const std::runtime_error& error)
+			{
+				std::cout << error.what() << std::endl;
+			}
+		}
+		ImGui::TreePop();
+	}
+}
+
+static void ImGuiProfilerMenu(Renderer* renderer)
+{
+	if (ImGui::TreeNode("GPU Profiler"))
+	{
+		const GpuProfiler& profiler = renderer->GetProfiler();
+		const Renderer::FrameStats& stats = renderer->GetFrameStats();
+		ImGui::Text("Draw calls: %lu, uploaded: %.1f KB, visible objects: %lu", stats.drawCalls, stats.uploadedBytes / 1024.0f, stats.visibleObjects);
+		ImGui::Text("Results are %lu frames late, %lu frames were dropped", GpuProfiler::s_Latency, profiler.Dropped());
+		if (ImGui::BeginTable("Passes", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders))
+		{
+			ImGui::TableHeadersRow();
+			ImGui::TableSetColumnIndex(0); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Pass");
+			ImGui::TableSetColumnIndex(1); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Last (ms)");
+			ImGui::TableSetColumnIndex(2); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "Average / Max (ms)");
+			ImGui::TableSetColumnIndex(3); ImGui::TextColored({0.6f, 0.9f, 0.3f, 1.0f}, "History");
+			for (const GpuProfiler::Pass& pass : profiler.Passes())
+			{
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::Text("%s", pass.name.c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f", pass.last);
+				ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f / %.3f", pass.average, pass.max);
+				ImGui::TableSetColumnIndex(3);
+				ImGui::PushID(pass.name.c_str());
+				// samples are a ring, so the offset makes the oldest sample go first
+				ImGui::PlotHistogram("##History", pass.samples.data(), static_cast<int>(pass.samples.size()), static_cast<int>(pass.offset)
+					, nullptr, 0.0f, pass.max, ImVec2(0.0f, 40.0f));
+				ImGui::PopID();
+			}
+			ImGui::EndTable();
+		}
+		ImGui::TreePop();
+	}
+}
+
+// Zones of the latest finished outermost zone of the calling thread, i.e. of the previous frame on the render thread.
+// The outermost zone goes first, the rest are ordered by their ends
+static std::vector<Profiler::Event> LatestFrameZones()
+{
+	std::vector<Profiler::Event> events = Profiler::CollectThread();
+	auto root = std::find_if(events.rbegin(), events.rend(), [](const Profiler::Event& event) { return event.depth == 0; });
+	if (root == events.rend())
+	{
+		return {};
+	}
+	std::vector<Profiler::Event> zones = { *root };
+	// zones, that are enclosed by the root, end after it begins. Zones of the frame before it don't
+	for (auto zone = root + 1; zone != events.rend() && zone->end >= root->begin; ++zone)
+	{
+		zones.push_back(*zone);
+	}
+	return zones;
+}
+
+static void ImGuiCpuProfilerMenu()
+{
+	static bool paused = false;
+	static std::vector<Profiler::Event> zones;
+	static std::string tracePath = "trace.json";
+	if (ImGui::TreeNode("CPU Profiler"))
+	{
+#ifndef CARTESIAN_PLOTTER_PROFILER
+		ImGui::TextColored({0.9f, 0.6f, 0.3f, 1.0f}, "Zones aren't recorded, build with CARTESIAN_PLOTTER_PROFILER");
+#endif
+		ImGui::Checkbox("Pause", &paused);
+		if (!paused)
+		{
+			zones = ::LatestFrameZones();
+		}
+
+		if (!zones.empty())
+		{
+			const Profiler::Event& root = zones.front();
+			// zones are laid out in ticks of the profiler, which are converted to milliseconds only for labels
+			const double ticks = static_cast<double>(std::max<uint64_t>(root.end - root.begin, 1));
+			const double milliseconds = (Profiler::Microseconds(root.end) - Profiler::Microseconds(root.begin)) * 1e-3;
+			uint32_t depth = 0;
+			for (const Profiler::Event& zone : zones)
+			{
+				depth = std::max(depth, zone.depth);
+			}
+			ImGui::Text("%s: %.3f ms, %lu zones", root.name, milliseconds, zones.size());
+
+			// flame view, zones are stacked by their depth
+			const float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+			const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+			const ImVec2 origin = ImGui::GetCursorScreenPos();
+			ImDrawList* drawList = ImGui::GetWindowDrawList();
+			for (const Profiler::Event& zone : zones)
+			{
+				const double zoneBegin = (zone.begin - root.begin) / ticks;
+				const double zoneEnd = (zone.end - root.begin) / ticks;
+				ImVec2 min(origin.x + static_cast<float>(zoneBegin) * width, origin.y + zone.depth * rowHeight);
+				ImVec2 max(std::max(min.x + 1.0f, origin.x + static_cast<float>(zoneEnd) * width), min.y + rowHeight - 1.0f);
+
+				// colors are taken from the name, so that a zone keeps its color across frames
+				const size_t hash = std::hash<std::string>()(zone.name);
+				const ImU32 color = IM_COL32(80 + hash % 120, 80 + (hash >> 8) % 120, 80 + (hash >> 16) % 120, 255);
+				drawList->AddRectFilled(min, max, color);
+				drawList->PushClipRect(min, max, true);
+				drawList->AddText(ImVec2(min.x + 2.0f, min.y), IM_COL32(255, 255, 255, 255), zone.name);
+				drawList->PopClipRect();
+				if (ImGui::IsMouseHoveringRect(min, max))
+				{
+					ImGui::SetTooltip("%s: %.3f ms", zone.name, (zoneEnd - zoneBegin) * milliseconds);
+				}
+			}
+			ImGui::Dummy(ImVec2(width, (depth + 1) * rowHeight));
+		}
+
+		ImGui::InputText("Trace path", &tracePath);
+		ImGui::SameLine();
+		if (ImGui::Button("Export Chrome trace"))
+		{
+			try
+			{
+				Profiler::WriteChromeTrace(tracePath);
+				std::cout << "Chrome trace is written to " << tracePath << std::endl;
+			}
+			catch (const std::runtime_error& error)
+			{
+				std::cout << error.what() << std::endl;
+			}
+		}
+		ImGui::TreePop();
+	}
+}
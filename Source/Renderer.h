@@ -2,12 +2,19 @@
 
 #include <unordered_map>
 #include <vector>
+#include <thread>
+#include <atomic>
 #include <imgui.h>
 #include <Core/Material.h>
 #include <Core/Camera.h>
 #include <Core/Object.h>
+#include <Core/Analysis.h>
+#include <Core/GpuProfiler.h>
+#include <Utility/CSVImporter.h>
+#include <Utility/SeriesServer.h>
 
 class Window;
+class StreamingSeries;
 
 /**
  * 	Renderer class represents a non-copyable object, that allows to render primitives, 
@@ -16,8 +23,10 @@ class Window;
  * 	Renderer is meant to be a developer-side class, where the main graphics are drawn
  * 	and OpenGL stuff is manipulated
  * 	
- * 	Renderer constructor takes in a Window object pointer and a number of maximum vertices in VBO.
- *  Maximum vertex amount is used in order to setup OpenGL state machine, e.g. VAO, VBO, shaders, etc.
+ * 	Renderer constructor takes in a Window object pointer and an initial number of vertices in VBO.
+ * 	A renderer may also be created without a window for offscreen rendering, e.g. in headless mode. @see @ref <Core/Offscreen.h>
+ *  Vertex amount is used in order to setup OpenGL state machine, e.g. VAO, VBO, shaders, etc.
+ * 	VBO grows if an object does not fit into it.
  * 	OpenGL functions are also initialized in Renderer's constructor
  * 
  * 	Update() and ImGuiUpdate() methods are called each frame respectively in Window main loop
@@ -25,16 +34,48 @@ class Window;
  * 	ObjectHandler is stored inside renderer. Every object, that handler contains, will be drawn
  * 	independently with a separate drawcall. If AABB should be rendered, there is extra drawcall for it
  * 	ObjectHandler is also responsible for Materials. They are stored in map and can be accessed via handler.
+ * 	Series of the objects are updated in Update() before the objects are drawn.
  * 	For more information about ObjectHandler @see @ref <Core/Object.h>
  * 
  * 	Renderer contains it's own camera. More information about camera at @see @ref <Core/Camera.h>
+ * 
+ * 	Renderer also owns an Analyzer, that finds roots, extrema and intersections of visible curves on a background thread.
+ * 	Found markers are polled and drawn each frame. More information at @see @ref <Core/Analysis.h>
+ * 
+ * 	Objects, which series have their own GPU storage, are drawn by the series instead of uploading their vertices.
+ * 	A demo stream may be started from ImGui, it feeds a StreamingSeries or a scope RingSeries from a producer thread.
+ * 	More information at @see @ref <Core/StreamingSeries.h> and @see @ref <Core/RingSeries.h>
+ * 	Points of another local process are drained from a shared memory channel into a ChannelSeries each frame.
+ * 	More information at @see @ref <Core/ChannelSeries.h>
+ * 	Local processes may also create and feed streaming objects through a socket. More information at @see @ref <Utility/SeriesServer.h>
+ * 
+ * 	CSV files are imported on a background thread by CSVImporter, finished imports are added as new objects.
+ * 	More information at @see @ref <Utility/CSVImporter.h>
+ * 
+ * 	Objects may be saved to a binary scene file and loaded back from ImGui. More information at @see @ref <Core/Scene.h>
+ * 
+ * 	GPU time of render passes, i.e. series updates, scene objects, AABB overlays, markers and ImGui, is measured by GpuProfiler
+ * 	and shown in ImGui. More information at @see @ref <Core/GpuProfiler.h>
  */	
 class Renderer
 {
+public:
+	// Work of the last frame, that was rendered by Update()
+	struct FrameStats
+	{
+		size_t drawCalls = 0;
+		// bytes of vertices, that were uploaded to the VBO. Uploads of series to their own buffers aren't counted
+		size_t uploadedBytes = 0;
+		// objects, that passed culling
+		size_t visibleObjects = 0;
+	};
 public:
 	// Creates OpenGL bindings. This constructor is meant to be as a setup of rendering context
 	// e.g. all VBOs, VAOs and Materials should be handler here
 	Renderer(Window* const window, size_t vertices);
+	// Creates a renderer without a window, that draws into a viewport of the given size, e.g. a framebuffer of <Core/Offscreen.h>
+	// The OpenGL context must be current. ImGuiUpdate() must not be called then, as there is no ImGui context
+	Renderer(int width, int height, size_t vertices);
 
 	// This object is non-copyable because OpenGL acts as a state machine,
 	// thus more than one render context in one window is unsafe
@@ -56,20 +97,78 @@ public:
 	// and calling Object::CallUniformCallback()
 	void RenderDrawData(const std::function<void(const Shader&)>& renderCallback);
 
+	// Takes snapshots of all unsealed line strip objects in world space and starts their analysis
+	// in the visible range of x. Markers of the previous analysis are cleared
+	void AnalyzeVisibleRange(Analyzer::Options options);
+
+	// Adds a new streaming object and starts a producer thread, that pushes a noisy signal into it
+	// with x in seconds since the start. The previous demo stream is stopped.
+	// If scope is true, the object is a RingSeries, that shows the last two seconds of the signal
+	void StartDemoStream(size_t pointsPerSecond, bool scope = false);
+	// Stops the producer thread. The streaming object stays in the scene
+	void StopDemoStream();
+	inline bool IsDemoStreaming() const { return m_IsStreaming.load(std::memory_order_relaxed); }
+
+	// Starts accepting series updates from local processes on a Unix-domain socket. The previous server is stopped.
+	// Each series of the clients is a streaming object, messages are applied to the scene each frame in Update()
+	void StartSeriesServer(const std::string& path);
+	// Stops the server. Objects of its series stay in the scene
+	void StopSeriesServer();
+	inline const SeriesServer* GetSeriesServer() const { return m_SeriesServer.get(); }
+
 	// Getters and setters
+	// Window is nullptr for a renderer without a window
 	inline Window* const GetWindow() const { return m_Window; }
+	// Size of the viewport in pixels. It follows the size of the window each frame
+	inline sol::Vec2f Viewport() const { return m_Viewport; }
+	inline float AspectRatio() const { return m_Viewport.x / m_Viewport.y; }
 	inline Camera& GetCamera() { return m_Camera; }
 	inline const Camera& GetCamera() const { return m_Camera; }
 	inline ObjectHandler& GetObjectHandler() { return *m_ObjectHandler.get(); }
 	inline const ObjectHandler& GetObjectHandler() const { return *m_ObjectHandler.get(); }
+	inline Analyzer& GetAnalyzer() { return m_Analyzer; }
+	inline std::vector<Analysis::Marker>& Markers() { return m_Markers; }
+	inline CSVImporter& GetImporter() { return m_Importer; }
+	inline const std::vector<Analysis::Marker>& Markers() const { return m_Markers; }
+	inline const FrameStats& GetFrameStats() const { return m_FrameStats; }
+	inline GpuProfiler& GetProfiler() { return m_Profiler; }
+	inline const GpuProfiler& GetProfiler() const { return m_Profiler; }
+private:
+	Renderer(Window* const window, sol::Vec2f viewport, size_t vertices);
+
+	// Draws analysis markers as crosses of a constant screen size
+	void RenderMarkers(const std::function<void(const Shader&)>& renderCallback);
+
+	// Uploads vertices to VBO and returns the offset (in vertices) they were placed at
+	// VBO is used as a ring, it is reallocated with bigger size if vertices don't fit into it
+	size_t UploadVertices(const Vertex* vertices, size_t count);
+
+	// Applies messages of the series server to the scene. At most one queue of messages is applied per frame
+	void PollSeriesServer();
 private:
 	Window* const m_Window;
+	sol::Vec2f m_Viewport;
 	
 	Camera m_Camera;
 	unsigned int m_VAO;
 	unsigned int m_VBO;
 	unsigned int m_Program;
 	size_t m_Vertices;
+	size_t m_Offset = 0;
+	FrameStats m_FrameStats;
+	GpuProfiler m_Profiler;
 
 	std::unique_ptr<ObjectHandler> m_ObjectHandler;
+
+	Analyzer m_Analyzer;
+	std::vector<Analysis::Marker> m_Markers;
+
+	std::thread m_StreamProducer;
+	std::atomic<bool> m_IsStreaming = false;
+
+	CSVImporter m_Importer;
+
+	std::unique_ptr<SeriesServer> m_SeriesServer;
+	// series of the server by the ids, clients have chosen
+	std::unordered_map<uint32_t, std::shared_ptr<StreamingSeries>> m_ServedSeries;
 };
\ No newline at end of file
@@ -1,4 +1,14 @@
 #include <Utility/AABB.h>
+#include <Utility/Parallel.h>
+
+#include <mutex>
+#include <limits>
+#include <cstddef>
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AABB_SSE
+#endif
 
 bool AABB::CollideWith(const Vertex& vertex) const
 {
@@ -19,7 +29,7 @@ bool AABB::CollideWith(const AABB& box) const
 		&& (box.min.position.y <= this->max.position.y && box.max.position.y >= this->min.position.y);
 }
 
-AABB AABB::Transform(const sol::Mat4f& model)
+AABB AABB::Transform(const sol::Affine2f& model)
 {
 
 	AABB aabb = model * (*this);
@@ -52,6 +62,13 @@ AABB AABB::Transform(const sol::Mat4f& model)
 	return aabb;
 }
 
+void AABB::Extend(sol::Vec2f min, sol::Vec2f max)
+{
+	sol::Vec2f newMin = sol::Vec2f(std::min(this->min.position.x, min.x), std::min(this->min.position.y, min.y));
+	sol::Vec2f newMax = sol::Vec2f(std::max(this->max.position.x, max.x), std::max(this->max.position.y, max.y));
+	*this = AABB::Create(newMin, newMax, this->max.color);
+}
+
 std::ostream& operator<<(std::ostream& stream, const AABB& aabb)
 {
 	stream << aabb.p1 << std::endl 
@@ -61,52 +78,99 @@ std::ostream& operator<<(std::ostream& stream, const AABB& aabb)
 	return stream;
 }
 
-AABB operator*(const sol::Mat4f& mat, AABB& aabb)
+AABB operator*(const sol::Affine2f& model, AABB& aabb)
 {
-	aabb.p1 = mat * aabb.p1;
-	aabb.max = mat * aabb.max;
-	aabb.p3 = mat * aabb.p3;
-	aabb.min = mat * aabb.min;
+	aabb.p1 = model * aabb.p1;
+	aabb.max = model * aabb.max;
+	aabb.p3 = model * aabb.p3;
+	aabb.min = model * aabb.min;
 	return aabb;
 }
 
 AABB AABB::Create(const std::vector<Vertex>& vec)
 {
-	if (vec.empty())
+	sol::Vec2f min, max;
+	if (!AABB::Bounds(vec.data(), vec.size(), min, max))
 	{
 		return {};
 	}
+	return AABB::Create(min, max, vec.front().color);
+}
 
-	Vertex min = vec.front();
-	Vertex max = min;
+AABB AABB::Create(sol::Vec2f min, sol::Vec2f max, sol::Vec4f color)
+{
+	return { Vertex(min.x, max.y, color), Vertex(max, color), Vertex(max.x, min.y, color), Vertex(min, color) };
+}
 
-	for (const Vertex& vert : vec)
+// Bounds of a range on a single thread. Returns false if all positions contain NaN
+static bool SerialBounds(const Vertex* vertices, size_t count, sol::Vec2f& min, sol::Vec2f& max)
+{
+	static_assert(offsetof(Vertex, position) == 0 && sizeof(sol::Vec2f) == 2 * sizeof(float), "SSE path loads positions as pairs of floats");
+	float xMin = std::numeric_limits<float>::infinity(), yMin = xMin;
+	float xMax = -xMin, yMax = -xMin;
+	size_t i = 0;
+#ifdef AABB_SSE
+	// Each register holds positions of two vertices as (x0, y0, x1, y1). Two pairs of accumulators hide latency.
+	// _mm_min_ps() returns the second operand if any operand is NaN, so NaN positions never get into accumulators
+	__m128 min0 = _mm_set1_ps(xMin), min1 = min0;
+	__m128 max0 = _mm_set1_ps(xMax), max1 = max0;
+	for (; i + 4 <= count; i += 4)
 	{
-		if (vert.position.x < min.position.x)
-		{
-			min.position.x = vert.position.x;
-		}
-		else if (vert.position.x > max.position.x)
-		{
-			max.position.x = vert.position.x;
-		}
-		if (vert.position.y < min.position.y)
-		{
-			min.position.y = vert.position.y;
-		}
-		else if (vert.position.y > max.position.y)
-		{
-			max.position.y = vert.position.y;
-		}
+		__m128 a = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&vertices[i].position))
+			, reinterpret_cast<const __m64*>(&vertices[i + 1].position));
+		__m128 b = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&vertices[i + 2].position))
+			, reinterpret_cast<const __m64*>(&vertices[i + 3].position));
+		min0 = _mm_min_ps(a, min0);
+		max0 = _mm_max_ps(a, max0);
+		min1 = _mm_min_ps(b, min1);
+		max1 = _mm_max_ps(b, max1);
 	}
-
-	return { Vertex(min.position.x, max.position.y, min.color)
-		, max
-		, Vertex(max.position.x, min.position.y, max.color)
-		, min };
+	alignas(16) float mins[4], maxs[4];
+	_mm_store_ps(mins, _mm_min_ps(min0, min1));
+	_mm_store_ps(maxs, _mm_max_ps(max0, max1));
+	xMin = std::min(mins[0], mins[2]);
+	yMin = std::min(mins[1], mins[3]);
+	xMax = std::max(maxs[0], maxs[2]);
+	yMax = std::max(maxs[1], maxs[3]);
+#endif
+	for (; i < count; i++)
+	{
+		// comparisons are false for NaN, so NaN coordinates are skipped
+		const sol::Vec2f& p = vertices[i].position;
+		if (p.x < xMin) xMin = p.x;
+		if (p.x > xMax) xMax = p.x;
+		if (p.y < yMin) yMin = p.y;
+		if (p.y > yMax) yMax = p.y;
+	}
+	if (!(xMin <= xMax && yMin <= yMax))
+	{
+		return false;
+	}
+	min = sol::Vec2f(xMin, yMin);
+	max = sol::Vec2f(xMax, yMax);
+	return true;
 }
 
-AABB AABB::Create(sol::Vec2f min, sol::Vec2f max, sol::Vec4f color)
+bool AABB::Bounds(const Vertex* vertices, size_t count, sol::Vec2f& min, sol::Vec2f& max)
 {
-	return { Vertex(min.x, max.y, color), Vertex(max, color), Vertex(max.x, min.y, color), Vertex(min, color) };
+	if (count < s_ParallelVertices)
+	{
+		return SerialBounds(vertices, count, min, max);
+	}
+
+	std::mutex mutex;
+	bool found = false;
+	Parallel::For(count, s_ParallelVertices, [&](size_t begin, size_t end)
+	{
+		sol::Vec2f chunkMin, chunkMax;
+		if (!SerialBounds(vertices + begin, end - begin, chunkMin, chunkMax))
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		min = found ? sol::Vec2f(std::min(min.x, chunkMin.x), std::min(min.y, chunkMin.y)) : chunkMin;
+		max = found ? sol::Vec2f(std::max(max.x, chunkMax.x), std::max(max.y, chunkMax.y)) : chunkMax;
+		found = true;
+	});
+	return found;
 }
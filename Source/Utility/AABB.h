@@ -26,14 +26,23 @@ struct AABB
 	// This method allows to transform AABB with model matrix
 	// This is very important so that we avoid multiplying every object 
 	// vertex on CPU and only manipulate AABB
-	AABB Transform(const sol::Mat4f& model);
+	AABB Transform(const sol::Affine2f& model);
+	// Grows AABB, so that it contains the box [min; max]
+	void Extend(sol::Vec2f min, sol::Vec2f max);
 
 	// overloaded operators for ostream& and matrix multiplication
 	friend std::ostream& operator<<(std::ostream& stream, const AABB& aabb);
-	friend AABB operator*(const sol::Mat4f& mat, AABB& aabb);
+	friend AABB operator*(const sol::Affine2f& model, AABB& aabb);
 
 	// Creates AABB from the given parameter
 	// Note that creating AABB from vector is O(n), although creating AABB with (min, max) is O(1)
 	static AABB Create(const std::vector<Vertex>& vec);
 	static AABB Create(sol::Vec2f min, sol::Vec2f max, sol::Vec4f color = sol::Vec4f(0.9f, 0.6f, 0.3f, 1.0f));
+
+	// Computes bounds of positions of count vertices. NaN coordinates are skipped
+	// Returns false if there are no finite bounds, min and max are left untouched then.
+	// Positions are reduced with SSE, arrays of more than s_ParallelVertices vertices are split between threads
+	static bool Bounds(const Vertex* vertices, size_t count, sol::Vec2f& min, sol::Vec2f& max);
+
+	static constexpr size_t s_ParallelVertices = 1 << 20;
 };
\ No newline at end of file
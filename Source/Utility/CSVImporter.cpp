@@ -0,0 +1,255 @@
+#include <Utility/CSVImporter.h>
+#include <Utility/Parallel.h>
+#include <Utility/Profiler.h>
+
+#include <chrono>
+#include <cstring>
+#include <charconv>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// chunks are never smaller than this, so that tiny files are parsed on a single thread
+static constexpr size_t s_MinChunkBytes = 1 << 20;
+// progress is published once per this amount of bytes
+static constexpr size_t s_ProgressBytes = 1 << 20;
+
+static char DetectDelimiter(const char* begin, const char* end)
+{
+	const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+	std::string_view line(begin, (newline ? newline : end) - begin);
+	if (line.find('\t') != std::string_view::npos) return '\t';
+	if (line.find(';') != std::string_view::npos) return ';';
+	return ',';
+}
+
+// Parses a field, that may be surrounded with spaces or quotes. The whole field must be a number
+static bool ParseFloat(const char* begin, const char* end, float& value)
+{
+	while (begin < end && (*begin == ' ' || *begin == '"' || *begin == '+')) begin++;
+	while (end > begin && (end[-1] == ' ' || end[-1] == '"' || end[-1] == '\r')) end--;
+	if (begin == end)
+	{
+		return false;
+	}
+	std::from_chars_result result = std::from_chars(begin, end, value);
+	return result.ec == std::errc() && result.ptr == end;
+}
+
+static bool ParseLine(const char* begin, const char* end, char delimiter, const CSVImporter::Options& options, size_t index, sol::Vec2f& point)
+{
+	const int last = std::max(options.xColumn, options.yColumn);
+	bool hasX = options.xColumn < 0, hasY = false;
+	float x = static_cast<float>(index), y = 0.0f;
+	const char* field = begin;
+	for (int column = 0; column <= last && field <= end; column++)
+	{
+		const char* delimiterPosition = static_cast<const char*>(std::memchr(field, delimiter, end - field));
+		const char* fieldEnd = delimiterPosition ? delimiterPosition : end;
+		if (column == options.xColumn) hasX = ParseFloat(field, fieldEnd, x);
+		else if (column == options.yColumn) hasY = ParseFloat(field, fieldEnd, y);
+		field = fieldEnd + 1;
+	}
+	point = sol::Vec2f(x, y);
+	return hasX && hasY;
+}
+
+CSVImporter::~CSVImporter()
+{
+	this->Cancel();
+}
+
+void CSVImporter::Start(const std::string& path, Options options)
+{
+	this->Cancel();
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_HasResult = false;
+		m_Result = Result();
+	}
+	m_IsCancelled.store(false, std::memory_order_relaxed);
+	m_Progress.store(0.0f, std::memory_order_relaxed);
+	m_IsRunning.store(true, std::memory_order_release);
+	m_Thread = std::thread([this, path, options]()
+	{
+		PROFILE_THREAD("CSV importer");
+		PROFILE_ZONE("CSVImporter::Import");
+		Result result = CSVImporter::Import(path, options, &m_Progress, &m_IsCancelled);
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Result = std::move(result);
+		m_HasResult = true;
+		m_IsRunning.store(false, std::memory_order_release);
+	});
+}
+
+void CSVImporter::Cancel()
+{
+	m_IsCancelled.store(true, std::memory_order_relaxed);
+	if (m_Thread.joinable())
+	{
+		m_Thread.join();
+	}
+}
+
+bool CSVImporter::Poll(Result& result)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (!m_HasResult)
+	{
+		return false;
+	}
+	result = std::move(m_Result);
+	m_HasResult = false;
+	return true;
+}
+
+CSVImporter::Result CSVImporter::Import(const std::string& path, const Options& options, std::atomic<float>* progress, const std::atomic<bool>* cancelled)
+{
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point start = Clock::now();
+	Result result;
+	result.path = path;
+	auto isCancelled = [&]() { return cancelled && cancelled->load(std::memory_order_relaxed); };
+
+	int descriptor = ::open(path.c_str(), O_RDONLY);
+	struct stat status;
+	if (descriptor < 0 || ::fstat(descriptor, &status) != 0)
+	{
+		result.error = "Failed to open " + path + ": " + std::strerror(errno);
+		if (descriptor >= 0) ::close(descriptor);
+		return result;
+	}
+	const size_t size = status.st_size;
+	result.bytes = size;
+	if (size == 0)
+	{
+		::close(descriptor);
+		return result;
+	}
+	void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	if (mapping == MAP_FAILED)
+	{
+		result.error = "Failed to map " + path + ": " + std::strerror(errno);
+		::close(descriptor);
+		return result;
+	}
+	::madvise(mapping, size, MADV_SEQUENTIAL);
+	const char* data = static_cast<const char*>(mapping);
+	const char delimiter = options.delimiter ? options.delimiter : DetectDelimiter(data, data + size);
+
+	// Split the file at line boundaries. Each chunk but the last ends right after a newline
+	const size_t chunkBytes = std::max(s_MinChunkBytes, size / (Parallel::Concurrency() * 8));
+	std::vector<size_t> bounds = { 0 };
+	while (bounds.back() < size)
+	{
+		size_t end = std::min(size, bounds.back() + chunkBytes);
+		const char* newline = end < size ? static_cast<const char*>(std::memchr(data + end, '\n', size - end)) : nullptr;
+		bounds.push_back(newline ? newline - data + 1 : size);
+	}
+	const size_t chunks = bounds.size() - 1;
+
+	std::atomic<size_t> processed = 0;
+	auto report = [&](size_t bytes, float weight)
+	{
+		if (progress)
+		{
+			size_t total = processed.fetch_add(static_cast<size_t>(bytes * weight), std::memory_order_relaxed) + static_cast<size_t>(bytes * weight);
+			progress->store(std::min(1.0f, static_cast<float>(total) / size), std::memory_order_relaxed);
+		}
+	};
+
+	// First pass: count lines, so that each chunk gets its range in the vertex array
+	std::vector<size_t> offsets(chunks + 1, 0);
+	Parallel::For(chunks, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t chunk = begin; chunk < end && !isCancelled(); chunk++)
+		{
+			const char* p = data + bounds[chunk];
+			const char* chunkEnd = data + bounds[chunk + 1];
+			size_t lines = 0;
+			while (p < chunkEnd)
+			{
+				const char* newline = static_cast<const char*>(std::memchr(p, '\n', chunkEnd - p));
+				lines++;
+				p = newline ? newline + 1 : chunkEnd;
+			}
+			offsets[chunk + 1] = lines;
+			report(chunkEnd - (data + bounds[chunk]), 0.1f);
+		}
+	});
+	for (size_t chunk = 0; chunk < chunks; chunk++)
+	{
+		offsets[chunk + 1] += offsets[chunk];
+	}
+	result.lines = offsets[chunks];
+
+	// Second pass: parse each chunk into its range. Valid points are packed at the beginning of the range
+	std::vector<Vertex>& vertices = result.vertices;
+	std::vector<size_t> valid(chunks, 0);
+	if (!isCancelled())
+	{
+		vertices.resize(result.lines);
+	}
+	Parallel::For(isCancelled() ? 0 : chunks, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t chunk = begin; chunk < end && !isCancelled(); chunk++)
+		{
+			const char* p = data + bounds[chunk];
+			const char* chunkEnd = data + bounds[chunk + 1];
+			const char* reported = p;
+			Vertex* output = vertices.data() + offsets[chunk];
+			size_t count = 0;
+			for (size_t line = offsets[chunk]; p < chunkEnd; line++)
+			{
+				const char* newline = static_cast<const char*>(std::memchr(p, '\n', chunkEnd - p));
+				const char* lineEnd = newline ? newline : chunkEnd;
+				sol::Vec2f point;
+				if (ParseLine(p, lineEnd, delimiter, options, line, point))
+				{
+					output[count].position = point;
+					output[count].color = options.color;
+					count++;
+				}
+				p = lineEnd + 1;
+				if (p - reported >= static_cast<std::ptrdiff_t>(s_ProgressBytes))
+				{
+					report(p - reported, 0.9f);
+					reported = p;
+					if (isCancelled()) break;
+				}
+			}
+			report(std::max<std::ptrdiff_t>(0, chunkEnd - reported), 0.9f);
+			valid[chunk] = count;
+		}
+	});
+
+	::munmap(mapping, size);
+	::close(descriptor);
+
+	if (isCancelled())
+	{
+		result.cancelled = true;
+		result.vertices = std::vector<Vertex>();
+		return result;
+	}
+
+	// Close the gaps left by skipped lines
+	size_t written = 0;
+	for (size_t chunk = 0; chunk < chunks; chunk++)
+	{
+		if (written != offsets[chunk])
+		{
+			std::memmove(vertices.data() + written, vertices.data() + offsets[chunk], valid[chunk] * sizeof(Vertex));
+		}
+		written += valid[chunk];
+	}
+	vertices.resize(written);
+	result.skipped = result.lines - written;
+	result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	if (progress)
+	{
+		progress->store(1.0f, std::memory_order_relaxed);
+	}
+	return result;
+}
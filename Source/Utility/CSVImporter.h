@@ -0,0 +1,76 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
+#include <Utility/Vertex.h>
+
+/**
+ * 	CSVImporter reads 2D points from CSV or TSV files on a background thread
+ *
+ * 	The file is memory-mapped and split into chunks at line boundaries. Import runs in two parallel passes:
+ * 	-	the first pass counts lines of each chunk, so that every chunk knows where its points go;
+ * 	-	the second pass parses the lines of each chunk with std::from_chars straight into the final vertex array.
+ * 	Lines, that can't be parsed, e.g. a header or comments, are skipped and the gaps are closed at the end.
+ * 	Resulting vertices are moved into an Object without any copy.
+ *
+ * 	Render thread starts the import with Start() and takes the result with Poll() once it is finished.
+ * 	Progress() and Cancel() may be called at any time. Import() is the synchronous core, that is also used by benchmarks
+ */
+class CSVImporter
+{
+public:
+	struct Options
+	{
+		// field delimiter. If 0, it is detected from the first line: tab, semicolon or comma
+		char delimiter = 0;
+		// indices of x and y fields in a line. If xColumn is negative, the line index is used as x
+		int xColumn = 0;
+		int yColumn = 1;
+		sol::Vec4f color = sol::Vec4f(0.9f, 0.9f, 0.9f, 1.0f);
+	};
+
+	struct Result
+	{
+		std::string path;
+		std::vector<Vertex> vertices;
+		size_t lines = 0;
+		size_t skipped = 0;
+		size_t bytes = 0;
+		double seconds = 0.0;
+		bool cancelled = false;
+		// empty if the import succeeded
+		std::string error;
+	};
+public:
+	CSVImporter() = default;
+	CSVImporter(const CSVImporter&) = delete;
+	CSVImporter& operator=(const CSVImporter&) = delete;
+	// Destructor cancels and joins the import
+	~CSVImporter();
+
+	// Starts importing the file. The previous import is cancelled
+	void Start(const std::string& path, Options options);
+	// Requests the import to stop and waits for it. Cancelled import is still reported by Poll()
+	void Cancel();
+	// Moves the result out and returns true if the import is finished since the last call
+	bool Poll(Result& result);
+
+	inline bool IsRunning() const { return m_IsRunning.load(std::memory_order_acquire); }
+	// returns the fraction of the work done in range [0; 1]
+	inline float Progress() const { return m_Progress.load(std::memory_order_relaxed); }
+
+	// Imports the file on the calling thread. Progress and cancellation are optional
+	static Result Import(const std::string& path, const Options& options, std::atomic<float>* progress = nullptr, const std::atomic<bool>* cancelled = nullptr);
+private:
+	std::thread m_Thread;
+	std::atomic<bool> m_IsRunning = false;
+	std::atomic<bool> m_IsCancelled = false;
+	std::atomic<float> m_Progress = 0.0f;
+
+	std::mutex m_Mutex;
+	bool m_HasResult = false;
+	Result m_Result;
+};
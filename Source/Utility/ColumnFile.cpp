@@ -0,0 +1,340 @@
+#include <Utility/ColumnFile.h>
+#include <Utility/Parallel.h>
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static_assert(sizeof(ColumnFile::Header) == 96, "ColumnFile header layout must not change");
+static_assert(sizeof(ColumnFile::Bounds) == 32, "ColumnFile bounds layout must not change");
+
+static uint64_t AlignUp(uint64_t value)
+{
+	return (value + ColumnFile::s_Alignment - 1) / ColumnFile::s_Alignment * ColumnFile::s_Alignment;
+}
+
+static ColumnFile::Bounds EmptyBounds()
+{
+	double max = std::numeric_limits<double>::max();
+	double lowest = std::numeric_limits<double>::lowest();
+	return { max, lowest, max, lowest };
+}
+
+static void Extend(ColumnFile::Bounds& bounds, double x, double y)
+{
+	// comparisons are false for NaN, so non-finite coordinates don't spoil the bounds
+	if (x < bounds.xMin) bounds.xMin = x;
+	if (x > bounds.xMax) bounds.xMax = x;
+	if (y < bounds.yMin) bounds.yMin = y;
+	if (y > bounds.yMax) bounds.yMax = y;
+}
+
+static void Extend(ColumnFile::Bounds& bounds, const ColumnFile::Bounds& other)
+{
+	bounds.xMin = std::min(bounds.xMin, other.xMin);
+	bounds.xMax = std::max(bounds.xMax, other.xMax);
+	bounds.yMin = std::min(bounds.yMin, other.yMin);
+	bounds.yMax = std::max(bounds.yMax, other.yMax);
+}
+
+size_t ColumnFile::TypeSize(Type type)
+{
+	return type == Type::Float64 ? sizeof(double) : sizeof(float);
+}
+
+ColumnFile::ColumnFile(const std::string& path)
+: m_Path(path)
+{
+	m_Descriptor = ::open(path.c_str(), O_RDONLY);
+	if (m_Descriptor < 0)
+	{
+		throw std::runtime_error("Failed to open column file " + path + ": " + std::strerror(errno));
+	}
+
+	struct stat status;
+	if (::fstat(m_Descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Header))
+	{
+		::close(m_Descriptor);
+		throw std::runtime_error("Column file " + path + " is too small");
+	}
+	m_Size = status.st_size;
+
+	void* data = ::mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, m_Descriptor, 0);
+	if (data == MAP_FAILED)
+	{
+		::close(m_Descriptor);
+		throw std::runtime_error("Failed to map column file " + path + ": " + std::strerror(errno));
+	}
+	m_Data = static_cast<const unsigned char*>(data);
+	std::memcpy(&m_Header, m_Data, sizeof(Header));
+
+	// validate the header, so that malformed files never lead to reads out of the mapping
+	auto validType = [](Type type) { return type == Type::Float32 || type == Type::Float64; };
+	auto fits = [&](uint64_t offset, uint64_t bytes) { return offset <= m_Size && bytes <= m_Size - offset; };
+	const char* error = nullptr;
+	if (std::memcmp(m_Header.magic, s_Magic, sizeof(s_Magic)) != 0) error = "wrong magic";
+	else if (m_Header.version != s_Version) error = "unsupported version";
+	else if (!validType(m_Header.xType) || !validType(m_Header.yType)) error = "unknown column type";
+	else if (m_Header.chunkPoints == 0) error = "zero chunk size";
+	else if (m_Header.points > m_Size) error = "wrong amount of points";
+	else if (!fits(m_Header.xOffset, m_Header.points * TypeSize(m_Header.xType))) error = "x column is out of file";
+	else if (!fits(m_Header.yOffset, m_Header.points * TypeSize(m_Header.yType))) error = "y column is out of file";
+	if (!error)
+	{
+		size_t chunks = (m_Header.points + m_Header.chunkPoints - 1) / m_Header.chunkPoints;
+		if ((m_Header.flags & Flags_Bounds) && !fits(m_Header.boundsOffset, chunks * sizeof(Bounds)))
+		{
+			error = "bounds are out of file";
+		}
+		m_Bounds.resize(chunks);
+	}
+	if (error)
+	{
+		::munmap(data, m_Size);
+		::close(m_Descriptor);
+		throw std::runtime_error("Column file " + path + " is malformed: " + error);
+	}
+
+	if (m_Header.flags & Flags_Bounds)
+	{
+		std::memcpy(m_Bounds.data(), m_Data + m_Header.boundsOffset, m_Bounds.size() * sizeof(Bounds));
+	}
+	else
+	{
+		this->ComputeBounds();
+	}
+
+	m_Total = EmptyBounds();
+	for (const Bounds& bounds : m_Bounds)
+	{
+		Extend(m_Total, bounds);
+	}
+}
+
+ColumnFile::~ColumnFile()
+{
+	::munmap(const_cast<unsigned char*>(m_Data), m_Size);
+	::close(m_Descriptor);
+}
+
+double ColumnFile::X(size_t i) const
+{
+	const void* data = this->XData(i);
+	return m_Header.xType == Type::Float64 ? *static_cast<const double*>(data) : *static_cast<const float*>(data);
+}
+
+double ColumnFile::Y(size_t i) const
+{
+	const void* data = this->YData(i);
+	return m_Header.yType == Type::Float64 ? *static_cast<const double*>(data) : *static_cast<const float*>(data);
+}
+
+void ColumnFile::Prefetch(size_t first, size_t last) const
+{
+	if (first >= last)
+	{
+		return;
+	}
+	// madvise() needs page-aligned addresses
+	static const uintptr_t pageSize = ::sysconf(_SC_PAGESIZE);
+	size_t begin = this->ChunkBegin(first);
+	size_t end = this->ChunkBegin(last - 1) + this->ChunkSize(last - 1);
+	for (auto column : { std::make_pair(this->XData(begin), this->XData(end)), std::make_pair(this->YData(begin), this->YData(end)) })
+	{
+		uintptr_t from = reinterpret_cast<uintptr_t>(column.first) / pageSize * pageSize;
+		uintptr_t to = reinterpret_cast<uintptr_t>(column.second);
+		::madvise(reinterpret_cast<void*>(from), to - from, MADV_WILLNEED);
+	}
+}
+
+void ColumnFile::Read(size_t begin, size_t count, void* x, void* y) const
+{
+	auto read = [&](void* destination, uint64_t offset, size_t bytes)
+	{
+		unsigned char* data = static_cast<unsigned char*>(destination);
+		while (bytes > 0)
+		{
+			ssize_t result = ::pread(m_Descriptor, data, bytes, offset);
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (result <= 0)
+			{
+				throw std::runtime_error("Failed to read column file " + m_Path + ": " + (result < 0 ? std::strerror(errno) : "unexpected end of file"));
+			}
+			data += result;
+			offset += result;
+			bytes -= result;
+		}
+	};
+	size_t xSize = TypeSize(m_Header.xType), ySize = TypeSize(m_Header.yType);
+	read(x, m_Header.xOffset + begin * xSize, count * xSize);
+	read(y, m_Header.yOffset + begin * ySize, count * ySize);
+}
+
+void ColumnFile::ComputeBounds()
+{
+	if (this->IsXSorted())
+	{
+		// x-range of a chunk is known from its ends, so only y-range is left unknown. It is left infinite,
+		// so that chunks are never culled by y
+		const double infinity = std::numeric_limits<double>::infinity();
+		for (size_t chunk = 0; chunk < m_Bounds.size(); chunk++)
+		{
+			size_t begin = this->ChunkBegin(chunk);
+			m_Bounds[chunk] = { this->X(begin), this->X(begin + this->ChunkSize(chunk) - 1), -infinity, infinity };
+		}
+		return;
+	}
+
+	std::cout << "Column file " << m_Path << " has no bounds, computing them\n";
+	Parallel::For(m_Bounds.size(), 1, [&](size_t begin, size_t end)
+	{
+		for (size_t chunk = begin; chunk < end; chunk++)
+		{
+			Bounds bounds = EmptyBounds();
+			size_t first = this->ChunkBegin(chunk);
+			for (size_t i = first; i < first + this->ChunkSize(chunk); i++)
+			{
+				Extend(bounds, this->X(i), this->Y(i));
+			}
+			m_Bounds[chunk] = bounds;
+		}
+	});
+}
+
+ColumnWriter::ColumnWriter(const std::string& path, size_t points, ColumnFile::Type xType, ColumnFile::Type yType, size_t chunkPoints)
+{
+	if (chunkPoints == 0)
+	{
+		throw std::runtime_error("Column file chunk size must not be zero");
+	}
+
+	std::memset(&m_Header, 0, sizeof(m_Header));
+	std::memcpy(m_Header.magic, ColumnFile::s_Magic, sizeof(ColumnFile::s_Magic));
+	m_Header.version = ColumnFile::s_Version;
+	m_Header.flags = ColumnFile::Flags_Bounds;
+	m_Header.xType = xType;
+	m_Header.yType = yType;
+	m_Header.points = points;
+	m_Header.chunkPoints = chunkPoints;
+	m_Header.xOffset = AlignUp(sizeof(ColumnFile::Header));
+	m_Header.yOffset = AlignUp(m_Header.xOffset + points * ColumnFile::TypeSize(xType));
+	m_Header.boundsOffset = AlignUp(m_Header.yOffset + points * ColumnFile::TypeSize(yType));
+	m_Bounds.assign((points + chunkPoints - 1) / chunkPoints, EmptyBounds());
+
+	m_Descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (m_Descriptor < 0)
+	{
+		throw std::runtime_error("Failed to create column file " + path + ": " + std::strerror(errno));
+	}
+	// the file gets its final size at once, so columns are written in place
+	if (::ftruncate(m_Descriptor, m_Header.boundsOffset + m_Bounds.size() * sizeof(ColumnFile::Bounds)) != 0)
+	{
+		::close(m_Descriptor);
+		throw std::runtime_error("Failed to allocate column file " + path + ": " + std::strerror(errno));
+	}
+}
+
+ColumnWriter::~ColumnWriter()
+{
+	if (m_Descriptor < 0)
+	{
+		return;
+	}
+	try
+	{
+		this->Close();
+	}
+	catch (const std::runtime_error& error)
+	{
+		std::cout << error.what() << std::endl;
+	}
+}
+
+void ColumnWriter::Append(const double* x, const double* y, size_t count)
+{
+	if (m_Written + count > m_Header.points)
+	{
+		throw std::runtime_error("Too many points are appended to a column file");
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		size_t index = m_Written + i;
+		Extend(m_Bounds[index / m_Header.chunkPoints], x[i], y[i]);
+		if (index > 0 && !(x[i] >= m_LastX))
+		{
+			m_IsSorted = false;
+		}
+		m_LastX = x[i];
+	}
+	this->WriteColumn(x, count, m_Header.xType, m_Header.xOffset, m_Written);
+	this->WriteColumn(y, count, m_Header.yType, m_Header.yOffset, m_Written);
+	m_Written += count;
+}
+
+void ColumnWriter::Close()
+{
+	if (m_Descriptor < 0)
+	{
+		return;
+	}
+	int descriptor = m_Descriptor;
+	m_Descriptor = -1;
+	if (m_Written != m_Header.points)
+	{
+		::close(descriptor);
+		throw std::runtime_error("Column file is closed with " + std::to_string(m_Written) + " of " + std::to_string(m_Header.points) + " points");
+	}
+
+	if (m_IsSorted)
+	{
+		m_Header.flags |= ColumnFile::Flags_XSorted;
+	}
+	size_t boundsBytes = m_Bounds.size() * sizeof(ColumnFile::Bounds);
+	bool written = ::pwrite(descriptor, m_Bounds.data(), boundsBytes, m_Header.boundsOffset) == static_cast<ssize_t>(boundsBytes)
+		&& ::pwrite(descriptor, &m_Header, sizeof(m_Header), 0) == static_cast<ssize_t>(sizeof(m_Header));
+	::close(descriptor);
+	if (!written)
+	{
+		throw std::runtime_error("Failed to write column file header");
+	}
+}
+
+void ColumnWriter::WriteColumn(const double* values, size_t count, ColumnFile::Type type, uint64_t offset, size_t index)
+{
+	const void* data = values;
+	size_t size = ColumnFile::TypeSize(type);
+	if (type == ColumnFile::Type::Float32)
+	{
+		m_Buffer.resize(count * sizeof(float));
+		float* converted = reinterpret_cast<float*>(m_Buffer.data());
+		for (size_t i = 0; i < count; i++)
+		{
+			converted[i] = static_cast<float>(values[i]);
+		}
+		data = converted;
+	}
+
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	size_t remaining = count * size;
+	uint64_t position = offset + index * size;
+	while (remaining > 0)
+	{
+		ssize_t written = ::pwrite(m_Descriptor, bytes, remaining, position);
+		if (written <= 0)
+		{
+			throw std::runtime_error(std::string("Failed to write column file: ") + std::strerror(errno));
+		}
+		bytes += written;
+		remaining -= written;
+		position += written;
+	}
+}
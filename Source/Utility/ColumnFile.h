@@ -0,0 +1,152 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * 	ColumnFile is a read-only memory-mapped file of 2D points in columnar layout
+ *
+ * 	The file consists of:
+ * 	-	a fixed-size Header;
+ * 	-	x column, i.e. all x coordinates one after another, as float32 or float64;
+ * 	-	y column with the same amount of values, as float32 or float64;
+ * 	-	optional per-chunk bounds, one Bounds structure per chunk.
+ * 	Points are split into chunks of Header::chunkPoints points, the last chunk may be smaller.
+ * 	Columns and bounds start at offsets, that are aligned to 64 bytes. All values are little-endian
+ *
+ * 	Opening a file only maps it and reads the header and the bounds, so it takes the same time for any file size.
+ * 	Column data is paged in by the OS when it is accessed, e.g. when visible chunks are uploaded to GPU.
+ * 	If the file has no bounds, they are computed once on open, which reads the whole file.
+ * 	For files with sorted x coordinates only the first and the last x of each chunk are read then,
+ * 	and y-bounds of chunks are left infinite
+ *
+ * 	Files are written with ColumnWriter below. Constructor throws std::runtime_error if the file can't be opened or is malformed
+ */
+class ColumnFile
+{
+public:
+	enum class Type : uint32_t
+	{
+		Float32 = 0,
+		Float64 = 1,
+	};
+
+	enum Flags : uint32_t
+	{
+		Flags_None = 0,
+		// per-chunk bounds are stored in the file
+		Flags_Bounds = 1 << 0,
+		// x coordinates never decrease
+		Flags_XSorted = 1 << 1,
+	};
+
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t flags;
+		Type xType;
+		Type yType;
+		uint64_t points;
+		uint64_t chunkPoints;
+		// offsets of columns and bounds from the beginning of the file in bytes. boundsOffset is 0 if there are no bounds
+		uint64_t xOffset;
+		uint64_t yOffset;
+		uint64_t boundsOffset;
+		uint64_t reserved[4];
+	};
+
+	struct Bounds
+	{
+		double xMin, xMax;
+		double yMin, yMax;
+	};
+
+	static constexpr char s_Magic[8] = { 'C', 'P', 'C', 'O', 'L', 'U', 'M', 'N' };
+	static constexpr uint32_t s_Version = 1;
+	static constexpr size_t s_Alignment = 64;
+public:
+	explicit ColumnFile(const std::string& path);
+	ColumnFile(const ColumnFile&) = delete;
+	ColumnFile& operator=(const ColumnFile&) = delete;
+	// Unmaps and closes the file
+	~ColumnFile();
+
+	// Pointers to the value of the point with index i in the mapped columns
+	inline const void* XData(size_t i) const { return m_Data + m_Header.xOffset + i * TypeSize(m_Header.xType); }
+	inline const void* YData(size_t i) const { return m_Data + m_Header.yOffset + i * TypeSize(m_Header.yType); }
+	// Reads a single coordinate and converts it to double
+	double X(size_t i) const;
+	double Y(size_t i) const;
+
+	// Hints the OS, that the points of chunks [first; last) will be accessed soon
+	void Prefetch(size_t first, size_t last) const;
+	// Copies count points starting at begin into x and y buffers with pread() instead of the mapping,
+	// so that the I/O happens on the calling thread and never on a page fault elsewhere. Safe to call from any thread.
+	// Throws std::runtime_error on I/O errors
+	void Read(size_t begin, size_t count, void* x, void* y) const;
+
+	inline size_t ChunkBegin(size_t chunk) const { return chunk * m_Header.chunkPoints; }
+	inline size_t ChunkSize(size_t chunk) const { return std::min<size_t>(m_Header.chunkPoints, m_Header.points - ChunkBegin(chunk)); }
+	inline const Bounds& ChunkBounds(size_t chunk) const { return m_Bounds[chunk]; }
+
+	// Getters
+	inline const std::string& Path() const { return m_Path; }
+	inline const Header& GetHeader() const { return m_Header; }
+	inline size_t Points() const { return m_Header.points; }
+	inline size_t ChunkPoints() const { return m_Header.chunkPoints; }
+	inline size_t Chunks() const { return m_Bounds.size(); }
+	inline Type XType() const { return m_Header.xType; }
+	inline Type YType() const { return m_Header.yType; }
+	inline bool IsXSorted() const { return m_Header.flags & Flags_XSorted; }
+	// bounds of the whole file
+	inline const Bounds& GetBounds() const { return m_Total; }
+	inline size_t Bytes() const { return m_Size; }
+
+	static size_t TypeSize(Type type);
+private:
+	// computes bounds of chunks, if the file doesn't contain them
+	void ComputeBounds();
+private:
+	std::string m_Path;
+	int m_Descriptor = -1;
+	const unsigned char* m_Data = nullptr;
+	size_t m_Size = 0;
+
+	Header m_Header;
+	std::vector<Bounds> m_Bounds;
+	Bounds m_Total;
+};
+
+/**
+ * 	ColumnWriter writes a ColumnFile. The amount of points must be known in advance,
+ * 	then points are appended in any amount of calls and are never held in memory as a whole.
+ * 	Chunk bounds are always written, x-sorted flag is set if appended x coordinates never decrease
+ *
+ * 	File is finalized by Close() or by the destructor. Methods throw std::runtime_error on I/O errors
+ */
+class ColumnWriter
+{
+public:
+	ColumnWriter(const std::string& path, size_t points, ColumnFile::Type xType = ColumnFile::Type::Float32, ColumnFile::Type yType = ColumnFile::Type::Float32, size_t chunkPoints = 65536);
+	ColumnWriter(const ColumnWriter&) = delete;
+	ColumnWriter& operator=(const ColumnWriter&) = delete;
+	~ColumnWriter();
+
+	void Append(const double* x, const double* y, size_t count);
+	// Writes the header and bounds. Throws if less points than promised were appended
+	void Close();
+private:
+	// converts values to the column type and writes them at the given point index
+	void WriteColumn(const double* values, size_t count, ColumnFile::Type type, uint64_t offset, size_t index);
+private:
+	int m_Descriptor = -1;
+	ColumnFile::Header m_Header;
+	size_t m_Written = 0;
+	bool m_IsSorted = true;
+	double m_LastX;
+	std::vector<ColumnFile::Bounds> m_Bounds;
+	std::vector<unsigned char> m_Buffer;
+};
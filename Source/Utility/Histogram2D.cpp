@@ -0,0 +1,71 @@
+#include <Utility/Histogram2D.h>
+#include <Utility/Parallel.h>
+
+#include <mutex>
+#include <algorithm>
+
+// Threads are only worth it when each of them counts at least as many points, as there are bins to merge
+static constexpr size_t s_MinPointsPerThread = 1 << 18;
+
+void Histogram2D::Bin(const sol::Vec2f* points, size_t count, const Grid& grid)
+{
+	m_Grid = grid;
+	m_Counts.assign(grid.Bins(), 0);
+	m_MaxCount = 0;
+	if (grid.Bins() == 0)
+	{
+		return;
+	}
+
+	const float scaleX = 1.0f / grid.binSize.x;
+	const float scaleY = 1.0f / grid.binSize.y;
+	const float columns = static_cast<float>(grid.columns);
+	const float rows = static_cast<float>(grid.rows);
+	auto binPoints = [&](size_t begin, size_t end, std::vector<uint32_t>& counts)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			float column = (points[i].x - grid.origin.x) * scaleX;
+			float row = (points[i].y - grid.origin.y) * scaleY;
+			// the comparisons are false for NaN as well
+			if (column >= 0.0f && column < columns && row >= 0.0f && row < rows)
+			{
+				counts[static_cast<size_t>(row) * grid.columns + static_cast<size_t>(column)]++;
+			}
+		}
+	};
+
+	std::mutex mutex;
+	std::vector<std::vector<uint32_t>> partials;
+	size_t grain = std::max(s_MinPointsPerThread, grid.Bins());
+	Parallel::For(count, grain, [&](size_t begin, size_t end)
+	{
+		if (begin == 0)
+		{
+			// the calling thread counts straight into the result
+			binPoints(begin, end, m_Counts);
+			return;
+		}
+		std::vector<uint32_t> partial(grid.Bins(), 0);
+		binPoints(begin, end, partial);
+		std::lock_guard<std::mutex> lock(mutex);
+		partials.push_back(std::move(partial));
+	});
+
+	std::vector<uint32_t> maxCounts;
+	Parallel::For(grid.Bins(), 1 << 16, [&](size_t begin, size_t end)
+	{
+		uint32_t maxCount = 0;
+		for (size_t bin = begin; bin < end; bin++)
+		{
+			for (const std::vector<uint32_t>& partial : partials)
+			{
+				m_Counts[bin] += partial[bin];
+			}
+			maxCount = std::max(maxCount, m_Counts[bin]);
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		maxCounts.push_back(maxCount);
+	});
+	m_MaxCount = *std::max_element(maxCounts.begin(), maxCounts.end());
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <Utility/Matrix.h>
+
+/**
+ * 	Histogram2D counts 2D points in a regular grid of bins
+ *
+ * 	Bin() splits points between threads of Parallel::For(). Each thread counts its points into its own partial histogram,
+ * 	so there is no contention on shared counters, then partial histograms are summed bin by bin, also in parallel.
+ * 	Points outside of the grid and points with NaN coordinates are skipped.
+ *
+ * 	Row 0 is the bottom row of the grid, so the counts may be uploaded as a texture as they are
+ */
+class Histogram2D
+{
+public:
+	struct Grid
+	{
+		// bottom-left corner of the grid and the size of a single bin
+		sol::Vec2f origin = sol::Vec2f(0.0f);
+		sol::Vec2f binSize = sol::Vec2f(1.0f);
+		size_t columns = 0;
+		size_t rows = 0;
+
+		inline size_t Bins() const { return columns * rows; }
+		inline bool operator==(const Grid& other) const
+		{
+			return origin.x == other.origin.x && origin.y == other.origin.y && binSize.x == other.binSize.x && binSize.y == other.binSize.y
+				&& columns == other.columns && rows == other.rows;
+		}
+		inline bool operator!=(const Grid& other) const { return !(*this == other); }
+	};
+public:
+	Histogram2D() = default;
+
+	// Replaces the counts with the counts of points in the grid
+	void Bin(const sol::Vec2f* points, size_t count, const Grid& grid);
+
+	inline const Grid& GetGrid() const { return m_Grid; }
+	inline const std::vector<uint32_t>& Counts() const { return m_Counts; }
+	inline uint32_t MaxCount() const { return m_MaxCount; }
+private:
+	Grid m_Grid;
+	std::vector<uint32_t> m_Counts;
+	uint32_t m_MaxCount = 0;
+};
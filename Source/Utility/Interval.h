@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace sol
+{
+	/**
+	 * 	Interval represents a closed range of floats [lo; hi] and is used for interval arithmetic.
+	 *
+	 * 	Evaluating a function with an Interval argument instead of a float bounds the function over the whole range
+	 * 	at the cost of a single evaluation. Every operation rounds its result outwards by one ulp,
+	 * 	so bounds are always conservative: the real range of the function is never narrower than the result.
+	 *
+	 * 	Flag discontinuous is set if the function may be discontinuous or undefined somewhere inside the interval,
+	 * 	e.g. tan() over a pole, division by an interval containing zero or log() of non-positive values.
+	 * 	The flag is propagated through all operations.
+	 *
+	 * 	Functions can be written once for both floats and intervals as generic lambdas:
+	 * 		[](auto x) { using std::sin; return sin(x) / x; }
+	 * 	Unqualified calls find sol::sin() for intervals by argument-dependent lookup.
+	 */
+	struct Interval
+	{
+		float lo;
+		float hi;
+		bool discontinuous = false;
+
+		Interval() = default;
+		constexpr Interval(float value) : lo(value), hi(value) {}
+		constexpr Interval(float lo, float hi, bool discontinuous = false) : lo(lo), hi(hi), discontinuous(discontinuous) {}
+
+		inline bool Contains(float value) const { return lo <= value && value <= hi; }
+		// checks whether the interval intersects [min; max]
+		inline bool Overlaps(float min, float max) const { return lo <= max && hi >= min; }
+		inline float Width() const { return hi - lo; }
+
+		// the whole real line. Used when nothing can be told about the function
+		static constexpr Interval Entire(bool discontinuous = true)
+		{
+			return { -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), discontinuous };
+		}
+	};
+
+	namespace detail
+	{
+		inline float Down(float value) { return std::nextafter(value, -std::numeric_limits<float>::infinity()); }
+		inline float Up(float value) { return std::nextafter(value, std::numeric_limits<float>::infinity()); }
+
+		// makes an outward-rounded interval. NaN bounds mean that nothing is known about the result
+		inline Interval Make(float lo, float hi, bool discontinuous)
+		{
+			if (std::isnan(lo) || std::isnan(hi))
+			{
+				return Interval::Entire(true);
+			}
+			return { Down(lo), Up(hi), discontinuous };
+		}
+
+		// range of sin over [lo; hi] computed in double, so that the search of extrema is exact for float inputs
+		inline Interval SinRange(double lo, double hi, bool discontinuous)
+		{
+			constexpr double pi = M_PI;
+			if (!std::isfinite(lo) || !std::isfinite(hi) || hi - lo >= 2.0 * pi)
+			{
+				return { -1.0f, 1.0f, discontinuous };
+			}
+			float a = static_cast<float>(std::sin(lo));
+			float b = static_cast<float>(std::sin(hi));
+			float min = std::min(a, b);
+			float max = std::max(a, b);
+			// maxima are at pi/2 + 2*pi*k, minima are at -pi/2 + 2*pi*k
+			if (pi / 2.0 + 2.0 * pi * std::ceil((lo - pi / 2.0) / (2.0 * pi)) <= hi)
+			{
+				max = 1.0f;
+			}
+			if (-pi / 2.0 + 2.0 * pi * std::ceil((lo + pi / 2.0) / (2.0 * pi)) <= hi)
+			{
+				min = -1.0f;
+			}
+			Interval result = Make(min, max, discontinuous);
+			result.lo = std::max(result.lo, -1.0f);
+			result.hi = std::min(result.hi, 1.0f);
+			return result;
+		}
+	}
+
+	inline Interval operator+(const Interval& a, const Interval& b)
+	{
+		return detail::Make(a.lo + b.lo, a.hi + b.hi, a.discontinuous || b.discontinuous);
+	}
+
+	inline Interval operator-(const Interval& a, const Interval& b)
+	{
+		return detail::Make(a.lo - b.hi, a.hi - b.lo, a.discontinuous || b.discontinuous);
+	}
+
+	inline Interval operator-(const Interval& a)
+	{
+		return { -a.hi, -a.lo, a.discontinuous };
+	}
+
+	inline Interval operator*(const Interval& a, const Interval& b)
+	{
+		float p1 = a.lo * b.lo, p2 = a.lo * b.hi, p3 = a.hi * b.lo, p4 = a.hi * b.hi;
+		return detail::Make(std::min({ p1, p2, p3, p4 }), std::max({ p1, p2, p3, p4 }), a.discontinuous || b.discontinuous);
+	}
+
+	inline Interval operator/(const Interval& a, const Interval& b)
+	{
+		if (b.Contains(0.0f))
+		{
+			return Interval::Entire(true);
+		}
+		Interval reciprocal = detail::Make(1.0f / b.hi, 1.0f / b.lo, b.discontinuous);
+		return a * reciprocal;
+	}
+
+	inline Interval sin(const Interval& x)
+	{
+		return detail::SinRange(x.lo, x.hi, x.discontinuous);
+	}
+
+	inline Interval cos(const Interval& x)
+	{
+		return detail::SinRange(static_cast<double>(x.lo) + M_PI / 2.0, static_cast<double>(x.hi) + M_PI / 2.0, x.discontinuous);
+	}
+
+	inline Interval tan(const Interval& x)
+	{
+		constexpr double pi = M_PI;
+		double lo = x.lo, hi = x.hi;
+		// poles are at pi/2 + pi*k
+		if (!std::isfinite(lo) || !std::isfinite(hi) || hi - lo >= pi
+			|| pi / 2.0 + pi * std::ceil((lo - pi / 2.0) / pi) <= hi)
+		{
+			return Interval::Entire(true);
+		}
+		return detail::Make(std::tan(x.lo), std::tan(x.hi), x.discontinuous);
+	}
+
+	inline Interval exp(const Interval& x)
+	{
+		Interval result = detail::Make(std::exp(x.lo), std::exp(x.hi), x.discontinuous);
+		result.lo = std::max(result.lo, 0.0f);
+		return result;
+	}
+
+	inline Interval log(const Interval& x)
+	{
+		if (x.hi <= 0.0f)
+		{
+			return Interval::Entire(true);
+		}
+		if (x.lo <= 0.0f)
+		{
+			return { -std::numeric_limits<float>::infinity(), detail::Up(std::log(x.hi)), true };
+		}
+		return detail::Make(std::log(x.lo), std::log(x.hi), x.discontinuous);
+	}
+
+	inline Interval sqrt(const Interval& x)
+	{
+		if (x.hi < 0.0f)
+		{
+			return Interval::Entire(true);
+		}
+		Interval result = detail::Make(std::sqrt(std::max(x.lo, 0.0f)), std::sqrt(x.hi), x.discontinuous || x.lo < 0.0f);
+		result.lo = std::max(result.lo, 0.0f);
+		return result;
+	}
+
+	inline Interval abs(const Interval& x)
+	{
+		if (x.lo >= 0.0f)
+		{
+			return x;
+		}
+		if (x.hi <= 0.0f)
+		{
+			return -x;
+		}
+		return { 0.0f, std::max(-x.lo, x.hi), x.discontinuous };
+	}
+
+	// x^2 is tighter than x * x, as both factors are the same variable
+	inline Interval sqr(const Interval& x)
+	{
+		Interval a = abs(x);
+		Interval result = detail::Make(a.lo * a.lo, a.hi * a.hi, x.discontinuous);
+		result.lo = std::max(result.lo, 0.0f);
+		return result;
+	}
+
+	inline float sqr(float x) { return x * x; }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+
+/**
+ * 	Bounded lock-free multi-producer single-consumer queue
+ *
+ * 	Queue is a ring of cells, each cell holds a value and a sequence number, that tells whether
+ * 	the cell is free for the producer of the current lap or filled for the consumer of the current lap
+ * 	(see D. Vyukov's bounded MPMC queue, the consumer side of which is simplified to a single thread).
+ * 	Producers claim cells with a CAS on the enqueue position, so TryPush() never blocks and never allocates.
+ * 	If the queue is full, TryPush() fails and it is up to the producer to drop, retry or coalesce the value.
+ *
+ * 	TryPop() must only be called from a single thread, e.g. the render thread.
+ * 	Capacity is rounded up to a power of two
+ */
+template<typename T>
+class MPSCQueue
+{
+public:
+	explicit MPSCQueue(size_t capacity)
+	{
+		if (capacity < 2)
+		{
+			throw std::invalid_argument("MPSCQueue capacity must be at least 2");
+		}
+		m_Capacity = 1;
+		while (m_Capacity < capacity)
+		{
+			m_Capacity *= 2;
+		}
+		m_Mask = m_Capacity - 1;
+		m_Cells = std::make_unique<Cell[]>(m_Capacity);
+		for (size_t i = 0; i < m_Capacity; i++)
+		{
+			m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+	// Safe to call from any thread. Returns false if the queue is full, value is left untouched then
+	bool TryPush(T&& value)
+	{
+		size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Cell& cell = m_Cells[position & m_Mask];
+			size_t sequence = cell.sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+			if (difference == 0)
+			{
+				// the cell is free on this lap, try to claim it
+				if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					cell.value = std::move(value);
+					cell.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				// the cell still holds a value of the previous lap
+				return false;
+			}
+			else
+			{
+				// another producer claimed the cell, retry with the new position
+				position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Must only be called from the consumer thread. Returns false if the queue is empty
+	bool TryPop(T& value)
+	{
+		Cell& cell = m_Cells[m_DequeuePosition & m_Mask];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		if (sequence != m_DequeuePosition + 1)
+		{
+			// the cell is either empty or is still being written by the producer
+			return false;
+		}
+		value = std::move(cell.value);
+		cell.sequence.store(m_DequeuePosition + m_Capacity, std::memory_order_release);
+		m_DequeuePosition++;
+		return true;
+	}
+
+	inline size_t Capacity() const { return m_Capacity; }
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+	// producers and the consumer touch different positions, keep them on different cache lines
+	static constexpr size_t s_CacheLine = 64;
+private:
+	std::unique_ptr<Cell[]> m_Cells;
+	size_t m_Capacity;
+	size_t m_Mask;
+
+	alignas(s_CacheLine) std::atomic<size_t> m_EnqueuePosition = 0;
+	alignas(s_CacheLine) size_t m_DequeuePosition = 0;
+};
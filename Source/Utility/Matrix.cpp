@@ -1,336 +1,55 @@
 #include <Utility/Matrix.h>
 
-#include <cstddef>
-#include <iostream>
-#include <cmath>
+// SIMD paths load Vec4f as 4 packed floats and rows of Mat4f with aligned loads
+static_assert(sizeof(sol::Vec4f) == 4 * sizeof(float), "Vec4f must be 4 packed floats");
+static_assert(alignof(sol::Mat4f) == 16 && sizeof(sol::Mat4f) == 16 * sizeof(float), "Rows of Mat4f must be 16-byte aligned");
+static_assert(sizeof(sol::Affine2f) == 6 * sizeof(float), "Affine2f is uploaded as 6 packed floats");
 
-namespace sol
+// Compile-time tests of sol. They are evaluated by every build, that compiles this file, so a broken operation fails the build
+namespace
 {
-	Vec<float, 4>::Vec(float scalar)
-	{
-		this->x = scalar;
-		this->y = scalar;
-		this->z = scalar;
-		this->w = scalar;
-	}
-	Vec<float, 4>::Vec(float x, float y, float z, float w)
-	{
-		this->x = x;
-		this->y = y;
-		this->z = z;
-		this->w = w;
-	}
-	Vec<float, 4>::Vec(float x, const Vec<float, 3>& yzw)
-	{
-		this->x = x;
-		this->y = yzw.x;
-		this->z = yzw.y;
-		this->z = yzw.z;
-	}
-	Vec<float, 4>::Vec(const Vec<float, 3>& xyz, float w)
-	{
-		this->x = xyz.x;
-		this->y = xyz.y;
-		this->z = xyz.z;
-		this->w = w;
-	}
-	Vec<float, 4>::Vec(float x, const Vec<float, 2>& yz, float w)
-	{
-		this->x = x;
-		this->y = yz.x;
-		this->z = yz.y;
-		this->w = w;
-	}
-	Vec<float, 4>::Vec(const Vec<float, 2>& xy, float z, float w)
-	{
-		this->x = xy.x;
-		this->y = xy.y;
-		this->z = z;
-		this->w = w;
-	}
-	Vec<float, 4>::Vec(float x, float y, const Vec<float, 2>& zw)
-	{
-		this->x = x;
-		this->y = y;
-		this->z = zw.x;
-		this->w = zw.y;
-	}
-	const float& Vec<float, 4>::operator[](size_t i) const { return *(reinterpret_cast<const float*>(this) + i); }
-	float& Vec<float, 4>::operator[](size_t i) { return *(reinterpret_cast<float*>(this) + i); }
-	Vec4f Vec<float, 4>::operator*(float scalar) const
-	{
-		return { this->x * scalar, this->y * scalar, this->z * scalar, this->w * scalar };
-	}
-	Vec4f Vec<float, 4>::operator+(const Vec4f& other) const
-	{
-		return { this->x + other.x, this->y + other.y, this->z + other.z, this->w + other.w };
-	}
-
-
-
-	Vec<float, 3>::Vec(float scalar)
-	{
-		this->x = scalar;
-		this->y = scalar;
-		this->z = scalar;
-	}
-	Vec<float, 3>::Vec(float x, float y, float z)
-	{
-		this->x = x;
-		this->y = y;
-		this->z = z;
-	}
-	Vec<float, 3>::Vec(const Vec<float, 2>& xy, float z)
-	{
-		this->x = xy.x;
-		this->y = xy.y;
-		this->z = z;
-	}
-	Vec<float, 3>::Vec(float x, const Vec<float, 2>& yz)
-	{
-		this->x = x;
-		this->y = yz.x;
-		this->z = yz.y;
-	}
-	Vec<float, 3>::Vec(const Vec4f& v)
-	{
-		this->x = v.x;
-		this->y = v.y;
-		this->z = v.z;
-	}
-	const float& Vec<float, 3>::operator[](size_t i) const { return *(reinterpret_cast<const float*>(this) + i); }
-	Vec3f Vec<float, 3>::operator*(float scalar) const
-	{
-		return { this->x * scalar, this->y * scalar, this->z * scalar };
-	}
-	Vec3f Vec<float, 3>::operator+(const Vec3f& other) const
-	{
-		return { this->x + other.x, this->y + other.y, this->z + other.z };
-	}
-	Vec3f Vec<float, 3>::operator-(const Vec3f& other) const
-	{
-		return *this + Vec3f(-other.x, -other.y, -other.z);
-	}
-	Vec3f Vec<float, 3>::operator-() const
-	{
-		return { -this->x, -this->y, -this->z };
-	}
-
-
-
-	Vec<float, 2>::Vec(float scalar)
-	{
-		this->x = scalar;
-		this->y = scalar;
-	}
-	Vec<float, 2>::Vec(float x, float y)
-	{
-		this->x = x;
-		this->y = y;
-	}
-	Vec<float, 2>::Vec(const Vec3f& v)
-	{
-		this->x = v.x;
-		this->y = v.y;
-	}
-	Vec<float, 2>::Vec(const Vec4f& v)
-	{
-		this->x = v.x;
-		this->y = v.y;
-	}
-	bool Vec<float, 2>::operator==(const Vec2f& other) const
-	{
-		return (this->x == other.x && this->y == other.y);
-	}
-	bool Vec<float, 2>::operator!=(const Vec2f& other) const
-	{
-		return !(*this == other);
-	}
-
-
-
-	Mat<Mat4f::T, 4, 4>::Mat(T scalar)
-	{
-		row[0] = Vec4f(scalar, 0.0f, 0.0f, 0.0f);
-		row[1] = Vec4f(0.0f, scalar, 0.0f, 0.0f);
-		row[2] = Vec4f(0.0f, 0.0f, scalar, 0.0f);
-		row[3] = Vec4f(0.0f, 0.0f, 0.0f, scalar);
-	}
-	Mat<Mat4f::T, 4, 4>::Mat(
-		const Vec4f& v1, 
-		const Vec4f& v2, 
-		const Vec4f& v3, 
-		const Vec4f& v4)
-	{
-		row[0] = v1;
-		row[1] = v2;
-		row[2] = v3;
-		row[3] = v4;
-	}
-	Vec4f Mat<Mat4f::T, 4, 4>::operator*(const Vec4f& v4) const
-	{
-		return 
-		{
-			(*this)[0][0] * v4.x + (*this)[0][1] * v4.y + (*this)[0][2] * v4.z + (*this)[0][3] * v4.w, 
-			(*this)[1][0] * v4.x + (*this)[1][1] * v4.y + (*this)[1][2] * v4.z + (*this)[1][3] * v4.w,
-			(*this)[2][0] * v4.x + (*this)[2][1] * v4.y + (*this)[2][2] * v4.z + (*this)[2][3] * v4.w,
-			(*this)[3][0] * v4.x + (*this)[3][1] * v4.y + (*this)[3][2] * v4.z + (*this)[3][3] * v4.w
-		};
-	}
-	Mat4f Mat<Mat4f::T, 4, 4>::operator*(const Mat4f& m4) const
-	{
-		Mat4f result(1.0f);
-		for (size_t r = 0; r < 4; r++)
-		{
-			for (size_t c = 0; c < 4; c++)
-			{
-				result[r][c] = (*this)[r][0] * m4[0][c]
-					+ (*this)[r][1] * m4[1][c]
-					+ (*this)[r][2] * m4[2][c]
-					+ (*this)[r][3] * m4[3][c];
-			}
-		}
-		return result;
-	}
-	const Mat4f::Row_Type& Mat<Mat4f::T, 4, 4>::operator[](size_t i) const { return this->row[i]; }
-	Mat4f::Row_Type& Mat<Mat4f::T, 4, 4>::operator[](size_t i) { return this->row[i]; }
-
-
-
-	Vec3f Normalize(const Vec3f& v3) 
-	{
-		float magnitude = sqrtf(v3.x*v3.x + v3.y*v3.y + v3.z*v3.z);
-		return { v3.x / magnitude, v3.y / magnitude, v3.z / magnitude };
-	}
-
-	// https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/cross.xhtml
-	Vec3f Cross(const Vec3f& u, const Vec3f& v)
-	{
-		return
-		{
-			u[1] * v[2] - v[1] * u[2],
-			u[2] * v[0] - v[2] * u[0],
-			u[0] * v[1] - v[0] * u[1]
-		};
-	}
-
-	Mat4f Transpose(const Mat4f& m)
-	{
-		return
-		{
-			Vec4f(m[0][0], m[1][0], m[2][0], m[3][0]),
-			Vec4f(m[0][1], m[1][1], m[2][1], m[3][1]),
-			Vec4f(m[0][2], m[1][2], m[2][2], m[3][2]),
-			Vec4f(m[0][3], m[1][3], m[2][3], m[3][3])
-		};
-	}
-
-	Mat4f Translate(const Mat4f& m, const Vec3f& v)
-	{
-		Mat4f result(m);
-		result[3] = m[0]*v[0] + m[1]*v[1] + m[2]*v[2] + m[3];
-		return Transpose(result);
-	}
-
-	// https://en.wikipedia.org/wiki/Rotation_matrix
-	Mat4f RotateX(float t)
-	{
-		return
-		{
-			Vec4f(1.0f, 0.0f, 0.0f, 0.0f),
-			Vec4f(0.0f, cos(t), sin(t), 0.0f),
-			Vec4f(0.0f, -sin(t), cos(t), 0.0f),
-			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
-		};
-	}
-	Mat4f RotateY(float t)
-	{
-		return
-		{
-			Vec4f(cos(t), 0.0f, -sin(t), 0.0f),
-			Vec4f(0.0f, 1.0f, 0.0f, 0.0f),
-			Vec4f(sin(t), 0.0f, cos(t), 0.0f),
-			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
-		};
-	}
-	Mat4f RotateZ(float t)
-	{
-		return
-		{
-			Vec4f(cos(t), -sin(t), 0.0f, 0.0f),
-			Vec4f(sin(t), cos(t), 0.0f, 0.0f),
-			Vec4f(0.0f, 0.0f, 1.0f, 0.0f),
-			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
-		};
-	}
-
-	Mat4f Scale(float scalar)
-	{
-		return 
-		{
-			Vec4f(scalar, 0.0f, 0.0f, 0.0f),
-			Vec4f(0.0f, scalar, 0.0f, 0.0f),
-			Vec4f(0.0f, 0.0f, scalar, 0.0f),
-			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
-		};
-	}
-
-	Mat4f Scale(const sol::Vec3f& scalar)
-	{
-		return 
-		{
-			Vec4f(scalar.x, 0.0f, 0.0f, 0.0f),
-			Vec4f(0.0f, scalar.y, 0.0f, 0.0f),
-			Vec4f(0.0f, 0.0f, scalar.z, 0.0f),
-			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
-		};
-	}
-
-
-	// https://www.scratchapixel.com/lessons/3d-basic-rendering/perspective-and-orthographic-projection-matrix/building-basic-perspective-projection-matrix
-	// https://www.scratchapixel.com/lessons/3d-basic-rendering/perspective-and-orthographic-projection-matrix/opengl-perspective-projection-matrix
-	Mat4f Perspective(float fov, float aspectRatio, float zNear, float zFar)
-	{
-		float top = tan(fov / 2.0f) * zNear;
-		float bottom = -top;
-		float right = top * aspectRatio;
-		float left = -right;
-
-		Mat4f result(0.0f);
-		
-		result[0][0] = (2 * zNear) / (right - left);
-		result[1][1] = (2 * zNear) / (top - bottom);
-		result[2][0] = (right + left) / (right - left);
-		result[2][1] = (top + bottom) / (top - bottom);
-		result[2][2] = - (zFar + zNear) / (zFar - zNear);
-		result[2][3] = -1.0f;
-		result[3][2] = - (2 * zFar * zNear) / (zFar - zNear);
-		
-		return result;
-	}
-
-	// https://www.scratchapixel.com/lessons/mathematics-physics-for-computer-graphics/lookat-function
-	// https://www.geertarien.com/blog/2017/07/30/breakdown-of-the-lookAt-function-in-OpenGL/
-	Mat4f LookAt(const Vec3f& from, const Vec3f& to, const Vec3f& up)
-	{
-		Vec3f f = Normalize(to - from);
-		Vec3f r = Normalize(Cross(f, up));
-		Vec3f u = Cross(r, f);
-
-		Mat4f result(1.0f);
-
-		result[0][0] = r.x;
-		result[0][1] = r.y;
-		result[0][2] = r.z;
-		result[1][0] = u.x;
-		result[1][1] = u.y;
-		result[1][2] = u.z;
-		result[2][0] = f.x;
-		result[2][1] = f.y;
-		result[2][2] = f.z;
-		result[3][0] = -from.x;
-		result[3][1] = -from.y;
-		result[3][2] = -from.z;
-		return result;
-	}
-}
\ No newline at end of file
+	using namespace sol;
+
+	constexpr bool Near(float a, float b, float epsilon = 1e-6f) { return (a > b ? a - b : b - a) <= epsilon; }
+	constexpr bool Near(const Vec4f& u, const Vec4f& v) { return Near(u.x, v.x) && Near(u.y, v.y) && Near(u.z, v.z) && Near(u.w, v.w); }
+	constexpr bool Near(const Vec3f& u, const Vec3f& v) { return Near(u.x, v.x) && Near(u.y, v.y) && Near(u.z, v.z); }
+	constexpr bool Near(const Vec2f& u, const Vec2f& v) { return Near(u.x, v.x) && Near(u.y, v.y); }
+	constexpr bool Near(const Mat4f& a, const Mat4f& b) { return Near(a[0], b[0]) && Near(a[1], b[1]) && Near(a[2], b[2]) && Near(a[3], b[3]); }
+
+	constexpr Mat4f s_Matrix = Mat4f(Vec4f(1, 2, 3, 4), Vec4f(5, 6, 7, 8), Vec4f(9, 10, 11, 12), Vec4f(13, 14, 15, 16));
+
+	// vectors
+	static_assert(Vec4f(1.0f, Vec3f(2, 3, 4)).w == 4.0f, "Vec4f(x, yzw) must set w");
+	static_assert(Vec4f(1, 2, 3, 4)[2] == 3.0f && Vec3f(1, 2, 3)[1] == 2.0f, "Components are indexed in order");
+	static_assert(Near(Vec4f(1, 2, 3, 4) * 2.0f + Vec4f(1.0f), Vec4f(3, 5, 7, 9)), "Vec4f arithmetic");
+	static_assert(Near(Vec3f(1, 2, 3) - Vec3f(3, 2, 1), Vec3f(-2, 0, 2)) && Near(-Vec3f(1, 0, 0), Vec3f(-1, 0, 0)), "Vec3f arithmetic");
+	static_assert(Vec2f(Vec4f(1, 2, 3, 4)) == Vec2f(1, 2) && Vec2f(1, 2) != Vec2f(2, 1), "Vec2f comparison");
+	static_assert(Dot(Vec3f(1, 2, 3), Vec3f(4, 5, 6)) == 32.0f, "Dot product");
+	static_assert(Near(Cross(Vec3f(1, 0, 0), Vec3f(0, 1, 0)), Vec3f(0, 0, 1)), "Cross product is right-handed");
+	static_assert(Near(Normalize(Vec3f(3, 0, 4)), Vec3f(0.6f, 0.0f, 0.8f)), "Normalize");
+
+	// compile-time sqrt and trigonometry
+	static_assert(Near(detail::Sqrt(2.0f), 1.41421356f) && detail::Sqrt(0.0f) == 0.0f && Near(detail::Sqrt(1e30f), 1e15f, 1e9f), "Sqrt");
+	static_assert(Near(detail::Sin(Radians(30.0f)), 0.5f) && Near(detail::Cos(Radians(60.0f)), 0.5f), "Sin and Cos");
+	static_assert(Near(detail::Sin(Radians(390.0f)), 0.5f) && Near(detail::Cos(-Radians(240.0f)), -0.5f), "Angles are reduced to [-pi; pi]");
+	static_assert(Near(detail::Tan(Radians(45.0f)), 1.0f), "Tan");
+
+	// matrices
+	static_assert(Near(Mat4f(1.0f) * s_Matrix, s_Matrix) && Near(s_Matrix * Mat4f(1.0f), s_Matrix), "Identity is neutral");
+	static_assert(Near(s_Matrix * Vec4f(1, 0, 0, 1), Vec4f(5, 13, 21, 29)), "Matrix is applied to column vectors");
+	static_assert(Near((s_Matrix * s_Matrix)[1], Vec4f(202, 228, 254, 280)), "Matrix product");
+	static_assert(Near(Transpose(s_Matrix)[0], Vec4f(1, 5, 9, 13)) && Near(Transpose(Transpose(s_Matrix)), s_Matrix), "Transpose");
+	static_assert(Near(Translate(Mat4f(1.0f), Vec3f(1, 2, 3)) * Vec4f(1, 1, 1, 1), Vec4f(2, 3, 4, 1)), "Translate");
+	static_assert(Near(RotateZ(Radians(90.0f)) * Vec4f(1, 0, 0, 1), Vec4f(0, 1, 0, 1)), "RotateZ is counter-clockwise");
+	static_assert(Near(Scale(Vec3f(2, 3, 4)) * Vec4f(1.0f), Vec4f(2, 3, 4, 1)), "Scale");
+	static_assert(Near(LookAt(Vec3f(0, 0, 3), Vec3f(0.0f))[2], Vec4f(0, 0, -1, 0)) && Near(LookAt(Vec3f(0, 0, 3), Vec3f(0.0f))[3], Vec4f(0, 0, -3, 1)), "LookAt");
+	static_assert(Near(Perspective(Radians(90.0f), 1.0f, 1.0f, 3.0f)[0][0], 1.0f) && Near(Perspective(Radians(90.0f), 1.0f, 1.0f, 3.0f)[2][2], -2.0f)
+		&& Near(Perspective(Radians(90.0f), 1.0f, 1.0f, 3.0f)[3][2], -3.0f), "Perspective");
+
+	// affine transforms
+	constexpr Affine2f s_Model = TRS(Vec2f(3, -2), Radians(90.0f), Vec2f(2, 0.5f));
+	static_assert(Near(s_Model * Vec2f(1, 0), Vec2f(3, 0)) && Near(s_Model * Vec2f(0, 2), Vec2f(2, -2)), "TRS scales, rotates, then translates");
+	static_assert(Near(Inverse(s_Model) * (s_Model * Vec2f(1.5f, -4.0f)), Vec2f(1.5f, -4.0f)), "Inverse undoes the transform");
+	static_assert(Near((s_Model * Affine2f(1.0f)) * Vec2f(1, 1), s_Model * Vec2f(1, 1)), "Identity is neutral");
+	static_assert(Near((s_Model * TRS(Vec2f(1, 1), 0.0f, Vec2f(1.0f))) * Vec2f(0.0f), s_Model * Vec2f(1, 1)), "Composition applies the right transform first");
+}
@@ -1,5 +1,33 @@
 #pragma once
 
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+// SIMD paths of sol are chosen at compile time. SSE is enabled on every x86-64 build, AVX and FMA only if the compiler
+// targets them, e.g. with -march=native. SOL_NO_SIMD forces the scalar fallback
+#if !defined(SOL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define SOL_SSE
+#include <immintrin.h>
+#if defined(__AVX__)
+#define SOL_AVX
+#endif
+#if defined(__FMA__)
+#define SOL_FMA
+#endif
+#endif
+
+// Operations are constexpr. In constant evaluation they take scalar paths and compile-time versions of sqrt and trigonometry,
+// at run time they take SIMD paths and the standard library. Without the builtin, that tells them apart,
+// scalar paths are taken always
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define SOL_HAS_CONSTANT_EVALUATED
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define SOL_HAS_CONSTANT_EVALUATED
+#endif
+
 namespace sol
 {
 	template<typename T, size_t N>
@@ -12,6 +40,8 @@ namespace sol
 	typedef Vec<float, 3> Vec3f;
 	typedef Vec<float, 2> Vec2f;
 
+	// Vec4f isn't over-aligned, as it is a member of Vertex, which layout is shared with GPU buffers and files.
+	// SIMD paths load it unaligned
 	template<> struct Vec<float, 4>
 	{
 		union {float x, r;};
@@ -20,18 +50,18 @@ namespace sol
 		union {float w, a;};
 
 		Vec() = default;
-		Vec(float scalar);
-		Vec(float x, float y, float z, float w);
-		Vec(float x, const Vec<float, 3>& yzw);
-		Vec(const Vec<float, 3>& xyz, float w);
-		Vec(float x, const Vec<float, 2>& yz, float w);
-		Vec(const Vec<float, 2>& xy, float z, float w);
-		Vec(float x, float y, const Vec<float, 2>& zw);
-
-		const float& operator[](size_t i) const;
-		float& operator[](size_t i);
-		Vec<float, 4> operator*(float scalar) const;
-		Vec<float, 4> operator+(const Vec<float, 4>& other) const;
+		constexpr Vec(float scalar);
+		constexpr Vec(float x, float y, float z, float w);
+		constexpr Vec(float x, const Vec<float, 3>& yzw);
+		constexpr Vec(const Vec<float, 3>& xyz, float w);
+		constexpr Vec(float x, const Vec<float, 2>& yz, float w);
+		constexpr Vec(const Vec<float, 2>& xy, float z, float w);
+		constexpr Vec(float x, float y, const Vec<float, 2>& zw);
+
+		constexpr const float& operator[](size_t i) const;
+		constexpr float& operator[](size_t i);
+		constexpr Vec<float, 4> operator*(float scalar) const;
+		constexpr Vec<float, 4> operator+(const Vec<float, 4>& other) const;
 	};
 
 	template<> struct Vec<float, 3>
@@ -41,17 +71,17 @@ namespace sol
 		union {float z, b;};
 
 		Vec() = default;
-		Vec(float scalar);
-		Vec(float x, float y, float z);
-		Vec(const Vec<float, 2>& xy, float z);
-		Vec(float x, const Vec<float, 2>& yz);
-		Vec(const Vec<float, 4>& v);
-
-		const float& operator[](size_t i) const;
-		Vec<float, 3> operator*(float scalar) const;
-		Vec<float, 3> operator+(const Vec<float, 3>& other) const;
-		Vec<float, 3> operator-(const Vec<float, 3>& other) const;
-		Vec<float, 3> operator-() const;
+		constexpr Vec(float scalar);
+		constexpr Vec(float x, float y, float z);
+		constexpr Vec(const Vec<float, 2>& xy, float z);
+		constexpr Vec(float x, const Vec<float, 2>& yz);
+		constexpr Vec(const Vec<float, 4>& v);
+
+		constexpr const float& operator[](size_t i) const;
+		constexpr Vec<float, 3> operator*(float scalar) const;
+		constexpr Vec<float, 3> operator+(const Vec<float, 3>& other) const;
+		constexpr Vec<float, 3> operator-(const Vec<float, 3>& other) const;
+		constexpr Vec<float, 3> operator-() const;
 	};
 
 	template<> struct Vec<float, 2>
@@ -60,13 +90,13 @@ namespace sol
 		union {float y, g;};
 		
 		Vec() = default;
-		Vec(float scalar);
-		Vec(float x, float y);
-		Vec(const Vec<float, 3>& v);
-		Vec(const Vec<float, 4>& v);
+		constexpr Vec(float scalar);
+		constexpr Vec(float x, float y);
+		constexpr Vec(const Vec<float, 3>& v);
+		constexpr Vec(const Vec<float, 4>& v);
 
-		bool operator==(const Vec<float, 2>& other) const;
-		bool operator!=(const Vec<float, 2>& other) const;
+		constexpr bool operator==(const Vec<float, 2>& other) const;
+		constexpr bool operator!=(const Vec<float, 2>& other) const;
 	};
 
 	template<typename T, size_t R, size_t C> 
@@ -77,7 +107,8 @@ namespace sol
 
 	typedef Mat<float, 4, 4> Mat4f;
 
-	template<> struct Mat<float, 4, 4>
+	// Rows are 16-byte aligned, so SIMD paths load them with aligned loads
+	template<> struct alignas(16) Mat<float, 4, 4>
 	{
 		using T = float;
 		using Row_Type = Vec4f;
@@ -87,39 +118,71 @@ namespace sol
 		Row_Type row[4];
 
 		Mat() = default;
-		Mat(T scalar);
-		Mat(const Row_Type& v1, const Row_Type& v2, const Row_Type& v3, const Row_Type& v4);
+		constexpr Mat(T scalar);
+		constexpr Mat(const Row_Type& v1, const Row_Type& v2, const Row_Type& v3, const Row_Type& v4);
+
+		constexpr Row_Type operator*(const Row_Type& v4) const;
+		constexpr Type operator*(const Type& v4) const;
+		constexpr const Row_Type& operator[](size_t i) const;
+		constexpr Row_Type& operator[](size_t i);
+	};
 
-		Row_Type operator*(const Row_Type& v4) const;
-		Type operator*(const Type& v4) const;
-		const Row_Type& operator[](size_t i) const;
-		Row_Type& operator[](size_t i);
+	/**
+	 * 	Affine2f is a 2x3 matrix of an affine 2D transform, e.g. a model matrix of an object. Objects are 2D,
+	 * 	so their transforms are composed, inverted and applied without 4x4 matrices, that are left for the camera
+	 *
+	 * 	Rows are (a, b, tx) and (c, d, ty), so a point is transformed as x' = ax + by + tx, y' = cx + dy + ty.
+	 * 	Rows are packed, so the matrix is uploaded as it is to a mat3x2 uniform with transposition
+	 */
+	struct Affine2f
+	{
+		Vec3f row[2];
+
+		Affine2f() = default;
+		// scalar on the diagonal and no translation, i.e. Affine2f(1.0f) is identity
+		constexpr Affine2f(float scalar);
+		constexpr Affine2f(const Vec3f& r1, const Vec3f& r2);
+
+		constexpr Vec2f operator*(const Vec2f& point) const;
+		// composition, the other transform is applied first
+		constexpr Affine2f operator*(const Affine2f& other) const;
+		constexpr const Vec3f& operator[](size_t i) const;
+		constexpr Vec3f& operator[](size_t i);
 	};
 
 	constexpr float Radians(float angle) { return angle * M_PI / 180.0f; }
-	Vec3f Normalize(const Vec3f& v3) ;
+	constexpr Vec3f Normalize(const Vec3f& v3);
 
 	// https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/cross.xhtml
-	Vec3f Cross(const Vec3f& u, const Vec3f& v);
+	constexpr Vec3f Cross(const Vec3f& u, const Vec3f& v);
 
 	constexpr float Dot(const Vec3f& u, const Vec3f& v) { return (u.x*v.x + u.y*v.y + u.z*v.z); }
 
-	Mat4f Transpose(const Mat4f& m);
-	Mat4f Translate(const Mat4f& m, const Vec3f& v);
+	constexpr Mat4f Transpose(const Mat4f& m);
+	constexpr Mat4f Translate(const Mat4f& m, const Vec3f& v);
 
 	// https://en.wikipedia.org/wiki/Rotation_matrix
-	Mat4f RotateX(float t);
-	Mat4f RotateY(float t);
-	Mat4f RotateZ(float t);
+	constexpr Mat4f RotateX(float t);
+	constexpr Mat4f RotateY(float t);
+	constexpr Mat4f RotateZ(float t);
+
+	// Translation * rotation * scale, i.e. points are scaled, rotated counter-clockwise by angle radians and translated
+	constexpr Affine2f TRS(const Vec2f& translation, float angle, const Vec2f& scale);
+	// Inverse of a non-degenerate transform
+	constexpr Affine2f Inverse(const Affine2f& m);
 
-	Mat4f Scale(float scalar);
-	Mat4f Scale(const sol::Vec3f& scalar);
+	constexpr Mat4f Scale(float scalar);
+	constexpr Mat4f Scale(const sol::Vec3f& scalar);
 
 	// https://www.scratchapixel.com/lessons/3d-basic-rendering/perspective-and-orthographic-projection-matrix/building-basic-perspective-projection-matrix
 	// https://www.scratchapixel.com/lessons/3d-basic-rendering/perspective-and-orthographic-projection-matrix/opengl-perspective-projection-matrix
-	Mat4f Perspective(float fov, float aspectRatio, float zNear, float zFar);
+	constexpr Mat4f Perspective(float fov, float aspectRatio, float zNear, float zFar);
 
 	// https://www.scratchapixel.com/lessons/mathematics-physics-for-computer-graphics/lookat-function
 	// https://www.geertarien.com/blog/2017/07/30/breakdown-of-the-lookAt-function-in-OpenGL/
-	Mat4f LookAt(const Vec3f& from, const Vec3f& to, const Vec3f& up = Vec3f(0.0f, 1.0f, 0.0f));
+	constexpr Mat4f LookAt(const Vec3f& from, const Vec3f& to, const Vec3f& up = Vec3f(0.0f, 1.0f, 0.0f));
 }
+
+// Vector and matrix operations are defined in the header, so that they are inlined into per-object and per-vertex loops
+// and evaluated in constant expressions. Matrix.cpp contains their compile-time tests
+#include <Utility/Matrix.inl>
@@ -0,0 +1,559 @@
+#pragma once
+
+// Definitions of inline sol operations, included at the end of Matrix.h
+
+namespace sol
+{
+	namespace detail
+	{
+		constexpr bool IsConstantEvaluated()
+		{
+#ifdef SOL_HAS_CONSTANT_EVALUATED
+			return __builtin_is_constant_evaluated();
+#else
+			return true;
+#endif
+		}
+
+		// Compile-time sqrt and trigonometry. They are evaluated in double and are exact to float precision,
+		// at run time the standard library is used instead
+		constexpr double ConstantSqrt(double x)
+		{
+			if (!(x > 0.0))
+			{
+				return x == 0.0 ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+			}
+			// Newton's iterations decrease monotonically from above the root, until rounding stops them
+			double guess = x > 1.0 ? x : 1.0;
+			for (int i = 0; i < 1100; i++)
+			{
+				double next = 0.5 * (guess + x / guess);
+				if (next >= guess)
+				{
+					break;
+				}
+				guess = next;
+			}
+			return guess;
+		}
+
+		// Taylor series of sin after reduction of the angle to [-pi; pi]
+		constexpr double ConstantSin(double x)
+		{
+			constexpr double pi = 3.14159265358979323846;
+			double turns = x / (2.0 * pi);
+			x -= 2.0 * pi * static_cast<double>(static_cast<long long>(turns + (turns < 0.0 ? -0.5 : 0.5)));
+			double term = x, sum = x;
+			for (int n = 1; n < 16; n++)
+			{
+				term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+				sum += term;
+			}
+			return sum;
+		}
+
+		constexpr double ConstantCos(double x)
+		{
+			return ConstantSin(x + 3.14159265358979323846 / 2.0);
+		}
+
+		constexpr float Sqrt(float x) { return IsConstantEvaluated() ? static_cast<float>(ConstantSqrt(x)) : std::sqrt(x); }
+		constexpr float Sin(float x) { return IsConstantEvaluated() ? static_cast<float>(ConstantSin(x)) : std::sin(x); }
+		constexpr float Cos(float x) { return IsConstantEvaluated() ? static_cast<float>(ConstantCos(x)) : std::cos(x); }
+		constexpr float Tan(float x) { return IsConstantEvaluated() ? static_cast<float>(ConstantSin(x) / ConstantCos(x)) : std::tan(x); }
+
+#ifdef SOL_SSE
+		// a * b + c, fused if the target has FMA
+		inline __m128 MulAdd(__m128 a, __m128 b, __m128 c)
+		{
+#ifdef SOL_FMA
+			return _mm_fmadd_ps(a, b, c);
+#else
+			return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+		}
+
+#ifdef SOL_AVX
+		inline __m256 MulAdd(__m256 a, __m256 b, __m256 c)
+		{
+#ifdef SOL_FMA
+			return _mm256_fmadd_ps(a, b, c);
+#else
+			return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+		}
+#endif
+
+		// SIMD paths, that constexpr operations take at run time
+		inline Vec4f Multiply(const Vec4f& v, float scalar)
+		{
+			Vec4f result;
+			_mm_storeu_ps(&result.x, _mm_mul_ps(_mm_loadu_ps(&v.x), _mm_set1_ps(scalar)));
+			return result;
+		}
+
+		inline Vec4f Add(const Vec4f& u, const Vec4f& v)
+		{
+			Vec4f result;
+			_mm_storeu_ps(&result.x, _mm_add_ps(_mm_loadu_ps(&u.x), _mm_loadu_ps(&v.x)));
+			return result;
+		}
+
+		inline Vec4f Multiply(const Mat4f& m, const Vec4f& v4)
+		{
+			// products of rows and the vector are transposed, so that the four dot products are summed vertically
+			__m128 v = _mm_loadu_ps(&v4.x);
+			__m128 p0 = _mm_mul_ps(_mm_load_ps(&m.row[0].x), v);
+			__m128 p1 = _mm_mul_ps(_mm_load_ps(&m.row[1].x), v);
+			__m128 p2 = _mm_mul_ps(_mm_load_ps(&m.row[2].x), v);
+			__m128 p3 = _mm_mul_ps(_mm_load_ps(&m.row[3].x), v);
+			_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+			Vec4f result;
+			_mm_storeu_ps(&result.x, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+			return result;
+		}
+
+		inline Mat4f Multiply(const Mat4f& m, const Mat4f& m4)
+		{
+			// every element is written, so the result isn't initialized
+			Mat4f result;
+#if defined(SOL_AVX)
+			// two rows of the result at once: each lane of a row is broadcast within its half and multiplied by a row of m4
+			__m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m4.row[0].x));
+			__m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m4.row[1].x));
+			__m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m4.row[2].x));
+			__m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m4.row[3].x));
+			for (size_t r = 0; r < 4; r += 2)
+			{
+				__m256 a = _mm256_loadu_ps(&m.row[r].x);
+				__m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x00), b0);
+				sum = MulAdd(_mm256_shuffle_ps(a, a, 0x55), b1, sum);
+				sum = MulAdd(_mm256_shuffle_ps(a, a, 0xAA), b2, sum);
+				sum = MulAdd(_mm256_shuffle_ps(a, a, 0xFF), b3, sum);
+				_mm256_storeu_ps(&result.row[r].x, sum);
+			}
+#else
+			// a row of the result is a sum of rows of m4, weighted by lanes of the row of m
+			__m128 b0 = _mm_load_ps(&m4.row[0].x);
+			__m128 b1 = _mm_load_ps(&m4.row[1].x);
+			__m128 b2 = _mm_load_ps(&m4.row[2].x);
+			__m128 b3 = _mm_load_ps(&m4.row[3].x);
+			for (size_t r = 0; r < 4; r++)
+			{
+				__m128 a = _mm_load_ps(&m.row[r].x);
+				__m128 sum = _mm_mul_ps(_mm_shuffle_ps(a, a, 0x00), b0);
+				sum = MulAdd(_mm_shuffle_ps(a, a, 0x55), b1, sum);
+				sum = MulAdd(_mm_shuffle_ps(a, a, 0xAA), b2, sum);
+				sum = MulAdd(_mm_shuffle_ps(a, a, 0xFF), b3, sum);
+				_mm_store_ps(&result.row[r].x, sum);
+			}
+#endif
+			return result;
+		}
+
+		inline Mat4f Transpose(const Mat4f& m)
+		{
+			__m128 r0 = _mm_load_ps(&m.row[0].x);
+			__m128 r1 = _mm_load_ps(&m.row[1].x);
+			__m128 r2 = _mm_load_ps(&m.row[2].x);
+			__m128 r3 = _mm_load_ps(&m.row[3].x);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			Mat4f result;
+			_mm_store_ps(&result.row[0].x, r0);
+			_mm_store_ps(&result.row[1].x, r1);
+			_mm_store_ps(&result.row[2].x, r2);
+			_mm_store_ps(&result.row[3].x, r3);
+			return result;
+		}
+#endif
+	}
+
+	constexpr Vec<float, 4>::Vec(float scalar)
+	: x(scalar), y(scalar), z(scalar), w(scalar)
+	{
+	}
+	constexpr Vec<float, 4>::Vec(float x, float y, float z, float w)
+	: x(x), y(y), z(z), w(w)
+	{
+	}
+	constexpr Vec<float, 4>::Vec(float x, const Vec<float, 3>& yzw)
+	: x(x), y(yzw.x), z(yzw.y), w(yzw.z)
+	{
+	}
+	constexpr Vec<float, 4>::Vec(const Vec<float, 3>& xyz, float w)
+	: x(xyz.x), y(xyz.y), z(xyz.z), w(w)
+	{
+	}
+	constexpr Vec<float, 4>::Vec(float x, const Vec<float, 2>& yz, float w)
+	: x(x), y(yz.x), z(yz.y), w(w)
+	{
+	}
+	constexpr Vec<float, 4>::Vec(const Vec<float, 2>& xy, float z, float w)
+	: x(xy.x), y(xy.y), z(z), w(w)
+	{
+	}
+	constexpr Vec<float, 4>::Vec(float x, float y, const Vec<float, 2>& zw)
+	: x(x), y(y), z(zw.x), w(zw.y)
+	{
+	}
+	// Components are selected by name in constant evaluation, as pointer arithmetic over members isn't a constant expression
+	constexpr const float& Vec<float, 4>::operator[](size_t i) const
+	{
+		if (detail::IsConstantEvaluated())
+		{
+			return i == 0 ? x : i == 1 ? y : i == 2 ? z : w;
+		}
+		return *(reinterpret_cast<const float*>(this) + i);
+	}
+	constexpr float& Vec<float, 4>::operator[](size_t i)
+	{
+		if (detail::IsConstantEvaluated())
+		{
+			return i == 0 ? x : i == 1 ? y : i == 2 ? z : w;
+		}
+		return *(reinterpret_cast<float*>(this) + i);
+	}
+	constexpr Vec4f Vec<float, 4>::operator*(float scalar) const
+	{
+#ifdef SOL_SSE
+		if (!detail::IsConstantEvaluated())
+		{
+			return detail::Multiply(*this, scalar);
+		}
+#endif
+		return { this->x * scalar, this->y * scalar, this->z * scalar, this->w * scalar };
+	}
+	constexpr Vec4f Vec<float, 4>::operator+(const Vec4f& other) const
+	{
+#ifdef SOL_SSE
+		if (!detail::IsConstantEvaluated())
+		{
+			return detail::Add(*this, other);
+		}
+#endif
+		return { this->x + other.x, this->y + other.y, this->z + other.z, this->w + other.w };
+	}
+
+
+
+	constexpr Vec<float, 3>::Vec(float scalar)
+	: x(scalar), y(scalar), z(scalar)
+	{
+	}
+	constexpr Vec<float, 3>::Vec(float x, float y, float z)
+	: x(x), y(y), z(z)
+	{
+	}
+	constexpr Vec<float, 3>::Vec(const Vec<float, 2>& xy, float z)
+	: x(xy.x), y(xy.y), z(z)
+	{
+	}
+	constexpr Vec<float, 3>::Vec(float x, const Vec<float, 2>& yz)
+	: x(x), y(yz.x), z(yz.y)
+	{
+	}
+	constexpr Vec<float, 3>::Vec(const Vec4f& v)
+	: x(v.x), y(v.y), z(v.z)
+	{
+	}
+	constexpr const float& Vec<float, 3>::operator[](size_t i) const
+	{
+		if (detail::IsConstantEvaluated())
+		{
+			return i == 0 ? x : i == 1 ? y : z;
+		}
+		return *(reinterpret_cast<const float*>(this) + i);
+	}
+	constexpr Vec3f Vec<float, 3>::operator*(float scalar) const
+	{
+		return { this->x * scalar, this->y * scalar, this->z * scalar };
+	}
+	constexpr Vec3f Vec<float, 3>::operator+(const Vec3f& other) const
+	{
+		return { this->x + other.x, this->y + other.y, this->z + other.z };
+	}
+	constexpr Vec3f Vec<float, 3>::operator-(const Vec3f& other) const
+	{
+		return { this->x - other.x, this->y - other.y, this->z - other.z };
+	}
+	constexpr Vec3f Vec<float, 3>::operator-() const
+	{
+		return { -this->x, -this->y, -this->z };
+	}
+
+
+
+	constexpr Vec<float, 2>::Vec(float scalar)
+	: x(scalar), y(scalar)
+	{
+	}
+	constexpr Vec<float, 2>::Vec(float x, float y)
+	: x(x), y(y)
+	{
+	}
+	constexpr Vec<float, 2>::Vec(const Vec3f& v)
+	: x(v.x), y(v.y)
+	{
+	}
+	constexpr Vec<float, 2>::Vec(const Vec4f& v)
+	: x(v.x), y(v.y)
+	{
+	}
+	constexpr bool Vec<float, 2>::operator==(const Vec2f& other) const
+	{
+		return (this->x == other.x && this->y == other.y);
+	}
+	constexpr bool Vec<float, 2>::operator!=(const Vec2f& other) const
+	{
+		return !(*this == other);
+	}
+
+
+
+	constexpr Mat<Mat4f::T, 4, 4>::Mat(T scalar)
+	: row{
+		Vec4f(scalar, 0.0f, 0.0f, 0.0f),
+		Vec4f(0.0f, scalar, 0.0f, 0.0f),
+		Vec4f(0.0f, 0.0f, scalar, 0.0f),
+		Vec4f(0.0f, 0.0f, 0.0f, scalar) }
+	{
+	}
+	constexpr Mat<Mat4f::T, 4, 4>::Mat(
+		const Vec4f& v1,
+		const Vec4f& v2,
+		const Vec4f& v3,
+		const Vec4f& v4)
+	: row{ v1, v2, v3, v4 }
+	{
+	}
+	constexpr Vec4f Mat<Mat4f::T, 4, 4>::operator*(const Vec4f& v4) const
+	{
+#ifdef SOL_SSE
+		if (!detail::IsConstantEvaluated())
+		{
+			return detail::Multiply(*this, v4);
+		}
+#endif
+		return
+		{
+			(*this)[0][0] * v4.x + (*this)[0][1] * v4.y + (*this)[0][2] * v4.z + (*this)[0][3] * v4.w,
+			(*this)[1][0] * v4.x + (*this)[1][1] * v4.y + (*this)[1][2] * v4.z + (*this)[1][3] * v4.w,
+			(*this)[2][0] * v4.x + (*this)[2][1] * v4.y + (*this)[2][2] * v4.z + (*this)[2][3] * v4.w,
+			(*this)[3][0] * v4.x + (*this)[3][1] * v4.y + (*this)[3][2] * v4.z + (*this)[3][3] * v4.w
+		};
+	}
+	constexpr Mat4f Mat<Mat4f::T, 4, 4>::operator*(const Mat4f& m4) const
+	{
+#ifdef SOL_SSE
+		if (!detail::IsConstantEvaluated())
+		{
+			return detail::Multiply(*this, m4);
+		}
+#endif
+		Mat4f result(0.0f);
+		for (size_t r = 0; r < 4; r++)
+		{
+			for (size_t c = 0; c < 4; c++)
+			{
+				result[r][c] = (*this)[r][0] * m4[0][c]
+					+ (*this)[r][1] * m4[1][c]
+					+ (*this)[r][2] * m4[2][c]
+					+ (*this)[r][3] * m4[3][c];
+			}
+		}
+		return result;
+	}
+	constexpr const Mat4f::Row_Type& Mat<Mat4f::T, 4, 4>::operator[](size_t i) const { return this->row[i]; }
+	constexpr Mat4f::Row_Type& Mat<Mat4f::T, 4, 4>::operator[](size_t i) { return this->row[i]; }
+
+
+
+	constexpr Affine2f::Affine2f(float scalar)
+	: row{ Vec3f(scalar, 0.0f, 0.0f), Vec3f(0.0f, scalar, 0.0f) }
+	{
+	}
+	constexpr Affine2f::Affine2f(const Vec3f& r1, const Vec3f& r2)
+	: row{ r1, r2 }
+	{
+	}
+	constexpr Vec2f Affine2f::operator*(const Vec2f& point) const
+	{
+		return
+		{
+			row[0].x * point.x + row[0].y * point.y + row[0].z,
+			row[1].x * point.x + row[1].y * point.y + row[1].z
+		};
+	}
+	constexpr Affine2f Affine2f::operator*(const Affine2f& other) const
+	{
+		const Vec3f& r0 = other.row[0];
+		const Vec3f& r1 = other.row[1];
+		return
+		{
+			Vec3f(row[0].x * r0.x + row[0].y * r1.x, row[0].x * r0.y + row[0].y * r1.y, row[0].x * r0.z + row[0].y * r1.z + row[0].z),
+			Vec3f(row[1].x * r0.x + row[1].y * r1.x, row[1].x * r0.y + row[1].y * r1.y, row[1].x * r0.z + row[1].y * r1.z + row[1].z)
+		};
+	}
+	constexpr const Vec3f& Affine2f::operator[](size_t i) const { return this->row[i]; }
+	constexpr Vec3f& Affine2f::operator[](size_t i) { return this->row[i]; }
+
+	constexpr Affine2f Inverse(const Affine2f& m)
+	{
+		// inverse of the linear part is its adjugate divided by the determinant, the translation is moved back by it
+		float inverse = 1.0f / (m[0].x * m[1].y - m[0].y * m[1].x);
+		float a = m[1].y * inverse, b = -m[0].y * inverse;
+		float c = -m[1].x * inverse, d = m[0].x * inverse;
+		return
+		{
+			Vec3f(a, b, -(a * m[0].z + b * m[1].z)),
+			Vec3f(c, d, -(c * m[0].z + d * m[1].z))
+		};
+	}
+
+	constexpr Affine2f TRS(const Vec2f& translation, float angle, const Vec2f& scale)
+	{
+		float cos = detail::Cos(angle);
+		float sin = detail::Sin(angle);
+		return
+		{
+			Vec3f(cos * scale.x, -sin * scale.y, translation.x),
+			Vec3f(sin * scale.x, cos * scale.y, translation.y)
+		};
+	}
+
+
+
+	constexpr Vec3f Normalize(const Vec3f& v3)
+	{
+		float magnitude = detail::Sqrt(v3.x*v3.x + v3.y*v3.y + v3.z*v3.z);
+		return { v3.x / magnitude, v3.y / magnitude, v3.z / magnitude };
+	}
+
+	// https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/cross.xhtml
+	constexpr Vec3f Cross(const Vec3f& u, const Vec3f& v)
+	{
+		return
+		{
+			u[1] * v[2] - v[1] * u[2],
+			u[2] * v[0] - v[2] * u[0],
+			u[0] * v[1] - v[0] * u[1]
+		};
+	}
+
+	constexpr Mat4f Transpose(const Mat4f& m)
+	{
+#ifdef SOL_SSE
+		if (!detail::IsConstantEvaluated())
+		{
+			return detail::Transpose(m);
+		}
+#endif
+		return
+		{
+			Vec4f(m[0][0], m[1][0], m[2][0], m[3][0]),
+			Vec4f(m[0][1], m[1][1], m[2][1], m[3][1]),
+			Vec4f(m[0][2], m[1][2], m[2][2], m[3][2]),
+			Vec4f(m[0][3], m[1][3], m[2][3], m[3][3])
+		};
+	}
+
+	constexpr Mat4f Translate(const Mat4f& m, const Vec3f& v)
+	{
+		Mat4f result(m);
+		result[3] = m[0]*v[0] + m[1]*v[1] + m[2]*v[2] + m[3];
+		return Transpose(result);
+	}
+
+	// https://en.wikipedia.org/wiki/Rotation_matrix
+	constexpr Mat4f RotateX(float t)
+	{
+		return
+		{
+			Vec4f(1.0f, 0.0f, 0.0f, 0.0f),
+			Vec4f(0.0f, detail::Cos(t), detail::Sin(t), 0.0f),
+			Vec4f(0.0f, -detail::Sin(t), detail::Cos(t), 0.0f),
+			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
+		};
+	}
+	constexpr Mat4f RotateY(float t)
+	{
+		return
+		{
+			Vec4f(detail::Cos(t), 0.0f, -detail::Sin(t), 0.0f),
+			Vec4f(0.0f, 1.0f, 0.0f, 0.0f),
+			Vec4f(detail::Sin(t), 0.0f, detail::Cos(t), 0.0f),
+			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
+		};
+	}
+	constexpr Mat4f RotateZ(float t)
+	{
+		return
+		{
+			Vec4f(detail::Cos(t), -detail::Sin(t), 0.0f, 0.0f),
+			Vec4f(detail::Sin(t), detail::Cos(t), 0.0f, 0.0f),
+			Vec4f(0.0f, 0.0f, 1.0f, 0.0f),
+			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
+		};
+	}
+
+	constexpr Mat4f Scale(float scalar)
+	{
+		return
+		{
+			Vec4f(scalar, 0.0f, 0.0f, 0.0f),
+			Vec4f(0.0f, scalar, 0.0f, 0.0f),
+			Vec4f(0.0f, 0.0f, scalar, 0.0f),
+			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
+		};
+	}
+
+	constexpr Mat4f Scale(const sol::Vec3f& scalar)
+	{
+		return
+		{
+			Vec4f(scalar.x, 0.0f, 0.0f, 0.0f),
+			Vec4f(0.0f, scalar.y, 0.0f, 0.0f),
+			Vec4f(0.0f, 0.0f, scalar.z, 0.0f),
+			Vec4f(0.0f, 0.0f, 0.0f, 1.0f)
+		};
+	}
+
+	// https://www.scratchapixel.com/lessons/3d-basic-rendering/perspective-and-orthographic-projection-matrix/building-basic-perspective-projection-matrix
+	// https://www.scratchapixel.com/lessons/3d-basic-rendering/perspective-and-orthographic-projection-matrix/opengl-perspective-projection-matrix
+	constexpr Mat4f Perspective(float fov, float aspectRatio, float zNear, float zFar)
+	{
+		float top = detail::Tan(fov / 2.0f) * zNear;
+		float bottom = -top;
+		float right = top * aspectRatio;
+		float left = -right;
+
+		Mat4f result(0.0f);
+
+		result[0][0] = (2 * zNear) / (right - left);
+		result[1][1] = (2 * zNear) / (top - bottom);
+		result[2][0] = (right + left) / (right - left);
+		result[2][1] = (top + bottom) / (top - bottom);
+		result[2][2] = - (zFar + zNear) / (zFar - zNear);
+		result[2][3] = -1.0f;
+		result[3][2] = - (2 * zFar * zNear) / (zFar - zNear);
+
+		return result;
+	}
+
+	// https://www.scratchapixel.com/lessons/mathematics-physics-for-computer-graphics/lookat-function
+	// https://www.geertarien.com/blog/2017/07/30/breakdown-of-the-lookAt-function-in-OpenGL/
+	constexpr Mat4f LookAt(const Vec3f& from, const Vec3f& to, const Vec3f& up)
+	{
+		Vec3f f = Normalize(to - from);
+		Vec3f r = Normalize(Cross(f, up));
+		Vec3f u = Cross(r, f);
+
+		return
+		{
+			Vec4f(r, 0.0f),
+			Vec4f(u, 0.0f),
+			Vec4f(f, 0.0f),
+			Vec4f(-from, 1.0f)
+		};
+	}
+}
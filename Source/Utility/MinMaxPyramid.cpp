@@ -0,0 +1,157 @@
+#include <Utility/MinMaxPyramid.h>
+#include <Utility/Parallel.h>
+
+#include <stdexcept>
+#include <algorithm>
+
+// Ties are resolved by index, so that the result doesn't depend on the order blocks are combined in
+static bool Less(const Vertex* vertices, size_t a, size_t b)
+{
+	float ya = vertices[a].position.y, yb = vertices[b].position.y;
+	return ya < yb || (ya == yb && a < b);
+}
+
+static bool Greater(const Vertex* vertices, size_t a, size_t b)
+{
+	float ya = vertices[a].position.y, yb = vertices[b].position.y;
+	return ya > yb || (ya == yb && a < b);
+}
+
+void MinMaxPyramid::Build(const Vertex* vertices, size_t count)
+{
+	if (count > UINT32_MAX)
+	{
+		throw std::length_error("MinMaxPyramid supports at most 2^32 points");
+	}
+	m_Levels.clear();
+	size_t blocks = count / s_BlockPoints;
+	if (blocks == 0)
+	{
+		return;
+	}
+
+	// Level 0 scans all points, so it is built in parallel. Other levels are 64 times smaller in total
+	m_Levels.emplace_back(blocks);
+	std::vector<Block>& base = m_Levels.back();
+	Parallel::For(blocks, 4096, [&](size_t begin, size_t end)
+	{
+		for (size_t block = begin; block < end; block++)
+		{
+			size_t first = block * s_BlockPoints;
+			size_t min = first, max = first;
+			for (size_t i = first + 1; i < first + s_BlockPoints; i++)
+			{
+				if (vertices[i].position.y < vertices[min].position.y) min = i;
+				if (vertices[i].position.y > vertices[max].position.y) max = i;
+			}
+			base[block] = { static_cast<uint32_t>(min), static_cast<uint32_t>(max) };
+		}
+	});
+
+	while (m_Levels.back().size() > 1)
+	{
+		const std::vector<Block>& previous = m_Levels.back();
+		std::vector<Block> level(previous.size() / 2);
+		for (size_t block = 0; block < level.size(); block++)
+		{
+			const Block& left = previous[2 * block];
+			const Block& right = previous[2 * block + 1];
+			level[block].min = Less(vertices, right.min, left.min) ? right.min : left.min;
+			level[block].max = Greater(vertices, right.max, left.max) ? right.max : left.max;
+		}
+		m_Levels.push_back(std::move(level));
+	}
+}
+
+MinMaxPyramid::Extrema MinMaxPyramid::Query(const Vertex* vertices, size_t begin, size_t end) const
+{
+	Extrema result = { begin, begin };
+	auto take = [&](size_t min, size_t max)
+	{
+		if (Less(vertices, min, result.min)) result.min = min;
+		if (Greater(vertices, max, result.max)) result.max = max;
+	};
+
+	size_t blockBegin = (begin + s_BlockPoints - 1) / s_BlockPoints;
+	size_t blockEnd = end / s_BlockPoints;
+	if (m_Levels.empty() || blockBegin >= blockEnd)
+	{
+		for (size_t i = begin + 1; i < end; i++)
+		{
+			take(i, i);
+		}
+		return result;
+	}
+
+	// partial blocks at the ends of the range
+	for (size_t i = begin + 1; i < blockBegin * s_BlockPoints; i++)
+	{
+		take(i, i);
+	}
+	for (size_t i = blockEnd * s_BlockPoints; i < end; i++)
+	{
+		take(i, i);
+	}
+
+	// whole blocks, [blockBegin; blockEnd) is narrowed level by level as a segment tree range
+	for (size_t level = 0; blockBegin < blockEnd && level < m_Levels.size(); level++)
+	{
+		const std::vector<Block>& blocks = m_Levels[level];
+		// blocks, that have no pair on this level, are taken as they are.
+		// This also covers the last block of an odd-sized level, which has no parent
+		if (blockBegin & 1)
+		{
+			take(blocks[blockBegin].min, blocks[blockBegin].max);
+			blockBegin++;
+		}
+		if ((blockEnd & 1) && blockBegin < blockEnd)
+		{
+			blockEnd--;
+			take(blocks[blockEnd].min, blocks[blockEnd].max);
+		}
+		blockBegin /= 2;
+		blockEnd /= 2;
+	}
+	return result;
+}
+
+void MinMaxPyramid::Aggregate(const Vertex* vertices, size_t begin, size_t end, float xMin, float xMax, size_t columns, std::vector<Vertex>& output) const
+{
+	const float columnWidth = (xMax - xMin) / columns;
+	auto compareX = [](const Vertex& vertex, float x) { return vertex.position.x < x; };
+	size_t columnBegin = begin;
+	for (size_t column = 0; column < columns && columnBegin < end; column++)
+	{
+		size_t columnEnd = end;
+		if (column + 1 < columns)
+		{
+			float boundary = xMin + (column + 1) * columnWidth;
+			columnEnd = std::lower_bound(vertices + columnBegin, vertices + end, boundary, compareX) - vertices;
+		}
+		if (columnEnd == columnBegin)
+		{
+			continue;
+		}
+
+		Extrema extrema = this->Query(vertices, columnBegin, columnEnd);
+		size_t indices[4] = { columnBegin, std::min(extrema.min, extrema.max), std::max(extrema.min, extrema.max), columnEnd - 1 };
+		for (size_t i = 0; i < 4; i++)
+		{
+			if (i == 0 || indices[i] != indices[i - 1])
+			{
+				output.push_back(vertices[indices[i]]);
+			}
+		}
+		columnBegin = columnEnd;
+	}
+}
+
+size_t MinMaxPyramid::Bytes() const
+{
+	size_t bytes = 0;
+	for (const std::vector<Block>& level : m_Levels)
+	{
+		bytes += level.size() * sizeof(Block);
+	}
+	return bytes;
+}
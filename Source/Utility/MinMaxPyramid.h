@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <Utility/Vertex.h>
+
+/**
+ * 	MinMaxPyramid answers "which points have the minimum and the maximum y in range [begin; end)" in O(log n)
+ *
+ * 	Points are split into blocks of s_BlockPoints points. Level 0 stores indices of the minimum and the maximum
+ * 	of each block, each next level stores them for pairs of blocks of the previous level.
+ * 	A query scans at most two partial blocks at the ends of the range and combines O(log n) whole blocks in between,
+ * 	the same way as a segment tree does. Memory is about 16 / s_BlockPoints bytes per point.
+ *
+ * 	Pyramid doesn't own the points, the same array must be passed to Build() and Query().
+ * 	It is used for M4 aggregation of x-sorted polylines with Aggregate(), @see @ref <Core/SampledSeries.h>
+ */
+class MinMaxPyramid
+{
+public:
+	struct Extrema
+	{
+		size_t min;
+		size_t max;
+	};
+
+	static constexpr size_t s_BlockPoints = 64;
+public:
+	MinMaxPyramid() = default;
+
+	// Builds all levels in parallel. Throws std::length_error if there are more than 2^32 points
+	void Build(const Vertex* vertices, size_t count);
+	// Returns indices of the minimum and the maximum y in non-empty range [begin; end). Ties resolve to the first point
+	Extrema Query(const Vertex* vertices, size_t begin, size_t end) const;
+	// M4 aggregation of x-sorted points [begin; end): x-range [xMin; xMax] is split into columns of equal width,
+	// and the first, the minimum, the maximum and the last points of each column are appended to output in their original order
+	void Aggregate(const Vertex* vertices, size_t begin, size_t end, float xMin, float xMax, size_t columns, std::vector<Vertex>& output) const;
+
+	inline size_t Levels() const { return m_Levels.size(); }
+	size_t Bytes() const;
+private:
+	struct Block
+	{
+		uint32_t min;
+		uint32_t max;
+	};
+private:
+	std::vector<std::vector<Block>> m_Levels;
+};
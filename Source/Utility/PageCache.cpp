@@ -0,0 +1,175 @@
+#include <Utility/PageCache.h>
+
+#include <chrono>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+
+template<typename T>
+static void ExtendY(const void* data, size_t count, double& min, double& max)
+{
+	const T* values = static_cast<const T*>(data);
+	for (size_t i = 0; i < count; i++)
+	{
+		// comparisons are false for NaN, so non-finite values don't spoil the bounds
+		double value = values[i];
+		if (value < min) min = value;
+		if (value > max) max = value;
+	}
+}
+
+PageCache::PageCache(std::shared_ptr<const ColumnFile> file, size_t budget)
+: m_File(std::move(file)), m_Budget(budget)
+{
+	m_IsWanted.assign(m_File->Chunks(), false);
+	m_Loader = std::thread(&PageCache::LoaderLoop, this);
+}
+
+PageCache::~PageCache()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_IsStopped = true;
+	}
+	m_Condition.notify_all();
+	m_Loader.join();
+}
+
+void PageCache::Request(const std::vector<size_t>& chunks)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (chunks == m_Wanted)
+		{
+			return;
+		}
+		for (size_t chunk : m_Wanted)
+		{
+			m_IsWanted[chunk] = false;
+		}
+		m_Wanted = chunks;
+		for (size_t chunk : m_Wanted)
+		{
+			m_IsWanted[chunk] = true;
+		}
+		m_Next = 0;
+	}
+	m_Condition.notify_one();
+}
+
+std::shared_ptr<const PageCache::Page> PageCache::Find(size_t chunk)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	auto it = m_Pages.find(chunk);
+	if (it == m_Pages.end())
+	{
+		return nullptr;
+	}
+	m_Recent.splice(m_Recent.begin(), m_Recent, it->second.position);
+	return it->second.page;
+}
+
+PageCache::Stats PageCache::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Stats;
+}
+
+void PageCache::LoaderLoop()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (!m_IsStopped)
+	{
+		// skip wanted chunks, that are already in memory
+		while (m_Next < m_Wanted.size() && m_Pages.count(m_Wanted[m_Next]))
+		{
+			m_Next++;
+		}
+		if (m_Next == m_Wanted.size())
+		{
+			m_Condition.wait(lock);
+			continue;
+		}
+
+		size_t chunk = m_Wanted[m_Next];
+		lock.unlock();
+		std::shared_ptr<Page> page;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		try
+		{
+			page = this->Load(chunk);
+		}
+		catch (const std::runtime_error& error)
+		{
+			std::cout << error.what() << std::endl;
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		lock.lock();
+
+		if (!page)
+		{
+			// the chunk is skipped until the wanted set changes, so a broken file doesn't spin the loader
+			m_Next++;
+			continue;
+		}
+		size_t bytes = page->x.size() + page->y.size();
+		m_Stats.loads++;
+		m_Stats.loadedBytes += bytes;
+		m_Stats.loadSeconds += seconds;
+		// the wanted set might have changed while reading, the page is kept anyway if there is room for it
+		if (!this->MakeRoom(bytes))
+		{
+			// everything in memory is wanted, so nothing more can be loaded until the wanted set changes
+			m_Next = m_Wanted.size();
+			continue;
+		}
+		m_Recent.push_front(chunk);
+		m_Pages[chunk] = { std::move(page), m_Recent.begin() };
+		m_Stats.pages++;
+		m_Stats.bytes += bytes;
+	}
+}
+
+std::shared_ptr<PageCache::Page> PageCache::Load(size_t chunk) const
+{
+	const ColumnFile& file = *m_File;
+	std::shared_ptr<Page> page = std::make_shared<Page>();
+	page->chunk = chunk;
+	page->points = file.ChunkSize(chunk) + (chunk + 1 < file.Chunks());
+	page->x.resize(page->points * ColumnFile::TypeSize(file.XType()));
+	page->y.resize(page->points * ColumnFile::TypeSize(file.YType()));
+	file.Read(file.ChunkBegin(chunk), page->points, page->x.data(), page->y.data());
+
+	page->yMin = std::numeric_limits<double>::infinity();
+	page->yMax = -std::numeric_limits<double>::infinity();
+	if (file.YType() == ColumnFile::Type::Float64)
+	{
+		ExtendY<double>(page->y.data(), page->points, page->yMin, page->yMax);
+	}
+	else
+	{
+		ExtendY<float>(page->y.data(), page->points, page->yMin, page->yMax);
+	}
+	return page;
+}
+
+bool PageCache::MakeRoom(size_t bytes)
+{
+	// walks from the least recently used page, skipping wanted ones
+	auto it = m_Recent.end();
+	while (m_Stats.bytes + bytes > m_Budget && it != m_Recent.begin())
+	{
+		--it;
+		if (m_IsWanted[*it])
+		{
+			continue;
+		}
+		auto page = m_Pages.find(*it);
+		m_Stats.bytes -= page->second.page->x.size() + page->second.page->y.size();
+		m_Stats.pages--;
+		m_Stats.evictions++;
+		m_Pages.erase(page);
+		it = m_Recent.erase(it);
+	}
+	return m_Stats.bytes + bytes <= m_Budget;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <unordered_map>
+#include <condition_variable>
+#include <Utility/ColumnFile.h>
+
+/**
+ * 	PageCache keeps recently used chunks of a ColumnFile in memory and loads new ones on its own thread
+ *
+ * 	A page is a chunk of the file plus the first point of the next chunk, so that line strips stay continuous
+ * 	across pages. Columns are kept in the file's types, so pages may be uploaded to GPU as they are.
+ *
+ * 	The owner tells the cache which pages it wants with Request(), in the order of priority. The loader thread
+ * 	reads wanted pages, that are not in memory yet, with ColumnFile::Read(), one page at a time.
+ * 	Find() never waits for I/O: it returns a page only if it is already loaded, and marks it as recently used.
+ * 	The mutex is held only to look up and insert pages, never while reading.
+ *
+ * 	Memory is bounded by the budget. Least recently used pages, that are not wanted, are evicted to make room for a new one.
+ * 	If all pages in memory are wanted, loading stops until the wanted set changes, so the cache never thrashes.
+ * 	Pages are shared pointers, so a page may be evicted while the owner still uploads it
+ */
+class PageCache
+{
+public:
+	struct Page
+	{
+		size_t chunk;
+		size_t points;
+		std::vector<unsigned char> x;
+		std::vector<unsigned char> y;
+		// y-bounds of the page, read while loading. Used by files without stored y-bounds
+		double yMin, yMax;
+	};
+
+	struct Stats
+	{
+		size_t pages = 0;
+		size_t bytes = 0;
+		size_t loads = 0;
+		size_t evictions = 0;
+		size_t loadedBytes = 0;
+		// total time, the loader thread spent reading pages
+		double loadSeconds = 0.0;
+	};
+public:
+	PageCache(std::shared_ptr<const ColumnFile> file, size_t budget = 256 * 1024 * 1024);
+	PageCache(const PageCache&) = delete;
+	PageCache& operator=(const PageCache&) = delete;
+	// Stops and joins the loader thread
+	~PageCache();
+
+	// Replaces the set of wanted chunks, that must be valid chunk indices. Chunks at the front are loaded first
+	void Request(const std::vector<size_t>& chunks);
+	// Returns the page of the chunk if it is in memory, otherwise nullptr. Never blocks on I/O
+	std::shared_ptr<const Page> Find(size_t chunk);
+
+	Stats GetStats() const;
+	inline const ColumnFile& File() const { return *m_File; }
+	inline size_t Budget() const { return m_Budget; }
+private:
+	void LoaderLoop();
+	// reads the page on the loader thread
+	std::shared_ptr<Page> Load(size_t chunk) const;
+	// evicts least recently used pages, that are not wanted, until the bytes fit. Returns false if they can't fit
+	bool MakeRoom(size_t bytes);
+private:
+	std::shared_ptr<const ColumnFile> m_File;
+	size_t m_Budget;
+
+	struct Entry
+	{
+		std::shared_ptr<const Page> page;
+		std::list<size_t>::iterator position;
+	};
+	mutable std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::unordered_map<size_t, Entry> m_Pages;
+	// chunks from the most to the least recently used
+	std::list<size_t> m_Recent;
+	std::vector<size_t> m_Wanted;
+	// flag per chunk, whether it is in m_Wanted
+	std::vector<bool> m_IsWanted;
+	// index of the next wanted chunk, the loader checks
+	size_t m_Next = 0;
+	Stats m_Stats;
+
+	std::atomic<bool> m_IsStopped = false;
+	std::thread m_Loader;
+};
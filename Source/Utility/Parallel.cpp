@@ -0,0 +1,53 @@
+#include <Utility/Parallel.h>
+#include <Utility/Profiler.h>
+
+#include <thread>
+#include <vector>
+
+namespace Parallel
+{
+	size_t Concurrency()
+	{
+		static const size_t concurrency = std::max<size_t>(1, std::thread::hardware_concurrency());
+		return concurrency;
+	}
+
+	void For(size_t count, size_t grain, const std::function<void(size_t, size_t)>& task)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		grain = std::max<size_t>(1, grain);
+		size_t chunks = std::min(Concurrency(), (count + grain - 1) / grain);
+		if (chunks <= 1)
+		{
+			task(0, count);
+			return;
+		}
+
+		size_t chunkSize = (count + chunks - 1) / chunks;
+		std::vector<std::thread> workers;
+		workers.reserve(chunks - 1);
+		// the first chunk is left for the calling thread
+		for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+		{
+			workers.emplace_back([&task](size_t begin, size_t end)
+			{
+				PROFILE_THREAD("Parallel worker");
+				PROFILE_ZONE("Parallel::For chunk");
+				task(begin, end);
+			}, begin, std::min(count, begin + chunkSize));
+		}
+		{
+			PROFILE_ZONE("Parallel::For chunk");
+			task(0, std::min(count, chunkSize));
+		}
+
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+}
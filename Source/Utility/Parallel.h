@@ -0,0 +1,18 @@
+#pragma once
+
+#include <functional>
+
+/**
+ * 	Namespace, that contains simple fork-join helpers for data-parallel loops
+ *
+ * 	For() splits the range [0; count) into contiguous chunks and runs the task for each chunk
+ * 	on a separate thread. The calling thread also processes a chunk and returns only when all chunks are done.
+ * 	Ranges, that are smaller than grain, are processed on the calling thread without spawning any threads
+ */
+namespace Parallel
+{
+	// Returns the amount of threads, that For() will use at most
+	size_t Concurrency();
+	// Task is called as task(begin, end) for each chunk. Chunks never overlap
+	void For(size_t count, size_t grain, const std::function<void(size_t, size_t)>& task);
+}
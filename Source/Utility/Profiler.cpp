@@ -0,0 +1,156 @@
+#include <Utility/Profiler.h>
+
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace Profiler
+{
+	// Guards the lists of buffers and names of threads, it is never taken while zones are written
+	static std::mutex s_Mutex;
+	static std::vector<std::unique_ptr<detail::Buffer>> s_Buffers;
+	static std::vector<detail::Buffer*> s_Free;
+
+	static const uint64_t s_OriginTicks = Now();
+	static const std::chrono::steady_clock::time_point s_OriginTime = std::chrono::steady_clock::now();
+
+	// Returns the buffer of the thread to the free list, once the thread exits
+	struct Release
+	{
+		~Release()
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_Free.push_back(detail::t_Buffer);
+			detail::t_Buffer = nullptr;
+		}
+	};
+
+	detail::Buffer* detail::Acquire()
+	{
+		// constructed by the first zone of each thread, so that its destructor runs on exit of the thread
+		static thread_local Release release;
+
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (!s_Free.empty())
+		{
+			// events of the previous thread are kept until they are overwritten, so threads, that reuse a buffer, share a track
+			Buffer* buffer = s_Free.back();
+			s_Free.pop_back();
+			return buffer;
+		}
+		s_Buffers.push_back(std::make_unique<Buffer>());
+		Buffer* buffer = s_Buffers.back().get();
+		buffer->id = static_cast<uint32_t>(s_Buffers.size() - 1);
+		buffer->name = "Thread " + std::to_string(buffer->id);
+		return buffer;
+	}
+
+	// Ticks of the clock per microsecond, they are measured since the start of the program, which makes the rate more precise with time
+	static double TicksPerMicrosecond()
+	{
+		uint64_t ticks = Now();
+		double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s_OriginTime).count();
+		return ticks > s_OriginTicks && elapsed > 0.0 ? (ticks - s_OriginTicks) / elapsed : 1.0;
+	}
+
+	static double ToMicroseconds(uint64_t ticks, double rate)
+	{
+		return static_cast<int64_t>(ticks - s_OriginTicks) / rate;
+	}
+
+	// Copies the ring of the buffer. Events, that the writer may have overwritten during the copy, are dropped
+	static std::vector<Event> Copy(const detail::Buffer& buffer)
+	{
+		uint64_t write = buffer.write.load(std::memory_order_acquire);
+		uint64_t first = write > s_Capacity ? write - s_Capacity : 0;
+		std::vector<Event> events;
+		events.reserve(write - first);
+		for (uint64_t i = first; i < write; i++)
+		{
+			events.push_back(buffer.events[i & (s_Capacity - 1)]);
+		}
+
+		// The writer stores event w before it publishes w + 1, so once write is w, event w may be being written,
+		// i.e. its slot, that held event w - s_Capacity, is torn. The fence keeps the copies above before the load
+		std::atomic_thread_fence(std::memory_order_acquire);
+		uint64_t overwritten = buffer.write.load(std::memory_order_relaxed) + 1;
+		overwritten = overwritten > s_Capacity ? overwritten - s_Capacity : 0;
+		if (overwritten > first)
+		{
+			events.erase(events.begin(), events.begin() + std::min(overwritten - first, write - first));
+		}
+		return events;
+	}
+
+	void SetThreadName(const std::string& name)
+	{
+		if (!detail::t_Buffer)
+		{
+			detail::t_Buffer = detail::Acquire();
+		}
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		detail::t_Buffer->name = name;
+	}
+
+	double Microseconds(uint64_t ticks)
+	{
+		return ToMicroseconds(ticks, TicksPerMicrosecond());
+	}
+
+	std::vector<ThreadEvents> Collect()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		std::vector<ThreadEvents> threads;
+		threads.reserve(s_Buffers.size());
+		for (const std::unique_ptr<detail::Buffer>& buffer : s_Buffers)
+		{
+			threads.push_back({ buffer->name, buffer->id, Copy(*buffer) });
+		}
+		return threads;
+	}
+
+	std::vector<Event> CollectThread()
+	{
+		return detail::t_Buffer ? Copy(*detail::t_Buffer) : std::vector<Event>();
+	}
+
+	void WriteChromeTrace(const std::string& path)
+	{
+		std::vector<ThreadEvents> threads = Collect();
+		const double rate = TicksPerMicrosecond();
+
+		std::ofstream file(path);
+		file << std::setprecision(3) << std::fixed;
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool first = true;
+		for (const ThreadEvents& thread : threads)
+		{
+			// names of zones are literals of the program, thread names are escaped, as they may come from anywhere
+			std::string name;
+			for (char c : thread.name)
+			{
+				if (c == '"' || c == '\\')
+				{
+					name.push_back('\\');
+				}
+				name.push_back(c);
+			}
+			file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.id
+				<< ",\"args\":{\"name\":\"" << name << "\"}}";
+			first = false;
+			for (const Event& event : thread.events)
+			{
+				file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.id
+					<< ",\"ts\":" << ToMicroseconds(event.begin, rate) << ",\"dur\":" << (event.end - event.begin) / rate << "}";
+			}
+		}
+		file << "\n]}\n";
+		if (!file)
+		{
+			throw std::runtime_error("Failed to write Chrome trace " + path);
+		}
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * 	Namespace, that contains a CPU profiler of scoped zones
+ *
+ * 	Zones are measured with PROFILE_ZONE("Name") macro, i.e. from the macro to the end of the scope. Names must be string literals,
+ * 	as only pointers are stored. Macros compile to nothing, unless CARTESIAN_PLOTTER_PROFILER is defined (CMake option of the same name).
+ *
+ * 	Each thread writes finished zones to a buffer of its own, that is a ring of s_Capacity events, so the oldest events are overwritten.
+ * 	Writing is a store and a release of the write position, no locks are taken, and nothing is allocated.
+ * 	Readers copy events out of the rings and drop those, that may have been overwritten while they were copied.
+ * 	Buffers are taken from a list, guarded by a mutex, once a thread opens its first zone, and returned when the thread exits,
+ * 	so short-lived threads, e.g. of Parallel::For(), reuse buffers instead of allocating new ones.
+ *
+ * 	Time is read from the time stamp counter on x86-64 and converted to microseconds at read time, otherwise steady_clock is used.
+ * 	Time stamp counter is assumed to be invariant, as it is on CPUs of the last decade.
+ * 	Events may be exported as Chrome trace JSON with WriteChromeTrace(), that is opened with chrome://tracing or Perfetto
+ */
+namespace Profiler
+{
+	struct Event
+	{
+		const char* name;
+		uint64_t begin;
+		uint64_t end;
+		// amount of zones of the thread, that enclose this one
+		uint32_t depth;
+	};
+
+	struct ThreadEvents
+	{
+		std::string name;
+		uint32_t id;
+		std::vector<Event> events;
+	};
+
+	static constexpr size_t s_Capacity = 1 << 15;
+
+	namespace detail
+	{
+		struct Buffer
+		{
+			Event events[s_Capacity];
+			std::atomic<uint64_t> write = 0;
+			std::string name;
+			uint32_t id = 0;
+		};
+
+		// trivially initialized, so that access doesn't go through a TLS wrapper
+		inline thread_local Buffer* t_Buffer = nullptr;
+		inline thread_local uint32_t t_Depth = 0;
+
+		// Takes a buffer for the calling thread
+		Buffer* Acquire();
+	}
+
+	// Ticks of the profiler's clock. Ticks are converted with Microseconds()
+	inline uint64_t Now()
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		return __rdtsc();
+#else
+		return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+	}
+
+	class Zone
+	{
+	public:
+		explicit Zone(const char* name)
+		: m_Name(name)
+		{
+			if (!detail::t_Buffer)
+			{
+				detail::t_Buffer = detail::Acquire();
+			}
+			detail::t_Depth++;
+			m_Begin = Now();
+		}
+
+		~Zone()
+		{
+			uint64_t end = Now();
+			detail::Buffer* buffer = detail::t_Buffer;
+			uint64_t write = buffer->write.load(std::memory_order_relaxed);
+			buffer->events[write & (s_Capacity - 1)] = Event{ m_Name, m_Begin, end, --detail::t_Depth };
+			buffer->write.store(write + 1, std::memory_order_release);
+		}
+
+		Zone(const Zone&) = delete;
+		Zone& operator=(const Zone&) = delete;
+	private:
+		const char* m_Name;
+		uint64_t m_Begin;
+	};
+
+	// Names the calling thread in traces. Threads are named "Thread <id>" by default
+	void SetThreadName(const std::string& name);
+	// Converts ticks of Now() to microseconds since the start of the program
+	double Microseconds(uint64_t ticks);
+
+	// Copies events of all threads, events of a thread are ordered by the ends of their zones
+	std::vector<ThreadEvents> Collect();
+	// Copies events of the calling thread
+	std::vector<Event> CollectThread();
+	// Writes events of all threads as Chrome trace JSON. Throws std::runtime_error if the file can't be written
+	void WriteChromeTrace(const std::string& path);
+}
+
+#ifdef CARTESIAN_PLOTTER_PROFILER
+	#define PROFILE_CONCAT_IMPL(a, b) a##b
+	#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+	#define PROFILE_ZONE(name) ::Profiler::Zone PROFILE_CONCAT(profileZone, __LINE__)(name)
+	#define PROFILE_THREAD(name) ::Profiler::SetThreadName(name)
+#else
+	#define PROFILE_ZONE(name)
+	#define PROFILE_THREAD(name)
+#endif
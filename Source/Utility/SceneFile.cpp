@@ -0,0 +1,243 @@
+#include <Utility/SceneFile.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <iostream>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static_assert(sizeof(SceneFile::Header) == 112, "SceneFile header layout must not change");
+static_assert(sizeof(SceneFile::ObjectRecord) == 104, "SceneFile object record layout must not change");
+static_assert(sizeof(SceneFile::MaterialRecord) == 24, "SceneFile material record layout must not change");
+static_assert(sizeof(Vertex) == 24 && std::is_trivially_copyable<Vertex>::value, "Vertices are stored in the file as they are in memory");
+
+static uint64_t AlignUp(uint64_t value)
+{
+	return (value + SceneFile::s_Alignment - 1) / SceneFile::s_Alignment * SceneFile::s_Alignment;
+}
+
+SceneFile::SceneFile(const std::string& path)
+: m_Path(path)
+{
+	m_Descriptor = ::open(path.c_str(), O_RDONLY);
+	if (m_Descriptor < 0)
+	{
+		throw std::runtime_error("Failed to open scene file " + path + ": " + std::strerror(errno));
+	}
+
+	struct stat status;
+	if (::fstat(m_Descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Header))
+	{
+		::close(m_Descriptor);
+		throw std::runtime_error("Scene file " + path + " is too small");
+	}
+	m_Size = status.st_size;
+
+	void* data = ::mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, m_Descriptor, 0);
+	if (data == MAP_FAILED)
+	{
+		::close(m_Descriptor);
+		throw std::runtime_error("Failed to map scene file " + path + ": " + std::strerror(errno));
+	}
+	// the whole file is read front to back on load, so the OS may read ahead aggressively
+	::madvise(data, m_Size, MADV_SEQUENTIAL);
+	m_Data = static_cast<const unsigned char*>(data);
+	std::memcpy(&m_Header, m_Data, sizeof(Header));
+
+	// blocks are validated first, so that records can be read through the mapping
+	auto fits = [&](uint64_t offset, uint64_t count, uint64_t size)
+	{
+		return offset % s_Alignment == 0 && offset <= m_Size && count <= (m_Size - offset) / size;
+	};
+	const char* error = nullptr;
+	if (std::memcmp(m_Header.magic, s_Magic, sizeof(s_Magic)) != 0) error = "wrong magic";
+	else if (m_Header.version != s_Version) error = "unsupported version";
+	else if (!fits(m_Header.verticesOffset, m_Header.vertices, sizeof(Vertex))) error = "vertices are out of file";
+	else if (!fits(m_Header.objectsOffset, m_Header.objects, sizeof(ObjectRecord))) error = "objects are out of file";
+	else if (!fits(m_Header.materialsOffset, m_Header.materials, sizeof(MaterialRecord))) error = "materials are out of file";
+	else if (!fits(m_Header.stringsOffset, m_Header.stringsBytes, 1)) error = "strings are out of file";
+	if (!error)
+	{
+		m_Vertices = reinterpret_cast<const Vertex*>(m_Data + m_Header.verticesOffset);
+		m_Objects = reinterpret_cast<const ObjectRecord*>(m_Data + m_Header.objectsOffset);
+		m_Materials = reinterpret_cast<const MaterialRecord*>(m_Data + m_Header.materialsOffset);
+		m_Strings = reinterpret_cast<const char*>(m_Data + m_Header.stringsOffset);
+
+		auto validString = [&](uint64_t offset, uint64_t length) { return offset <= m_Header.stringsBytes && length <= m_Header.stringsBytes - offset; };
+		for (size_t i = 0; i < m_Header.materials && !error; i++)
+		{
+			const MaterialRecord& material = m_Materials[i];
+			if (!validString(material.nameOffset, material.nameLength) || !validString(material.shaderOffset, material.shaderLength))
+			{
+				error = "material name is out of strings";
+			}
+		}
+		for (size_t i = 0; i < m_Header.objects && !error; i++)
+		{
+			const ObjectRecord& object = m_Objects[i];
+			if (object.firstVertex > m_Header.vertices || object.vertexCount > m_Header.vertices - object.firstVertex)
+			{
+				error = "object vertices are out of the vertex block";
+			}
+			else if (object.material != s_NoMaterial && object.material >= m_Header.materials)
+			{
+				error = "object refers to a missing material";
+			}
+		}
+	}
+	if (error)
+	{
+		::munmap(data, m_Size);
+		::close(m_Descriptor);
+		throw std::runtime_error("Scene file " + path + " is malformed: " + error);
+	}
+}
+
+SceneFile::~SceneFile()
+{
+	::munmap(const_cast<unsigned char*>(m_Data), m_Size);
+	::close(m_Descriptor);
+}
+
+SceneWriter::SceneWriter(const std::string& path)
+: m_Path(path)
+{
+	std::memset(&m_Header, 0, sizeof(m_Header));
+	std::memcpy(m_Header.magic, SceneFile::s_Magic, sizeof(SceneFile::s_Magic));
+	m_Header.version = SceneFile::s_Version;
+	m_Header.verticesOffset = AlignUp(sizeof(SceneFile::Header));
+	m_Position = m_Header.verticesOffset;
+	m_Buffer.reserve(s_BufferVertices);
+
+	m_Descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (m_Descriptor < 0)
+	{
+		throw std::runtime_error("Failed to create scene file " + path + ": " + std::strerror(errno));
+	}
+}
+
+SceneWriter::~SceneWriter()
+{
+	if (m_Descriptor < 0)
+	{
+		return;
+	}
+	try
+	{
+		this->Close();
+	}
+	catch (const std::runtime_error& error)
+	{
+		std::cout << error.what() << std::endl;
+	}
+}
+
+uint32_t SceneWriter::AddMaterial(const std::string& name, const std::string& shader, uint32_t renderMode)
+{
+	SceneFile::MaterialRecord record = {};
+	record.nameOffset = static_cast<uint32_t>(m_Strings.size());
+	record.nameLength = static_cast<uint32_t>(name.size());
+	m_Strings += name;
+	record.shaderOffset = static_cast<uint32_t>(m_Strings.size());
+	record.shaderLength = static_cast<uint32_t>(shader.size());
+	m_Strings += shader;
+	record.renderMode = renderMode;
+	m_Materials.push_back(record);
+	return static_cast<uint32_t>(m_Materials.size() - 1);
+}
+
+void SceneWriter::AddObject(const SceneFile::ObjectRecord& record, const Vertex* vertices, size_t count)
+{
+	if (m_Descriptor < 0)
+	{
+		throw std::runtime_error("Object is added to a closed scene file " + m_Path);
+	}
+	m_Objects.push_back(record);
+	m_Objects.back().firstVertex = m_Header.vertices;
+	m_Objects.back().vertexCount = count;
+	m_Header.vertices += count;
+
+	// small objects are gathered in the buffer, large ones are written directly after it
+	if (m_Buffer.size() + count > s_BufferVertices)
+	{
+		this->Flush();
+	}
+	if (count >= s_BufferVertices)
+	{
+		this->Write(vertices, count * sizeof(Vertex), m_Position);
+		m_Position += count * sizeof(Vertex);
+		return;
+	}
+	m_Buffer.insert(m_Buffer.end(), vertices, vertices + count);
+}
+
+void SceneWriter::Close()
+{
+	if (m_Descriptor < 0)
+	{
+		return;
+	}
+	this->Flush();
+	m_Header.objects = m_Objects.size();
+	m_Header.materials = m_Materials.size();
+	m_Header.stringsBytes = m_Strings.size();
+	m_Header.objectsOffset = AlignUp(m_Position);
+	m_Header.materialsOffset = AlignUp(m_Header.objectsOffset + m_Objects.size() * sizeof(SceneFile::ObjectRecord));
+	m_Header.stringsOffset = AlignUp(m_Header.materialsOffset + m_Materials.size() * sizeof(SceneFile::MaterialRecord));
+
+	int descriptor = m_Descriptor;
+	try
+	{
+		this->Write(m_Objects.data(), m_Objects.size() * sizeof(SceneFile::ObjectRecord), m_Header.objectsOffset);
+		this->Write(m_Materials.data(), m_Materials.size() * sizeof(SceneFile::MaterialRecord), m_Header.materialsOffset);
+		this->Write(m_Strings.data(), m_Strings.size(), m_Header.stringsOffset);
+		// empty blocks at the end still have to be inside the file
+		if (::ftruncate(descriptor, m_Header.stringsOffset + m_Strings.size()) != 0)
+		{
+			throw std::runtime_error("Failed to resize scene file " + m_Path + ": " + std::strerror(errno));
+		}
+		// the header is written last, so an interrupted save never looks like a valid file
+		this->Write(&m_Header, sizeof(m_Header), 0);
+	}
+	catch (const std::runtime_error&)
+	{
+		m_Descriptor = -1;
+		::close(descriptor);
+		throw;
+	}
+	m_Descriptor = -1;
+	if (::close(descriptor) != 0)
+	{
+		throw std::runtime_error("Failed to close scene file " + m_Path + ": " + std::strerror(errno));
+	}
+}
+
+void SceneWriter::Flush()
+{
+	this->Write(m_Buffer.data(), m_Buffer.size() * sizeof(Vertex), m_Position);
+	m_Position += m_Buffer.size() * sizeof(Vertex);
+	m_Buffer.clear();
+}
+
+void SceneWriter::Write(const void* data, size_t bytes, uint64_t position)
+{
+	const unsigned char* remaining = static_cast<const unsigned char*>(data);
+	while (bytes > 0)
+	{
+		ssize_t written = ::pwrite(m_Descriptor, remaining, bytes, position);
+		if (written < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (written <= 0)
+		{
+			throw std::runtime_error("Failed to write scene file " + m_Path + ": " + std::strerror(errno));
+		}
+		remaining += written;
+		bytes -= written;
+		position += written;
+	}
+}
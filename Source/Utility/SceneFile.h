@@ -0,0 +1,157 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <Utility/Vertex.h>
+
+/**
+ * 	SceneFile is a read-only memory-mapped scene snapshot, i.e. objects with their vertices, transforms and flags
+ *
+ * 	The file consists of:
+ * 	-	a fixed-size Header;
+ * 	-	vertex block, i.e. vertices of all objects one after another, as they are stored in Vertex;
+ * 	-	object records, one fixed-size ObjectRecord per object, that refers to a range of the vertex block;
+ * 	-	material records, that refer to materials by name, and the names of materials and shaders they use.
+ * 	Blocks start at offsets, that are aligned to 64 bytes. All values are little-endian
+ *
+ * 	Records are plain data, so loading an object is a bulk copy of its vertices out of the mapping.
+ * 	Nothing is computed on load: UUIDs and bounds are stored, so neither UUID generation nor AABB scans happen.
+ * 	Opening a file validates every record, so malformed files never lead to reads out of the mapping.
+ *
+ * 	Files are written with SceneWriter below. Constructor throws std::runtime_error if the file can't be opened or is malformed
+ */
+class SceneFile
+{
+public:
+	enum ObjectFlags : uint32_t
+	{
+		ObjectFlags_None = 0,
+		ObjectFlags_Collider = 1 << 0,
+		ObjectFlags_Sealed = 1 << 1,
+		ObjectFlags_RenderAABB = 1 << 2,
+		ObjectFlags_SortedX = 1 << 3,
+		// the object had an AABB, aabbMin and aabbMax are valid
+		ObjectFlags_AABB = 1 << 4,
+	};
+
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t flags;
+		uint64_t materials;
+		uint64_t objects;
+		uint64_t vertices;
+		// offsets of blocks from the beginning of the file in bytes
+		uint64_t verticesOffset;
+		uint64_t objectsOffset;
+		uint64_t materialsOffset;
+		uint64_t stringsOffset;
+		uint64_t stringsBytes;
+		uint64_t reserved[4];
+	};
+
+	struct ObjectRecord
+	{
+		// range of the vertex block in vertices
+		uint64_t firstVertex;
+		uint64_t vertexCount;
+		float aabbMin[2];
+		float aabbMax[2];
+		float angle;
+		float scale[3];
+		float transform[3];
+		uint32_t flags;
+		// index of the material record or s_NoMaterial
+		uint32_t material;
+		char uuid[36];
+	};
+
+	struct MaterialRecord
+	{
+		// offsets and lengths in the strings block
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t shaderOffset;
+		uint32_t shaderLength;
+		uint32_t renderMode;
+		uint32_t reserved;
+	};
+
+	static constexpr char s_Magic[8] = { 'C', 'P', 'S', 'C', 'E', 'N', 'E', '\0' };
+	static constexpr uint32_t s_Version = 1;
+	static constexpr size_t s_Alignment = 64;
+	static constexpr uint32_t s_NoMaterial = UINT32_MAX;
+public:
+	explicit SceneFile(const std::string& path);
+	SceneFile(const SceneFile&) = delete;
+	SceneFile& operator=(const SceneFile&) = delete;
+	// Unmaps and closes the file
+	~SceneFile();
+
+	inline size_t Objects() const { return m_Header.objects; }
+	inline const ObjectRecord& GetObject(size_t i) const { return m_Objects[i]; }
+	inline const Vertex* ObjectVertices(const ObjectRecord& record) const { return m_Vertices + record.firstVertex; }
+
+	inline size_t Materials() const { return m_Header.materials; }
+	inline const MaterialRecord& GetMaterial(size_t i) const { return m_Materials[i]; }
+	inline std::string MaterialName(size_t i) const { return std::string(m_Strings + m_Materials[i].nameOffset, m_Materials[i].nameLength); }
+	inline std::string ShaderName(size_t i) const { return std::string(m_Strings + m_Materials[i].shaderOffset, m_Materials[i].shaderLength); }
+
+	// Getters
+	inline const std::string& Path() const { return m_Path; }
+	inline const Header& GetHeader() const { return m_Header; }
+	inline size_t Vertices() const { return m_Header.vertices; }
+	inline size_t Bytes() const { return m_Size; }
+private:
+	std::string m_Path;
+	int m_Descriptor = -1;
+	const unsigned char* m_Data = nullptr;
+	size_t m_Size = 0;
+
+	Header m_Header;
+	const Vertex* m_Vertices = nullptr;
+	const ObjectRecord* m_Objects = nullptr;
+	const MaterialRecord* m_Materials = nullptr;
+	const char* m_Strings = nullptr;
+};
+
+/**
+ * 	SceneWriter writes a SceneFile. Materials are added first, then objects are appended in any amount of calls.
+ * 	Vertices are written through a buffer as they come, records are kept in memory and written by Close()
+ *
+ * 	File is finalized by Close() or by the destructor. Methods throw std::runtime_error on I/O errors
+ */
+class SceneWriter
+{
+public:
+	explicit SceneWriter(const std::string& path);
+	SceneWriter(const SceneWriter&) = delete;
+	SceneWriter& operator=(const SceneWriter&) = delete;
+	~SceneWriter();
+
+	// Returns the index of the material record, that objects refer to
+	uint32_t AddMaterial(const std::string& name, const std::string& shader, uint32_t renderMode);
+	// Appends an object. Vertex range of the record is assigned by the writer
+	void AddObject(const SceneFile::ObjectRecord& record, const Vertex* vertices, size_t count);
+	// Writes records and the header
+	void Close();
+	// Size of the file, it is final after Close()
+	inline size_t Bytes() const { return m_Header.stringsOffset + m_Header.stringsBytes; }
+private:
+	void Flush();
+	void Write(const void* data, size_t bytes, uint64_t position);
+private:
+	std::string m_Path;
+	int m_Descriptor = -1;
+	SceneFile::Header m_Header;
+	uint64_t m_Position;
+	std::vector<SceneFile::ObjectRecord> m_Objects;
+	std::vector<SceneFile::MaterialRecord> m_Materials;
+	std::string m_Strings;
+	// vertices, that are not written yet
+	std::vector<Vertex> m_Buffer;
+
+	static constexpr size_t s_BufferVertices = 1 << 16;
+};
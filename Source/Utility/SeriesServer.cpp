@@ -0,0 +1,424 @@
+#include <Utility/SeriesServer.h>
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+
+static_assert(sizeof(SeriesServer::FrameHeader) == 16, "SeriesServer frame header layout must not change");
+static_assert(sizeof(sol::Vec2f) == 2 * sizeof(float) && sizeof(sol::Vec4f) == 4 * sizeof(float), "Payload is read straight into vectors");
+
+// a connection is read for at most this amount of bytes per wakeup, so a fast client can't starve others
+static constexpr size_t s_ReadBudget = 4 * 1024 * 1024;
+
+struct SeriesServer::Connection
+{
+	int socket;
+	bool reading = true;
+	FrameHeader header;
+	size_t headerBytes = 0;
+	size_t payloadBytes = 0;
+	// the message is decoded and waits to be handed over to the render thread
+	bool complete = false;
+	Message message;
+};
+
+static sockaddr_un SocketAddress(const std::string& path)
+{
+	sockaddr_un address = {};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path))
+	{
+		throw std::runtime_error("Socket path " + path + " is too long");
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+	return address;
+}
+
+SeriesServer::SeriesServer(const std::string& path, size_t queueCapacity, size_t pointBudget)
+: m_Path(path), m_PointBudget(pointBudget), m_Queue(queueCapacity)
+{
+	sockaddr_un address = SocketAddress(path);
+	// a socket file of a previous run is replaced, any other file is left alone and bind() fails
+	struct stat status;
+	if (::stat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+	{
+		::unlink(path.c_str());
+	}
+
+	m_Listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	m_Epoll = ::epoll_create1(EPOLL_CLOEXEC);
+	m_Wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	const char* error = nullptr;
+	if (m_Listener < 0 || m_Epoll < 0 || m_Wakeup < 0) error = "Failed to create socket";
+	else if (::bind(m_Listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) error = "Failed to bind socket";
+	else if (::listen(m_Listener, SOMAXCONN) != 0) error = "Failed to listen on socket";
+	if (!error)
+	{
+		epoll_event listener = {};
+		listener.events = EPOLLIN;
+		listener.data.fd = m_Listener;
+		epoll_event wakeup = {};
+		wakeup.events = EPOLLIN;
+		wakeup.data.fd = m_Wakeup;
+		if (::epoll_ctl(m_Epoll, EPOLL_CTL_ADD, m_Listener, &listener) != 0 || ::epoll_ctl(m_Epoll, EPOLL_CTL_ADD, m_Wakeup, &wakeup) != 0)
+		{
+			error = "Failed to register socket";
+		}
+	}
+	if (error)
+	{
+		std::string message = std::string(error) + " " + path + ": " + std::strerror(errno);
+		for (int descriptor : { m_Listener, m_Epoll, m_Wakeup })
+		{
+			if (descriptor >= 0)
+			{
+				::close(descriptor);
+			}
+		}
+		throw std::runtime_error(message);
+	}
+	m_Thread = std::thread(&SeriesServer::IOLoop, this);
+}
+
+SeriesServer::~SeriesServer()
+{
+	m_IsStopped.store(true, std::memory_order_relaxed);
+	uint64_t one = 1;
+	while (::write(m_Wakeup, &one, sizeof(one)) < 0 && errno == EINTR);
+	m_Thread.join();
+
+	for (auto& [socket, connection] : m_Connections)
+	{
+		::close(socket);
+	}
+	::close(m_Listener);
+	::close(m_Epoll);
+	::close(m_Wakeup);
+	::unlink(m_Path.c_str());
+}
+
+bool SeriesServer::Poll(Message& message)
+{
+	if (!m_Queue.TryPop(message))
+	{
+		return false;
+	}
+	m_QueuedPoints.fetch_sub(message.points.size(), std::memory_order_relaxed);
+	return true;
+}
+
+SeriesServer::Stats SeriesServer::GetStats() const
+{
+	Stats stats;
+	stats.connections = m_Accepted.load(std::memory_order_relaxed);
+	stats.messages = m_Messages.load(std::memory_order_relaxed);
+	stats.points = m_Points.load(std::memory_order_relaxed);
+	stats.bytes = m_Bytes.load(std::memory_order_relaxed);
+	stats.stalls = m_Stalls.load(std::memory_order_relaxed);
+	stats.errors = m_Errors.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void SeriesServer::IOLoop()
+{
+	epoll_event events[64];
+	while (!m_IsStopped.load(std::memory_order_relaxed))
+	{
+		// stalled connections are retried every millisecond, until the render thread makes room for their messages
+		bool stalled = false;
+		for (auto& [socket, connection] : m_Connections)
+		{
+			if (connection->reading)
+			{
+				continue;
+			}
+			if (this->HandOver(*connection))
+			{
+				this->SetReading(*connection, true);
+			}
+			else
+			{
+				stalled = true;
+			}
+		}
+
+		int count = ::epoll_wait(m_Epoll, events, 64, stalled ? 1 : -1);
+		if (count < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			std::cout << "SeriesServer::IOLoop() failed to wait for sockets: " << std::strerror(errno) << std::endl;
+			return;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			int socket = events[i].data.fd;
+			if (socket == m_Wakeup)
+			{
+				continue;
+			}
+			if (socket == m_Listener)
+			{
+				this->Accept();
+				continue;
+			}
+			auto connection = m_Connections.find(socket);
+			if (connection != m_Connections.end() && !this->Receive(*connection->second))
+			{
+				this->Close(socket);
+			}
+		}
+	}
+}
+
+void SeriesServer::Accept()
+{
+	for (;;)
+	{
+		int socket = ::accept4(m_Listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (socket < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+			{
+				continue;
+			}
+			return;
+		}
+		std::unique_ptr<Connection> connection = std::make_unique<Connection>();
+		connection->socket = socket;
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.fd = socket;
+		if (::epoll_ctl(m_Epoll, EPOLL_CTL_ADD, socket, &event) != 0)
+		{
+			::close(socket);
+			continue;
+		}
+		m_Connections[socket] = std::move(connection);
+		m_Accepted.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool SeriesServer::Receive(Connection& connection)
+{
+	size_t budget = s_ReadBudget;
+	while (budget > 0)
+	{
+		if (connection.complete && !this->HandOver(connection))
+		{
+			this->SetReading(connection, false);
+			m_Stalls.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// the header is read first, then the payload straight into the message
+		unsigned char* target;
+		size_t wanted;
+		if (connection.headerBytes < sizeof(FrameHeader))
+		{
+			target = reinterpret_cast<unsigned char*>(&connection.header) + connection.headerBytes;
+			wanted = sizeof(FrameHeader) - connection.headerBytes;
+		}
+		else
+		{
+			target = connection.message.command == Command::Create
+				? reinterpret_cast<unsigned char*>(&connection.message.color)
+				: reinterpret_cast<unsigned char*>(connection.message.points.data());
+			target += connection.payloadBytes;
+			wanted = connection.header.bytes - connection.payloadBytes;
+		}
+
+		ssize_t received = ::read(connection.socket, target, std::min(wanted, budget));
+		if (received < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			return true;
+		}
+		if (received <= 0)
+		{
+			// the client closed the connection or it failed, a partially received frame is lost
+			return false;
+		}
+		budget -= received;
+
+		if (connection.headerBytes < sizeof(FrameHeader))
+		{
+			connection.headerBytes += received;
+			if (connection.headerBytes < sizeof(FrameHeader))
+			{
+				continue;
+			}
+			const FrameHeader& header = connection.header;
+			bool valid = false;
+			switch (header.command)
+			{
+			case Command::Create: valid = header.bytes == sizeof(sol::Vec4f); break;
+			case Command::Append:
+			case Command::Replace: valid = header.bytes % sizeof(sol::Vec2f) == 0 && header.bytes <= s_MaxFrameBytes; break;
+			case Command::Delete: valid = header.bytes == 0; break;
+			}
+			if (!valid)
+			{
+				m_Errors.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			connection.message.command = header.command;
+			connection.message.series = header.series;
+			connection.message.points.resize(header.command == Command::Create ? 0 : header.bytes / sizeof(sol::Vec2f));
+		}
+		else
+		{
+			connection.payloadBytes += received;
+		}
+
+		if (connection.headerBytes == sizeof(FrameHeader) && connection.payloadBytes == connection.header.bytes)
+		{
+			connection.complete = true;
+			m_Messages.fetch_add(1, std::memory_order_relaxed);
+			m_Points.fetch_add(connection.message.points.size(), std::memory_order_relaxed);
+			m_Bytes.fetch_add(sizeof(FrameHeader) + connection.header.bytes, std::memory_order_relaxed);
+		}
+	}
+	// the budget is spent, the rest is read on the next wakeup, as epoll is level-triggered.
+	// A message, that was completed by the last read, is handed over now or by the retry of stalled connections
+	if (connection.complete && !this->HandOver(connection))
+	{
+		this->SetReading(connection, false);
+		m_Stalls.fetch_add(1, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+bool SeriesServer::HandOver(Connection& connection)
+{
+	size_t points = connection.message.points.size();
+	// a message larger than the budget is let through, when nothing is queued, so that it never stalls forever
+	size_t queued = m_QueuedPoints.load(std::memory_order_relaxed);
+	if (queued > 0 && queued + points > m_PointBudget)
+	{
+		return false;
+	}
+	m_QueuedPoints.fetch_add(points, std::memory_order_relaxed);
+	if (!m_Queue.TryPush(std::move(connection.message)))
+	{
+		m_QueuedPoints.fetch_sub(points, std::memory_order_relaxed);
+		return false;
+	}
+	connection.message = Message();
+	connection.complete = false;
+	connection.headerBytes = 0;
+	connection.payloadBytes = 0;
+	return true;
+}
+
+void SeriesServer::SetReading(Connection& connection, bool reading)
+{
+	if (connection.reading == reading)
+	{
+		return;
+	}
+	epoll_event event = {};
+	event.events = EPOLLIN;
+	event.data.fd = connection.socket;
+	::epoll_ctl(m_Epoll, reading ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, connection.socket, &event);
+	connection.reading = reading;
+}
+
+void SeriesServer::Close(int socket)
+{
+	::epoll_ctl(m_Epoll, EPOLL_CTL_DEL, socket, nullptr);
+	::close(socket);
+	m_Connections.erase(socket);
+}
+
+SeriesClient::SeriesClient(const std::string& path)
+{
+	sockaddr_un address = SocketAddress(path);
+	m_Socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (m_Socket < 0 || ::connect(m_Socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		std::string message = "Failed to connect to " + path + ": " + std::strerror(errno);
+		if (m_Socket >= 0)
+		{
+			::close(m_Socket);
+		}
+		throw std::runtime_error(message);
+	}
+}
+
+SeriesClient::~SeriesClient()
+{
+	::close(m_Socket);
+}
+
+void SeriesClient::Create(uint32_t series, const sol::Vec4f& color)
+{
+	this->Send(SeriesServer::Command::Create, series, &color, sizeof(color));
+}
+
+void SeriesClient::Append(uint32_t series, const sol::Vec2f* points, size_t count)
+{
+	this->Send(SeriesServer::Command::Append, series, points, count * sizeof(sol::Vec2f));
+}
+
+void SeriesClient::Replace(uint32_t series, const sol::Vec2f* points, size_t count)
+{
+	this->Send(SeriesServer::Command::Replace, series, points, count * sizeof(sol::Vec2f));
+}
+
+void SeriesClient::Delete(uint32_t series)
+{
+	this->Send(SeriesServer::Command::Delete, series, nullptr, 0);
+}
+
+void SeriesClient::Send(SeriesServer::Command command, uint32_t series, const void* payload, size_t bytes)
+{
+	if (bytes > SeriesServer::s_MaxFrameBytes)
+	{
+		throw std::runtime_error("Frame of " + std::to_string(bytes) + " bytes is larger than the protocol allows");
+	}
+	SeriesServer::FrameHeader header = { command, series, static_cast<uint32_t>(bytes), 0 };
+	iovec parts[2] = { { &header, sizeof(header) }, { const_cast<void*>(payload), bytes } };
+	msghdr message = {};
+	message.msg_iov = parts;
+	message.msg_iovlen = bytes > 0 ? 2 : 1;
+	while (message.msg_iovlen > 0)
+	{
+		// MSG_NOSIGNAL turns a closed server into an error instead of SIGPIPE
+		ssize_t sent = ::sendmsg(m_Socket, &message, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (sent < 0)
+		{
+			throw std::runtime_error(std::string("Failed to send a frame: ") + std::strerror(errno));
+		}
+		// skips the parts, that were sent, and the sent beginning of the next one
+		size_t remaining = sent;
+		while (message.msg_iovlen > 0 && remaining >= message.msg_iov[0].iov_len)
+		{
+			remaining -= message.msg_iov[0].iov_len;
+			message.msg_iov++;
+			message.msg_iovlen--;
+		}
+		if (message.msg_iovlen > 0)
+		{
+			message.msg_iov[0].iov_base = static_cast<unsigned char*>(message.msg_iov[0].iov_base) + remaining;
+			message.msg_iov[0].iov_len -= remaining;
+		}
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <Utility/MPSCQueue.h>
+#include <Utility/Matrix.h>
+
+/**
+ * 	SeriesServer receives series updates from local processes over a Unix-domain socket
+ *
+ * 	The protocol is a stream of frames. Each frame is a FrameHeader followed by header.bytes bytes of payload:
+ * 	-	Create: 4 floats of color (rgba). Creates a series with the given id, or recolors an existing one;
+ * 	-	Append: packed points as pairs of floats (x, y). Appends points to the series;
+ * 	-	Replace: packed points as pairs of floats. Replaces all points of the series;
+ * 	-	Delete: no payload. Removes the series.
+ * 	Series ids are chosen by clients and are shared between connections. All values are little-endian.
+ * 	A malformed frame closes the connection, that sent it.
+ *
+ * 	Sockets are served by an I/O thread with epoll. Payload is read straight into the point array of the message,
+ * 	so a batch of points costs one allocation and no per-point decoding. Decoded messages go to the render thread
+ * 	through a bounded lock-free queue and are taken with Poll().
+ *
+ * 	Back-pressure: if the queue is full or holds more than the budget of points, the I/O thread stops reading
+ * 	the connection, that has a message to hand over, until the render thread catches up. The socket buffer fills then,
+ * 	and the client blocks in write(), so a fast client is slowed down to the rate the renderer drains at.
+ *
+ * 	Constructor throws std::runtime_error if the socket can't be created. The socket file is removed by the destructor
+ */
+class SeriesServer
+{
+public:
+	enum class Command : uint32_t
+	{
+		Create = 1,
+		Append = 2,
+		Replace = 3,
+		Delete = 4,
+	};
+
+	struct FrameHeader
+	{
+		Command command;
+		uint32_t series;
+		// size of the payload in bytes
+		uint32_t bytes;
+		uint32_t reserved;
+	};
+
+	struct Message
+	{
+		Command command;
+		uint32_t series;
+		sol::Vec4f color;
+		std::vector<sol::Vec2f> points;
+	};
+
+	struct Stats
+	{
+		size_t connections = 0;
+		size_t messages = 0;
+		size_t points = 0;
+		size_t bytes = 0;
+		// times a connection was paused, as the renderer fell behind
+		size_t stalls = 0;
+		size_t errors = 0;
+	};
+
+	static constexpr size_t s_MaxFrameBytes = 64 * 1024 * 1024;
+public:
+	SeriesServer(const std::string& path, size_t queueCapacity = 4096, size_t pointBudget = 1 << 24);
+	SeriesServer(const SeriesServer&) = delete;
+	SeriesServer& operator=(const SeriesServer&) = delete;
+	// Stops and joins the I/O thread, closes connections and removes the socket file
+	~SeriesServer();
+
+	// Must only be called from a single thread, e.g. the render thread. Returns false if there are no messages
+	bool Poll(Message& message);
+
+	Stats GetStats() const;
+	inline const std::string& Path() const { return m_Path; }
+	// points in messages, that were decoded but not polled yet
+	inline size_t QueuedPoints() const { return m_QueuedPoints.load(std::memory_order_relaxed); }
+private:
+	struct Connection;
+
+	void IOLoop();
+	void Accept();
+	// reads and decodes frames until the socket is drained or the connection stalls. Returns false if the connection is closed
+	bool Receive(Connection& connection);
+	// hands the complete message of the connection over to the render thread. Returns false if the renderer is behind
+	bool HandOver(Connection& connection);
+	// adds the socket to epoll or removes it, so that a stalled connection is neither read nor reported
+	void SetReading(Connection& connection, bool reading);
+	void Close(int socket);
+private:
+	std::string m_Path;
+	int m_Listener = -1;
+	int m_Epoll = -1;
+	// eventfd, that wakes the I/O thread up to stop
+	int m_Wakeup = -1;
+	size_t m_PointBudget;
+
+	MPSCQueue<Message> m_Queue;
+	std::atomic<size_t> m_QueuedPoints = 0;
+	// connections by socket, only touched by the I/O thread
+	std::unordered_map<int, std::unique_ptr<Connection>> m_Connections;
+
+	std::atomic<size_t> m_Accepted = 0;
+	std::atomic<size_t> m_Messages = 0;
+	std::atomic<size_t> m_Points = 0;
+	std::atomic<size_t> m_Bytes = 0;
+	std::atomic<size_t> m_Stalls = 0;
+	std::atomic<size_t> m_Errors = 0;
+
+	std::atomic<bool> m_IsStopped = false;
+	std::thread m_Thread;
+};
+
+/**
+ * 	SeriesClient sends frames of the SeriesServer protocol. Writes block, so a client is slowed down by back-pressure.
+ * 	Methods throw std::runtime_error on I/O errors
+ */
+class SeriesClient
+{
+public:
+	explicit SeriesClient(const std::string& path);
+	SeriesClient(const SeriesClient&) = delete;
+	SeriesClient& operator=(const SeriesClient&) = delete;
+	~SeriesClient();
+
+	void Create(uint32_t series, const sol::Vec4f& color);
+	void Append(uint32_t series, const sol::Vec2f* points, size_t count);
+	void Replace(uint32_t series, const sol::Vec2f* points, size_t count);
+	void Delete(uint32_t series);
+private:
+	// writes the header and the payload with a single sendmsg() call, if the socket takes them at once
+	void Send(SeriesServer::Command command, uint32_t series, const void* payload, size_t bytes);
+private:
+	int m_Socket = -1;
+};
@@ -0,0 +1,151 @@
+#include <Utility/SharedChannel.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free
+	, "Atomics in shared memory must be lock-free, otherwise they aren't shared between processes");
+static_assert(sizeof(SharedChannel::Header) == 192, "SharedChannel header layout must not change");
+static_assert(sizeof(sol::Vec2f) == 2 * sizeof(float), "Points are stored in the ring as pairs of floats");
+
+SharedChannel::SharedChannel(const std::string& name, size_t capacity)
+: m_Name(name), m_IsOwner(true)
+{
+	if (capacity < 2)
+	{
+		throw std::invalid_argument("SharedChannel capacity must be at least 2");
+	}
+	size_t points = 1;
+	while (points < capacity)
+	{
+		points *= 2;
+	}
+
+	// a stale segment of a crashed process is replaced, a process, that still maps it, keeps the old one
+	::shm_unlink(name.c_str());
+	int descriptor = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (descriptor < 0)
+	{
+		throw std::runtime_error("Failed to create shared memory segment " + name + ": " + std::strerror(errno));
+	}
+	size_t bytes = sizeof(Header) + points * sizeof(sol::Vec2f);
+	if (::ftruncate(descriptor, bytes) != 0)
+	{
+		::close(descriptor);
+		::shm_unlink(name.c_str());
+		throw std::runtime_error("Failed to allocate shared memory segment " + name + ": " + std::strerror(errno));
+	}
+	try
+	{
+		this->Map(descriptor, bytes);
+	}
+	catch (const std::runtime_error&)
+	{
+		::shm_unlink(name.c_str());
+		throw;
+	}
+
+	// the segment is zero-filled by ftruncate(), so positions start at 0
+	std::memcpy(m_Header->magic, s_Magic, sizeof(s_Magic));
+	m_Header->capacity = points;
+	m_Mask = points - 1;
+	m_Header->version.store(s_Version, std::memory_order_release);
+}
+
+SharedChannel::SharedChannel(const std::string& name)
+: m_Name(name), m_IsOwner(false)
+{
+	int descriptor = ::shm_open(name.c_str(), O_RDWR, 0);
+	if (descriptor < 0)
+	{
+		throw std::runtime_error("Failed to open shared memory segment " + name + ": " + std::strerror(errno));
+	}
+	struct stat status;
+	if (::fstat(descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Header))
+	{
+		::close(descriptor);
+		throw std::runtime_error("Shared memory segment " + name + " is too small");
+	}
+	this->Map(descriptor, status.st_size);
+
+	const char* error = nullptr;
+	uint64_t capacity = m_Header->capacity;
+	if (m_Header->version.load(std::memory_order_acquire) != s_Version) error = "unsupported version or not initialized yet";
+	else if (std::memcmp(m_Header->magic, s_Magic, sizeof(s_Magic)) != 0) error = "wrong magic";
+	else if (capacity < 2 || (capacity & (capacity - 1)) != 0) error = "capacity is not a power of two";
+	else if (capacity > (m_Bytes - sizeof(Header)) / sizeof(sol::Vec2f)) error = "ring is out of segment";
+	if (error)
+	{
+		::munmap(m_Header, m_Bytes);
+		throw std::runtime_error("Shared memory segment " + name + " is malformed: " + error);
+	}
+	m_Mask = capacity - 1;
+}
+
+SharedChannel::~SharedChannel()
+{
+	::munmap(m_Header, m_Bytes);
+	if (m_IsOwner)
+	{
+		::shm_unlink(m_Name.c_str());
+	}
+}
+
+void SharedChannel::Map(int descriptor, size_t bytes)
+{
+	void* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	// the mapping keeps the segment, the descriptor isn't needed anymore
+	::close(descriptor);
+	if (data == MAP_FAILED)
+	{
+		throw std::runtime_error("Failed to map shared memory segment " + m_Name + ": " + std::strerror(errno));
+	}
+	m_Bytes = bytes;
+	m_Header = static_cast<Header*>(data);
+	m_Points = reinterpret_cast<sol::Vec2f*>(static_cast<unsigned char*>(data) + sizeof(Header));
+}
+
+size_t SharedChannel::Write(const sol::Vec2f* points, size_t count)
+{
+	uint64_t write = m_Header->writePosition.load(std::memory_order_relaxed);
+	uint64_t read = m_Header->readPosition.load(std::memory_order_acquire);
+	size_t used = static_cast<size_t>(write - read);
+	size_t free = used > m_Mask + 1 ? 0 : m_Mask + 1 - used;
+	size_t written = std::min(count, free);
+	if (written < count)
+	{
+		m_Header->droppedPoints.fetch_add(count - written, std::memory_order_relaxed);
+	}
+
+	// the ring is copied in at most two parts, before and after the wrap
+	size_t begin = write & m_Mask;
+	size_t first = std::min(written, m_Mask + 1 - begin);
+	std::memcpy(m_Points + begin, points, first * sizeof(sol::Vec2f));
+	std::memcpy(m_Points, points + first, (written - first) * sizeof(sol::Vec2f));
+	m_Header->writePosition.store(write + written, std::memory_order_release);
+	return written;
+}
+
+size_t SharedChannel::Read(std::vector<sol::Vec2f>& output)
+{
+	uint64_t read = m_Header->readPosition.load(std::memory_order_relaxed);
+	uint64_t write = m_Header->writePosition.load(std::memory_order_acquire);
+	size_t count = static_cast<size_t>(write - read);
+	if (count > m_Mask + 1)
+	{
+		// positions are written by another process, so they are never trusted to stay in the ring
+		count = 0;
+		read = write;
+	}
+
+	size_t begin = read & m_Mask;
+	size_t first = std::min(count, m_Mask + 1 - begin);
+	output.insert(output.end(), m_Points + begin, m_Points + begin + first);
+	output.insert(output.end(), m_Points, m_Points + (count - first));
+	m_Header->readPosition.store(read + count, std::memory_order_release);
+	return count;
+}
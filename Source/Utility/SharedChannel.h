@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <Utility/Matrix.h>
+
+/**
+ * 	SharedChannel is a single-producer single-consumer ring of 2D points in a named POSIX shared memory segment,
+ * 	that passes points from another local process, e.g. an acquisition process, to the plotter without copying through files
+ *
+ * 	The segment consists of a Header and a ring of points. Capacity of the ring is a power of two.
+ * 	Positions in the header are sequence counters, i.e. the total amount of points, that were written and read,
+ * 	they never wrap, so the ring holds write - read points. The producer stores its position with release order
+ * 	after the points are written, the consumer loads it with acquire order, so no locks are shared between processes.
+ * 	The producer never blocks: points, that don't fit into the ring, are dropped and counted in the header.
+ * 	The consumer publishes its position as well, so the producer can measure how long points wait in the ring.
+ *
+ * 	Either side may create the segment, the other side opens it. The creating side unlinks the name on destruction,
+ * 	the segment itself lives until both sides unmap it. Constructors throw std::runtime_error on failure,
+ * 	e.g. if the segment doesn't exist yet or was created by an incompatible version
+ */
+class SharedChannel
+{
+public:
+	struct Header
+	{
+		char magic[8];
+		// version is stored last by the creator, so an opener never sees a half-initialized header
+		std::atomic<uint32_t> version;
+		uint32_t reserved;
+		uint64_t capacity;
+		// producer's and consumer's positions are on different cache lines, as they are written by different processes
+		alignas(64) std::atomic<uint64_t> writePosition;
+		std::atomic<uint64_t> droppedPoints;
+		alignas(64) std::atomic<uint64_t> readPosition;
+	};
+
+	static constexpr char s_Magic[8] = { 'C', 'P', 'C', 'H', 'A', 'N', 'N', 'L' };
+	static constexpr uint32_t s_Version = 1;
+public:
+	// Creates a segment with the given name, e.g. "/cartesian-plotter", that holds at least capacity points.
+	// A stale segment with the same name is replaced
+	SharedChannel(const std::string& name, size_t capacity);
+	// Opens an existing segment
+	explicit SharedChannel(const std::string& name);
+	SharedChannel(const SharedChannel&) = delete;
+	SharedChannel& operator=(const SharedChannel&) = delete;
+	// Unmaps the segment and unlinks the name, if the segment was created by this object
+	~SharedChannel();
+
+	// Producer side. Writes as many points as fit and returns their amount, the rest is dropped
+	size_t Write(const sol::Vec2f* points, size_t count);
+	// Consumer side. Appends all points in the ring to output and returns their amount
+	size_t Read(std::vector<sol::Vec2f>& output);
+
+	inline const std::string& Name() const { return m_Name; }
+	inline size_t Capacity() const { return m_Header->capacity; }
+	inline uint64_t Written() const { return m_Header->writePosition.load(std::memory_order_acquire); }
+	inline uint64_t Consumed() const { return m_Header->readPosition.load(std::memory_order_acquire); }
+	inline uint64_t Dropped() const { return m_Header->droppedPoints.load(std::memory_order_relaxed); }
+	inline bool IsOwner() const { return m_IsOwner; }
+private:
+	void Map(int descriptor, size_t bytes);
+private:
+	std::string m_Name;
+	bool m_IsOwner;
+	size_t m_Bytes = 0;
+	Header* m_Header = nullptr;
+	sol::Vec2f* m_Points = nullptr;
+	size_t m_Mask = 0;
+};
@@ -1,5 +1,8 @@
 #include <Utility/UUID.h>
 
+#include <random>
+#include <sstream>
+
 static std::random_device              rd;
 static std::mt19937                    gen(rd());
 static std::uniform_int_distribution<> distribution(0, 15);
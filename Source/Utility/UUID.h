@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 namespace UUID
 {
     typedef std::string uuid;   // uuid type for convenience only
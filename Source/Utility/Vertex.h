@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ostream>
 #include <Utility/Matrix.h>
 
 /**
@@ -9,14 +10,15 @@
 struct Vertex
 {
 	Vertex() = default;
-	Vertex(float x, float y, sol::Vec4f color);
-	Vertex(float x, float y, float r, float g, float b, float a);
-	Vertex(sol::Vec2f pos, sol::Vec4f color);
+	// constructors are constexpr, so that static meshes are built at compile time
+	constexpr Vertex(float x, float y, sol::Vec4f color) : position(x, y), color(color) {}
+	constexpr Vertex(float x, float y, float r, float g, float b, float a) : position(x, y), color(r, g, b, a) {}
+	constexpr Vertex(sol::Vec2f pos, sol::Vec4f color) : position(pos), color(color) {}
 	~Vertex() = default;
 
 	// overloaded operators for ostream& and matrix multiplication
 	friend std::ostream& operator<<(std::ostream& stream, const Vertex& v);
-	friend Vertex& operator*(const sol::Mat4f& mat, Vertex& vertex);
+	friend Vertex& operator*(const sol::Affine2f& model, Vertex& vertex);
 	// friend Vertex& operator*(const glm::mat4& mat, Vertex& vertex);
 	// friend Vertex operator*(const sol::Mat4f& mat, const Vertex& vertex);
 	
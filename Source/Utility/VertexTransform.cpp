@@ -0,0 +1,114 @@
+#include <Utility/VertexTransform.h>
+#include <Utility/Parallel.h>
+
+#include <cstddef>
+
+namespace VertexTransform
+{
+	// Coefficients of the model matrix, that are kept in registers
+	struct Affine
+	{
+		float a, b, tx;
+		float c, d, ty;
+	};
+
+	static Affine FromModel(const sol::Affine2f& model)
+	{
+		return { model[0].x, model[0].y, model[0].z, model[1].x, model[1].y, model[1].z };
+	}
+
+	// Transforms positions of vertices on a single thread. Output positions are outputStride floats apart,
+	// so the same kernel writes into vertices themselves and into packed positions
+	static void SerialVertices(const Affine& t, const Vertex* vertices, size_t count, float* output, size_t outputStride)
+	{
+		static_assert(offsetof(Vertex, position) == 0 && sizeof(Vertex) % sizeof(float) == 0, "Positions are loaded as pairs of floats");
+		size_t i = 0;
+#ifdef SOL_SSE
+		// Each register holds positions of two vertices as (x0, y0, x1, y1), so x' and y' are computed as
+		// p * (a, d, a, d) + swapped p * (b, c, b, c) + (tx, ty, tx, ty)
+		const __m128 diagonal = _mm_setr_ps(t.a, t.d, t.a, t.d);
+		const __m128 antidiagonal = _mm_setr_ps(t.b, t.c, t.b, t.c);
+		const __m128 translation = _mm_setr_ps(t.tx, t.ty, t.tx, t.ty);
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128 p = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&vertices[i].position))
+				, reinterpret_cast<const __m64*>(&vertices[i + 1].position));
+			__m128 swapped = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1));
+			__m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, diagonal), _mm_mul_ps(swapped, antidiagonal)), translation);
+			_mm_storel_pi(reinterpret_cast<__m64*>(output + i * outputStride), result);
+			_mm_storeh_pi(reinterpret_cast<__m64*>(output + (i + 1) * outputStride), result);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			sol::Vec2f p = vertices[i].position;
+			output[i * outputStride] = t.a * p.x + t.b * p.y + t.tx;
+			output[i * outputStride + 1] = t.c * p.x + t.d * p.y + t.ty;
+		}
+	}
+
+	static void SerialArrays(const Affine& t, const float* x, const float* y, size_t count, float* outputX, float* outputY)
+	{
+		size_t i = 0;
+#if defined(SOL_AVX)
+		const __m256 a = _mm256_set1_ps(t.a), b = _mm256_set1_ps(t.b), tx = _mm256_set1_ps(t.tx);
+		const __m256 c = _mm256_set1_ps(t.c), d = _mm256_set1_ps(t.d), ty = _mm256_set1_ps(t.ty);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 px = _mm256_loadu_ps(x + i);
+			__m256 py = _mm256_loadu_ps(y + i);
+			_mm256_storeu_ps(outputX + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, a), _mm256_mul_ps(py, b)), tx));
+			_mm256_storeu_ps(outputY + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, c), _mm256_mul_ps(py, d)), ty));
+		}
+#elif defined(SOL_SSE)
+		const __m128 a = _mm_set1_ps(t.a), b = _mm_set1_ps(t.b), tx = _mm_set1_ps(t.tx);
+		const __m128 c = _mm_set1_ps(t.c), d = _mm_set1_ps(t.d), ty = _mm_set1_ps(t.ty);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 px = _mm_loadu_ps(x + i);
+			__m128 py = _mm_loadu_ps(y + i);
+			_mm_storeu_ps(outputX + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, a), _mm_mul_ps(py, b)), tx));
+			_mm_storeu_ps(outputY + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, c), _mm_mul_ps(py, d)), ty));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			float px = x[i], py = y[i];
+			outputX[i] = t.a * px + t.b * py + t.tx;
+			outputY[i] = t.c * px + t.d * py + t.ty;
+		}
+	}
+
+	void Apply(const sol::Affine2f& model, Vertex* vertices, size_t count)
+	{
+		const Affine t = FromModel(model);
+		Parallel::For(count, s_ParallelPoints, [&](size_t begin, size_t end)
+		{
+			SerialVertices(t, vertices + begin, end - begin, &vertices[begin].position.x, sizeof(Vertex) / sizeof(float));
+		});
+	}
+
+	void Apply(const sol::Affine2f& model, const Vertex* vertices, size_t count, sol::Vec2f* output)
+	{
+		static_assert(sizeof(sol::Vec2f) == 2 * sizeof(float), "Output positions are packed pairs of floats");
+		const Affine t = FromModel(model);
+		Parallel::For(count, s_ParallelPoints, [&](size_t begin, size_t end)
+		{
+			SerialVertices(t, vertices + begin, end - begin, &output[begin].x, 2);
+		});
+	}
+
+	void Apply(const sol::Affine2f& model, float* x, float* y, size_t count)
+	{
+		Apply(model, x, y, count, x, y);
+	}
+
+	void Apply(const sol::Affine2f& model, const float* x, const float* y, size_t count, float* outputX, float* outputY)
+	{
+		const Affine t = FromModel(model);
+		Parallel::For(count, s_ParallelPoints, [&](size_t begin, size_t end)
+		{
+			SerialArrays(t, x + begin, y + begin, end - begin, outputX + begin, outputY + begin);
+		});
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <Utility/Vertex.h>
+
+/**
+ * 	Namespace, that contains batch kernels, that transform positions of contiguous arrays by an object's model matrix on CPU,
+ * 	e.g. to get world-space positions for picking, exact bounds or export
+ *
+ * 	The result is the same as of operator*(const sol::Affine2f&, Vertex&) for every vertex.
+ * 	Positions are transformed with SSE (AVX for SoA arrays, if the target has it), arrays of more than s_ParallelPoints points
+ * 	are split between threads. Output may be the input itself, i.e. transforms may be done in place; other overlaps aren't allowed
+ */
+namespace VertexTransform
+{
+	// Transforms positions of vertices in place, colors are untouched
+	void Apply(const sol::Affine2f& model, Vertex* vertices, size_t count);
+	// Writes transformed positions of vertices to output, that holds count positions
+	void Apply(const sol::Affine2f& model, const Vertex* vertices, size_t count, sol::Vec2f* output);
+	// Transforms SoA coordinate arrays in place
+	void Apply(const sol::Affine2f& model, float* x, float* y, size_t count);
+	// Writes transformed SoA coordinates to outputX and outputY
+	void Apply(const sol::Affine2f& model, const float* x, const float* y, size_t count, float* outputX, float* outputY);
+
+	static constexpr size_t s_ParallelPoints = 1 << 20;
+}
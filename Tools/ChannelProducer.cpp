@@ -0,0 +1,193 @@
+#include <Utility/SharedChannel.h>
+
+#include <cmath>
+#include <deque>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/*
+	Producer for SharedChannel, that stands in for an acquisition process and measures the channel
+
+	Writes a noisy sine at a fixed rate in batches. Latency of a batch is the time from its write until the consumer's
+	position passes its last point, i.e. until the plotter drained it. The consumer position is polled between batches
+	every 100 us, which is the resolution of the measurement. Throughput is the amount of drained points per second.
+
+	Usage: channel-producer [options]
+		--name /cartesian-plotter	name of the segment
+		--rate 1000000				points per second
+		--batch 1000				points per batch
+		--seconds 5					duration of the run
+		--create					create the segment, so the plotter attaches to it. By default the plotter creates it
+		--capacity 4194304			capacity of the created segment in points
+		--loopback					create the segment and drain it from a child process, no plotter is needed
+		--poll-us 1000				drain interval of the loopback consumer, e.g. 16667 to mimic a 60 Hz frame
+*/
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+	std::string name = "/cartesian-plotter";
+	double rate = 1e6;
+	size_t batch = 1000;
+	double seconds = 5.0;
+	bool create = false;
+	size_t capacity = 1 << 22;
+	bool loopback = false;
+	long pollMicroseconds = 1000;
+};
+
+static Options ParseOptions(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (argument == "--name" && hasValue) options.name = argv[++i];
+		else if (argument == "--rate" && hasValue) options.rate = std::stod(argv[++i]);
+		else if (argument == "--batch" && hasValue) options.batch = std::stoul(argv[++i]);
+		else if (argument == "--seconds" && hasValue) options.seconds = std::stod(argv[++i]);
+		else if (argument == "--capacity" && hasValue) options.capacity = std::stoul(argv[++i]);
+		else if (argument == "--poll-us" && hasValue) options.pollMicroseconds = std::stol(argv[++i]);
+		else if (argument == "--create") options.create = true;
+		else if (argument == "--loopback") options.loopback = true;
+		else
+		{
+			throw std::invalid_argument("Unknown option " + argument);
+		}
+	}
+	options.batch = std::max<size_t>(options.batch, 1);
+	return options;
+}
+
+// Drains the channel until the process is killed, as the plotter would do once per frame
+static void ConsumerLoop(const std::string& name, long pollMicroseconds)
+{
+	SharedChannel channel(name);
+	std::vector<sol::Vec2f> points;
+	for (;;)
+	{
+		points.clear();
+		channel.Read(points);
+		std::this_thread::sleep_for(std::chrono::microseconds(pollMicroseconds));
+	}
+}
+
+static double Percentile(std::vector<double>& values, double fraction)
+{
+	if (values.empty())
+	{
+		return 0.0;
+	}
+	size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Options options = ParseOptions(argc, argv);
+		std::unique_ptr<SharedChannel> channel = options.create || options.loopback
+			? std::make_unique<SharedChannel>(options.name, options.capacity)
+			: std::make_unique<SharedChannel>(options.name);
+
+		pid_t consumer = -1;
+		if (options.loopback)
+		{
+			consumer = ::fork();
+			if (consumer == 0)
+			{
+				ConsumerLoop(options.name, options.pollMicroseconds);
+				return 0;
+			}
+		}
+
+		struct Pending
+		{
+			uint64_t end;
+			Clock::time_point written;
+		};
+		std::deque<Pending> pending;
+		std::vector<double> latencies;
+		std::vector<sol::Vec2f> batch(options.batch);
+		const Clock::duration interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.batch / options.rate));
+		const uint64_t startConsumed = channel->Consumed();
+		const uint64_t startDropped = channel->Dropped();
+		size_t produced = 0;
+
+		auto poll = [&]()
+		{
+			uint64_t consumed = channel->Consumed();
+			Clock::time_point now = Clock::now();
+			while (!pending.empty() && pending.front().end <= consumed)
+			{
+				latencies.push_back(std::chrono::duration<double>(now - pending.front().written).count());
+				pending.pop_front();
+			}
+		};
+
+		Clock::time_point start = Clock::now();
+		Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+		for (Clock::time_point next = start; next < end; next += interval)
+		{
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				double x = (produced + i) / options.rate;
+				batch[i] = sol::Vec2f(static_cast<float>(x), static_cast<float>(std::sin(x) + 0.05 * std::sin(x * 977.0)));
+			}
+			produced += batch.size();
+			size_t written = channel->Write(batch.data(), batch.size());
+			if (written > 0)
+			{
+				pending.push_back({ channel->Written(), Clock::now() });
+			}
+			while (Clock::now() < next + interval)
+			{
+				poll();
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+		}
+		// the consumer gets a second to drain the rest
+		Clock::time_point deadline = Clock::now() + std::chrono::seconds(1);
+		while (!pending.empty() && Clock::now() < deadline)
+		{
+			poll();
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if (consumer > 0)
+		{
+			::kill(consumer, SIGTERM);
+			::waitpid(consumer, nullptr, 0);
+		}
+
+		uint64_t consumed = channel->Consumed() - startConsumed;
+		uint64_t dropped = channel->Dropped() - startDropped;
+		std::cout << "Produced " << produced << " points in batches of " << options.batch << ", dropped " << dropped << "\n"
+			<< "Throughput: " << consumed / elapsed << " points/s drained (" << consumed * sizeof(sol::Vec2f) / elapsed / (1024.0 * 1024.0) << " MB/s)\n"
+			<< "Latency: p50 " << Percentile(latencies, 0.5) * 1e6 << " us, p99 " << Percentile(latencies, 0.99) * 1e6
+			<< " us, max " << Percentile(latencies, 1.0) * 1e6 << " us over " << latencies.size() << " batches\n";
+		if (!pending.empty())
+		{
+			std::cout << pending.size() << " batches were not drained, is the plotter attached to " << options.name << "?\n";
+		}
+	}
+	catch (const std::exception& error)
+	{
+		std::cout << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
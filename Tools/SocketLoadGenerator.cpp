@@ -0,0 +1,148 @@
+#include <Utility/SeriesServer.h>
+
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+/*
+	Load generator for SeriesServer, that measures sustained points per second over the socket protocol
+
+	Creates a few series and appends batches to them round-robin as fast as the socket takes them. Writes block,
+	so once the renderer falls behind, the rate drops to the rate it drains at, which is what is measured.
+	Series are deleted at the end.
+
+	Usage: socket-load-generator [options]
+		--path /tmp/cartesian-plotter.sock	socket of the plotter's series server
+		--series 4							amount of series
+		--batch 4096						points per Append frame
+		--seconds 5							duration of the run
+		--loopback							start a server in this process and drain it on a thread, no plotter is needed
+		--frame-us 16667					drain interval of the loopback consumer, i.e. the frame time it mimics
+		--drain-rate 0						points per second the loopback consumer takes at most, 0 for unlimited.
+											Lower it to see back-pressure slow the client down
+		--budget 16777216					points, the loopback server queues before it stops reading
+*/
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+	std::string path = "/tmp/cartesian-plotter.sock";
+	uint32_t series = 4;
+	size_t batch = 4096;
+	double seconds = 5.0;
+	bool loopback = false;
+	long frameMicroseconds = 16667;
+	double drainRate = 0.0;
+	size_t budget = 1 << 24;
+};
+
+static Options ParseOptions(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (argument == "--path" && hasValue) options.path = argv[++i];
+		else if (argument == "--series" && hasValue) options.series = std::stoul(argv[++i]);
+		else if (argument == "--batch" && hasValue) options.batch = std::stoul(argv[++i]);
+		else if (argument == "--seconds" && hasValue) options.seconds = std::stod(argv[++i]);
+		else if (argument == "--frame-us" && hasValue) options.frameMicroseconds = std::stol(argv[++i]);
+		else if (argument == "--drain-rate" && hasValue) options.drainRate = std::stod(argv[++i]);
+		else if (argument == "--budget" && hasValue) options.budget = std::stoul(argv[++i]);
+		else if (argument == "--loopback") options.loopback = true;
+		else
+		{
+			throw std::invalid_argument("Unknown option " + argument);
+		}
+	}
+	options.series = std::max<uint32_t>(options.series, 1);
+	options.batch = std::max<size_t>(options.batch, 1);
+	return options;
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Options options = ParseOptions(argc, argv);
+
+		// loopback consumer polls the server once per frame, as Renderer::PollSeriesServer() does
+		std::unique_ptr<SeriesServer> server;
+		std::thread consumer;
+		std::atomic<bool> isRunning = true;
+		size_t drained = 0;
+		if (options.loopback)
+		{
+			server = std::make_unique<SeriesServer>(options.path, 4096, options.budget);
+			consumer = std::thread([&]()
+			{
+				SeriesServer::Message message;
+				const double frameSeconds = options.frameMicroseconds * 1e-6;
+				while (isRunning.load(std::memory_order_relaxed))
+				{
+					size_t frame = 0;
+					while ((options.drainRate <= 0.0 || frame < options.drainRate * frameSeconds) && server->Poll(message))
+					{
+						frame += message.points.size();
+					}
+					drained += frame;
+					std::this_thread::sleep_for(std::chrono::microseconds(options.frameMicroseconds));
+				}
+			});
+		}
+
+		SeriesClient client(options.path);
+		std::vector<sol::Vec2f> batch(options.batch);
+		for (uint32_t series = 0; series < options.series; series++)
+		{
+			float hue = static_cast<float>(series) / options.series;
+			client.Create(series, sol::Vec4f(0.5f + 0.5f * hue, 0.9f - 0.5f * hue, 0.4f, 1.0f));
+		}
+
+		size_t sent = 0;
+		size_t frames = 0;
+		Clock::time_point start = Clock::now();
+		Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+		while (Clock::now() < end)
+		{
+			uint32_t series = frames % options.series;
+			size_t first = sent / options.series;
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				float x = static_cast<float>(first + i) * 1e-3f;
+				batch[i] = sol::Vec2f(x, std::sin(x + series) + series * 2.5f);
+			}
+			client.Append(series, batch.data(), batch.size());
+			sent += batch.size();
+			frames++;
+		}
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		for (uint32_t series = 0; series < options.series; series++)
+		{
+			client.Delete(series);
+		}
+
+		std::cout << "Sent " << sent << " points in " << frames << " frames of " << options.batch << " points to " << options.series << " series\n"
+			<< "Sustained: " << sent / elapsed << " points/s (" << sent * sizeof(sol::Vec2f) / elapsed / (1024.0 * 1024.0) << " MB/s)\n";
+		if (server)
+		{
+			isRunning.store(false, std::memory_order_relaxed);
+			consumer.join();
+			SeriesServer::Stats stats = server->GetStats();
+			std::cout << "Server: " << stats.messages << " messages, " << stats.points << " points, " << drained << " drained, "
+				<< stats.stalls << " stalls, " << stats.errors << " errors\n";
+		}
+	}
+	catch (const std::exception& error)
+	{
+		std::cout << error.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}